@@ -19,6 +19,7 @@ import (
 	"github.com/DataDog/datadog-agent/cmd/system-probe/config"
 	"github.com/DataDog/datadog-agent/cmd/system-probe/utils"
 	"github.com/DataDog/datadog-agent/pkg/collector/corechecks/ebpf/probe"
+	ddconfig "github.com/DataDog/datadog-agent/pkg/config"
 	"github.com/DataDog/datadog-agent/pkg/ebpf"
 )
 
@@ -27,7 +28,7 @@ var TCPQueueLength = module.Factory{
 	Name:             config.TCPQueueLengthTracerModule,
 	ConfigNamespaces: []string{},
 	Fn: func(cfg *config.Config) (module.Module, error) {
-		t, err := probe.NewTCPQueueLengthTracer(ebpf.NewConfig())
+		t, err := probe.NewTCPQueueLengthTracer(ebpf.NewConfig(), ddconfig.Datadog.GetInt("system_probe_config.tcp_queue_length_max_stats"))
 		if err != nil {
 			return nil, fmt.Errorf("unable to start the TCP queue length tracer: %w", err)
 		}
@@ -57,7 +58,7 @@ func (t *tcpQueueLengthModule) Register(httpMux *module.Router) error {
 }
 
 func (t *tcpQueueLengthModule) GetStats() map[string]interface{} {
-	return map[string]interface{}{
-		"last_check": t.lastCheck.Load(),
-	}
+	stats := t.TCPQueueLengthTracer.GetStats()
+	stats["last_check"] = t.lastCheck.Load()
+	return stats
 }
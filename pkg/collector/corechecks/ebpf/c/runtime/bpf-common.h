@@ -4,25 +4,33 @@
 #include <linux/bpf.h>
 #include <linux/cgroup.h>
 
-static __always_inline int get_cgroup_name(char *buf, size_t sz) {
-    memset(buf, 0, sz);
-
+static __always_inline struct kernfs_node *get_cgroup_kernfs_node() {
     struct task_struct *cur_tsk = (struct task_struct *)bpf_get_current_task();
 
     struct css_set *css_set;
     if (bpf_probe_read(&css_set, sizeof(css_set), &cur_tsk->cgroups) < 0)
-        return -1;
+        return NULL;
 
     struct cgroup_subsys_state *css;
     if (bpf_probe_read(&css, sizeof(css), &css_set->subsys[0]) < 0)
-        return -1;
+        return NULL;
 
     struct cgroup *cgrp;
     if (bpf_probe_read(&cgrp, sizeof(cgrp), &css->cgroup) < 0)
-        return -1;
+        return NULL;
 
     struct kernfs_node *kn;
     if (bpf_probe_read(&kn, sizeof(kn), &cgrp->kn) < 0)
+        return NULL;
+
+    return kn;
+}
+
+static __always_inline int get_cgroup_name(char *buf, size_t sz) {
+    memset(buf, 0, sz);
+
+    struct kernfs_node *kn = get_cgroup_kernfs_node();
+    if (!kn)
         return -1;
 
     const char *name;
@@ -35,4 +43,17 @@ static __always_inline int get_cgroup_name(char *buf, size_t sz) {
     return 0;
 }
 
+// get_cgroup_id returns the kernfs id of the cgroup of the current task, or 0 on failure.
+// `kn->id` is a `union kernfs_node_id` before 5.5 and a u64 afterwards: in both cases
+// its lower 32 bits are the inode number of the cgroup directory.
+static __always_inline u64 get_cgroup_id() {
+    struct kernfs_node *kn = get_cgroup_kernfs_node();
+    if (!kn)
+        return 0;
+
+    u64 id = 0;
+    bpf_probe_read(&id, sizeof(id), &kn->id);
+    return id;
+}
+
 #endif /* defined(BPF_COMMON_H) */
@@ -21,6 +21,17 @@ struct oom_stats {
     __u64 pages;
     // Tracks if the OOM kill was triggered by a cgroup
     __u32 memcg_oom;
+    // oom_score_adj of killed process
+    __s16 score_adj;
+    // Kernfs id of the cgroup of the triggering process
+    __u64 cgroup_id;
+    // Usage and limit in pages of the memory cgroup that triggered the OOM kill, if any
+    __u64 memcg_usage;
+    __u64 memcg_limit;
+    // Resident pages of killed process, by type
+    __u64 rss_file;
+    __u64 rss_anon;
+    __u64 rss_shmem;
 };
 
 #endif /* defined(OOM_KILL_KERN_USER_H) */
@@ -2,6 +2,11 @@
 #include <linux/types.h>
 #include <linux/version.h>
 #include <linux/oom.h>
+#include <linux/memcontrol.h>
+#include <linux/mm_types.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 11, 0)
+#include <linux/sched/signal.h>
+#endif
 
 #include "bpf_helpers.h"
 #include "bpf-common.h"
@@ -15,50 +20,77 @@
 #endif
 
 /*
- * The `oom_stats` hash map is used to share with the userland program system-probe
- * the statistics per pid
+ * OOM kills are sent to system-probe through the `oom_stats` perf buffer, so that the kills of
+ * an OOM storm aren't overwritten before system-probe reads them. `oom_stats_heap` holds the
+ * event while it is filled, since it is too large for the stack.
  */
 
-BPF_HASH_MAP(oom_stats, u32, struct oom_stats, 10240)
+BPF_PERF_EVENT_ARRAY_MAP(oom_stats, __u32, 0)
+BPF_PERCPU_ARRAY_MAP(oom_stats_heap, __u32, struct oom_stats, 1)
+
+static __always_inline u64 read_mm_counter(struct mm_struct *mm, int member) {
+    long count = 0;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 2, 0)
+    // rss_stat is an array of percpu counters since 6.2, their count is an approximation
+    bpf_probe_read(&count, sizeof(count), &mm->rss_stat[member].count);
+#else
+    bpf_probe_read(&count, sizeof(count), &mm->rss_stat.count[member]);
+#endif
+    return count > 0 ? count : 0;
+}
 
 SEC("kprobe/oom_kill_process")
 int kprobe__oom_kill_process(struct pt_regs *ctx) {
     struct oom_control *oc = (struct oom_control*)PT_REGS_PARM1(ctx);
 
-    struct oom_stats zero = {};
-    u32 pid = bpf_get_current_pid_tgid() >> 32;
-
-    bpf_map_update_elem(&oom_stats, &pid, &zero, BPF_NOEXIST);
-    struct oom_stats *s = bpf_map_lookup_elem(&oom_stats, &pid);
+    u32 key = 0;
+    struct oom_stats *s = bpf_map_lookup_elem(&oom_stats_heap, &key);
     if (!s) {
         return 0;
     }
+    __builtin_memset(s, 0, sizeof(*s));
 
+    u32 pid = bpf_get_current_pid_tgid() >> 32;
     s->pid = pid;
 
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0)
     // From bpf-common.h
     get_cgroup_name(s->cgroup_name, sizeof(s->cgroup_name));
-#endif
+    s->cgroup_id = get_cgroup_id();
 
     struct task_struct *p;
     bpf_probe_read(&p, sizeof(p), &oc->chosen);
     bpf_probe_read(&s->tpid, sizeof(s->tpid), &p->pid);
 
     bpf_get_current_comm(&s->fcomm, sizeof(s->fcomm));
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0)
     bpf_probe_read_str(&s->tcomm, sizeof(s->tcomm), (void *)&p->comm);
-#else
-    bpf_probe_read(&s->tcomm, sizeof(s->tcomm), (void *)&p->comm);
-    s->tcomm[TASK_COMM_LEN - 1] = 0;
-#endif
     bpf_probe_read(&s->pages, sizeof(s->pages), &oc->totalpages);
 
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0)
+    struct signal_struct *signal;
+    bpf_probe_read(&signal, sizeof(signal), &p->signal);
+    bpf_probe_read(&s->score_adj, sizeof(s->score_adj), &signal->oom_score_adj);
+
+    struct mm_struct *mm;
+    bpf_probe_read(&mm, sizeof(mm), &p->mm);
+    if (mm) {
+        s->rss_file = read_mm_counter(mm, MM_FILEPAGES);
+        s->rss_anon = read_mm_counter(mm, MM_ANONPAGES);
+        s->rss_shmem = read_mm_counter(mm, MM_SHMEMPAGES);
+    }
+
     struct mem_cgroup *memcg;
     bpf_probe_read(&memcg, sizeof(memcg), &oc->memcg);
     s->memcg_oom = memcg != NULL ? 1 : 0;
+    if (memcg) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 16, 0)
+        bpf_probe_read(&s->memcg_usage, sizeof(s->memcg_usage), &memcg->memory.usage);
+        bpf_probe_read(&s->memcg_limit, sizeof(s->memcg_limit), &memcg->memory.max);
+#else
+        bpf_probe_read(&s->memcg_usage, sizeof(s->memcg_usage), &memcg->memory.count);
+        bpf_probe_read(&s->memcg_limit, sizeof(s->memcg_limit), &memcg->memory.limit);
 #endif
+    }
+
+    bpf_perf_event_output(ctx, &oom_stats, BPF_F_CURRENT_CPU, s, sizeof(*s));
 
     return 0;
 }
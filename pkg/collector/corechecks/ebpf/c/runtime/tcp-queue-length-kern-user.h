@@ -3,13 +3,30 @@
 
 #include <linux/types.h>
 
+/*
+ * Buffer usages are recorded in permille in log2 buckets:
+ * bucket 0 holds the empty buffers, bucket i holds the usages in [2^(i-1), 2^i[
+ * and the last bucket holds all the usages above 2^(TCP_QUEUE_HIST_BUCKETS-2).
+ */
+#define TCP_QUEUE_HIST_BUCKETS 12
+
 struct stats_key {
-    char cgroup_name[129];
+    __u64 cgroup_id;
+    // local port of the socket, 0 for the sockets bound to an ephemeral port
+    __u16 port;
+    __u16 padding[3];
 };
 
 struct stats_value {
     __u32 read_buffer_max_usage;
     __u32 write_buffer_max_usage;
+    __u32 read_buffer_usage[TCP_QUEUE_HIST_BUCKETS];
+    __u32 write_buffer_usage[TCP_QUEUE_HIST_BUCKETS];
+};
+
+struct tcp_queue_telemetry {
+    // samples dropped because a new key couldn't be inserted into `tcp_queue_stats`
+    __u64 stats_insert_failures;
 };
 
 #endif /* defined(TCP_QUEUE_LENGTH_KERN_USER_H) */
@@ -15,6 +15,8 @@
 #include "bpf-common.h"
 #include "tcp-queue-length-kern-user.h"
 
+#define LOAD_CONSTANT(param, var) asm("%0 = " param " ll" : "=r"(var))
+
 #if LINUX_VERSION_CODE < KERNEL_VERSION(4, 8, 0)
 // 4.8 is the first version where `bpf_get_current_task` is available
 #error Versions of Linux previous to 4.8.0 are not supported by this probe
@@ -22,32 +24,98 @@
 
 /*
  * The `tcp_queue_stats` map is used to share with the userland program system-probe
- * the statistics (max size of receive/send buffer)
+ * the statistics (max and distribution of the usage of the receive/send buffers)
+ * per cgroup and per local port.
+ * Its size is overridden by system-probe from `system_probe_config.tcp_queue_length_max_stats`.
+ */
+BPF_PERCPU_HASH_MAP(tcp_queue_stats, struct stats_key, struct stats_value, 10240)
+
+/*
+ * The `tcp_queue_telemetry` map counts the samples dropped because `tcp_queue_stats` is full.
  */
-BPF_PERCPU_HASH_MAP(tcp_queue_stats, struct stats_key, struct stats_value, 1024)
+BPF_ARRAY_MAP(tcp_queue_telemetry, struct tcp_queue_telemetry, 1)
 
 /*
  * the `who_recvmsg` and `who_sendmsg` maps are used to remind the sock pointer
  * received as input parameter when we are in the kretprobe of tcp_recvmsg and tcp_sendmsg.
+ * They hold one entry per thread blocked in those functions.
+ */
+BPF_HASH_MAP(who_recvmsg, u64, struct sock *, 10240)
+
+BPF_HASH_MAP(who_sendmsg, u64, struct sock *, 10240)
+
+/*
+ * The ephemeral port range is read from net.ipv4.ip_local_port_range by system-probe
+ * and injected when the probes are loaded.
  */
-BPF_HASH_MAP(who_recvmsg, u64, struct sock *, 100)
-    
-BPF_HASH_MAP(who_sendmsg, u64, struct sock *, 100)
-    
+static __always_inline u16 ephemeral_range_begin() {
+    u64 val = 0;
+    LOAD_CONSTANT("ephemeral_range_begin", val);
+    return (u16)val;
+}
+
+static __always_inline u16 ephemeral_range_end() {
+    u64 val = 0;
+    LOAD_CONSTANT("ephemeral_range_end", val);
+    return (u16)val;
+}
+
+static __always_inline u16 get_local_port(struct sock *sk) {
+    u16 port = 0;
+    bpf_probe_read(&port, sizeof(port), (void *)&sk->__sk_common.skc_num);
+
+    // the sockets bound to an ephemeral port are aggregated together
+    if (port >= ephemeral_range_begin() && port <= ephemeral_range_end())
+        return 0;
+
+    return port;
+}
+
+static __always_inline u32 usage_bucket(u32 usage) {
+    if (usage == 0)
+        return 0;
+    if (usage >= 1 << (TCP_QUEUE_HIST_BUCKETS - 2))
+        return TCP_QUEUE_HIST_BUCKETS - 1;
+
+    // unrolled log2, usage is lower than 2^10 at this point
+    u32 log2 = 0;
+    if (usage >> 8) {
+        usage >>= 8;
+        log2 += 8;
+    }
+    if (usage >> 4) {
+        usage >>= 4;
+        log2 += 4;
+    }
+    if (usage >> 2) {
+        usage >>= 2;
+        log2 += 2;
+    }
+    if (usage >> 1)
+        log2 += 1;
+
+    return log2 + 1;
+}
+
 // TODO: replace all `bpf_probe_read` by `bpf_probe_read_kernel` once we can assume that we have at least kernel 5.5
 static __always_inline int check_sock(struct sock *sk) {
-    struct stats_value zero = {
-        .read_buffer_max_usage = 0,
-        .write_buffer_max_usage = 0
+    struct stats_key k = {
+        .cgroup_id = get_cgroup_id(),
+        .port = get_local_port(sk),
     };
 
-    struct stats_key k;
-    get_cgroup_name(k.cgroup_name, sizeof(k.cgroup_name));
-
-    bpf_map_update_elem(&tcp_queue_stats, &k, &zero, BPF_NOEXIST);
     struct stats_value *v = bpf_map_lookup_elem(&tcp_queue_stats, &k);
     if (!v) {
-        return 0;
+        struct stats_value zero = {};
+        bpf_map_update_elem(&tcp_queue_stats, &k, &zero, BPF_NOEXIST);
+        v = bpf_map_lookup_elem(&tcp_queue_stats, &k);
+        if (!v) {
+            u32 zero = 0;
+            struct tcp_queue_telemetry *telemetry = bpf_map_lookup_elem(&tcp_queue_telemetry, &zero);
+            if (telemetry)
+                __sync_fetch_and_add(&telemetry->stats_insert_failures, 1);
+            return 0;
+        }
     }
 
     int rqueue_size, wqueue_size;
@@ -62,8 +130,6 @@ static __always_inline int check_sock(struct sock *sk) {
     bpf_probe_read(&snd_una, sizeof(snd_una), (void *)&tp->snd_una); // First byte we want an ack for
 
     u32 rqueue = rcv_nxt < copied_seq ? 0 : rcv_nxt - copied_seq;
-    if (rqueue < 0)
-        rqueue = 0;
     u32 wqueue = write_seq - snd_una;
 
     u32 rqueue_usage = 1000 * rqueue / rqueue_size;
@@ -74,6 +140,10 @@ static __always_inline int check_sock(struct sock *sk) {
     if (wqueue_usage > v->write_buffer_max_usage)
         v->write_buffer_max_usage = wqueue_usage;
 
+    // the map is per-CPU, no need for atomic operations
+    v->read_buffer_usage[usage_bucket(rqueue_usage)]++;
+    v->write_buffer_usage[usage_bucket(wqueue_usage)]++;
+
     return 0;
 }
 
@@ -14,6 +14,7 @@ package ebpf
 
 import (
 	"fmt"
+	"os"
 	"strings"
 
 	yaml "gopkg.in/yaml.v2"
@@ -156,6 +157,11 @@ func (m *OOMKillCheck) Run() error {
 			fmt.Fprintf(&b, "Process `%s` (pid: %d) triggered an OOM kill on process `%s` (pid: %d).", line.FComm, line.Pid, line.TComm, line.TPid)
 		}
 		fmt.Fprintf(&b, "\n The process had reached %d pages in size. \n\n", line.Pages)
+		fmt.Fprintf(&b, "The killed process had an oom_score_adj of %d and was using %s of file memory, %s of anonymous memory and %s of shared memory. \n\n",
+			line.TOOMScoreAdj, formatPages(line.TRSSFile), formatPages(line.TRSSAnon), formatPages(line.TRSSShmem))
+		if line.MemCgOOM == 1 {
+			fmt.Fprintf(&b, "The cgroup was using %s of its %s limit. \n\n", formatPages(line.MemCgUsage), formatPages(line.MemCgLimit))
+		}
 		b.WriteString(triggerTypeText)
 		b.WriteString("\n %%%")
 
@@ -166,3 +172,18 @@ func (m *OOMKillCheck) Run() error {
 	sender.Commit()
 	return nil
 }
+
+// formatPages formats an amount of memory pages in bytes
+func formatPages(pages uint64) string {
+	const unit = 1024
+	bytes := pages * uint64(os.Getpagesize())
+	if bytes < unit {
+		return fmt.Sprintf("%d B", bytes)
+	}
+	div, exp := uint64(unit), 0
+	for n := bytes / unit; n >= unit && exp < 4; n /= unit {
+		div *= unit
+		exp++
+	}
+	return fmt.Sprintf("%.1f %ciB", float64(bytes)/float64(div), "KMGTP"[exp])
+}
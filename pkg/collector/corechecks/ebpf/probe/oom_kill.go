@@ -14,12 +14,13 @@ package probe
 import (
 	"fmt"
 	"math"
+	"os"
+	"sync"
 	"unsafe"
 
 	"golang.org/x/sys/unix"
 
 	manager "github.com/DataDog/ebpf-manager"
-	bpflib "github.com/cilium/ebpf"
 
 	"github.com/DataDog/datadog-agent/pkg/ebpf"
 	"github.com/DataDog/datadog-agent/pkg/ebpf/bytecode/runtime"
@@ -33,11 +34,23 @@ import (
 */
 import "C"
 
-const oomMapName = "oom_stats"
+const (
+	oomMapName = "oom_stats"
 
+	// maxPendingOOMKills bounds the number of OOM kills kept between two runs of the check
+	maxPendingOOMKills = 10240
+)
+
+// OOMKillProbe receives the OOM kills from the kernel through a perf buffer and keeps them until
+// the check collects them
 type OOMKillProbe struct {
-	m      *manager.Manager
-	oomMap *bpflib.Map
+	m           *manager.Manager
+	perfHandler *ebpf.PerfHandler
+	done        chan struct{}
+
+	mu      sync.Mutex
+	results []OOMKillStats
+	dropped uint64
 }
 
 func NewOOMKillProbe(cfg *ebpf.Config) (*OOMKillProbe, error) {
@@ -54,12 +67,27 @@ func NewOOMKillProbe(cfg *ebpf.Config) (*OOMKillProbe, error) {
 	}
 
 	maps := []*manager.Map{
-		{Name: "oom_stats"},
+		{Name: "oom_stats_heap"},
+	}
+
+	perfHandler := ebpf.NewPerfHandler(100)
+	perfMaps := []*manager.PerfMap{
+		{
+			Map: manager.Map{Name: oomMapName},
+			PerfMapOptions: manager.PerfMapOptions{
+				PerfRingBufferSize: 8 * os.Getpagesize(),
+				Watermark:          1,
+				RecordHandler:      perfHandler.RecordHandler,
+				LostHandler:        perfHandler.LostHandler,
+				RecordGetter:       perfHandler.RecordGetter,
+			},
+		},
 	}
 
 	m := &manager.Manager{
-		Probes: probes,
-		Maps:   maps,
+		Probes:   probes,
+		Maps:     maps,
+		PerfMaps: perfMaps,
 	}
 
 	managerOptions := manager.Options{
@@ -73,53 +101,89 @@ func NewOOMKillProbe(cfg *ebpf.Config) (*OOMKillProbe, error) {
 		return nil, fmt.Errorf("failed to init manager: %w", err)
 	}
 
+	k := &OOMKillProbe{
+		m:           m,
+		perfHandler: perfHandler,
+		done:        make(chan struct{}),
+	}
+	go k.run()
+
 	if err := m.Start(); err != nil {
+		perfHandler.Stop()
+		<-k.done
 		return nil, fmt.Errorf("failed to start manager: %w", err)
 	}
 
-	oomMap, ok, err := m.GetMap(oomMapName)
-	if err != nil {
-		return nil, fmt.Errorf("failed to get map '%s': %w", oomMapName, err)
-	} else if !ok {
-		return nil, fmt.Errorf("failed to get map '%s'", oomMapName)
+	return k, nil
+}
+
+func (k *OOMKillProbe) run() {
+	defer close(k.done)
+	for {
+		select {
+		case event, ok := <-k.perfHandler.DataChannel:
+			if !ok {
+				return
+			}
+			k.handleEvent(event.Data)
+			event.Done()
+		case lost, ok := <-k.perfHandler.LostChannel:
+			if !ok {
+				return
+			}
+			log.Warnf("lost %d OOM kill events", lost)
+		}
+	}
+}
+
+func (k *OOMKillProbe) handleEvent(data []byte) {
+	if len(data) < int(C.sizeof_struct_oom_stats) {
+		log.Warnf("unexpected OOM kill event size: %d", len(data))
+		return
 	}
+	stat := convertStats(*(*C.struct_oom_stats)(unsafe.Pointer(&data[0])))
 
-	return &OOMKillProbe{
-		m:      m,
-		oomMap: oomMap,
-	}, nil
+	k.mu.Lock()
+	defer k.mu.Unlock()
+	if len(k.results) >= maxPendingOOMKills {
+		k.dropped++
+		return
+	}
+	k.results = append(k.results, stat)
 }
 
 func (k *OOMKillProbe) Close() {
 	k.m.Stop(manager.CleanAll)
+	k.perfHandler.Stop()
+	<-k.done
 }
 
 func (k *OOMKillProbe) GetAndFlush() (results []OOMKillStats) {
-	var pid uint32
-	var stat C.struct_oom_stats
-	it := k.oomMap.Iterate()
-	for it.Next(unsafe.Pointer(&pid), unsafe.Pointer(&stat)) {
-		results = append(results, convertStats(stat))
-
-		if err := k.oomMap.Delete(unsafe.Pointer(&pid)); err != nil {
-			log.Warnf("failed to delete stat: %s", err)
-		}
-	}
+	k.mu.Lock()
+	defer k.mu.Unlock()
 
-	if err := it.Err(); err != nil {
-		log.Warnf("failed to iterate on OOM stats while flushing: %s", err)
+	if k.dropped > 0 {
+		log.Warnf("dropped %d OOM kill events since the last check run", k.dropped)
+		k.dropped = 0
 	}
-
+	results, k.results = k.results, nil
 	return results
 }
 
 func convertStats(in C.struct_oom_stats) (out OOMKillStats) {
 	out.CgroupName = C.GoString(&in.cgroup_name[0])
+	out.CgroupID = uint64(in.cgroup_id)
 	out.Pid = uint32(in.pid)
 	out.TPid = uint32(in.tpid)
 	out.FComm = C.GoString(&in.fcomm[0])
 	out.TComm = C.GoString(&in.tcomm[0])
 	out.Pages = uint64(in.pages)
 	out.MemCgOOM = uint32(in.memcg_oom)
+	out.MemCgUsage = uint64(in.memcg_usage)
+	out.MemCgLimit = uint64(in.memcg_limit)
+	out.TRSSFile = uint64(in.rss_file)
+	out.TRSSAnon = uint64(in.rss_anon)
+	out.TRSSShmem = uint64(in.rss_shmem)
+	out.TOOMScoreAdj = int16(in.score_adj)
 	return
 }
@@ -119,6 +119,9 @@ func TestOOMKillProbe(t *testing.T) {
 	for _, result := range results {
 		if result.TPid == uint32(cmd.Process.Pid) {
 			found = true
+			// the python process is killed while holding onto its anonymous memory
+			require.NotZero(t, result.TRSSAnon)
+			require.NotZero(t, result.CgroupID)
 			break
 		}
 	}
@@ -5,13 +5,22 @@
 
 package probe
 
-// OOMKillStats contains the statistics of a given socket
+// OOMKillStats contains the statistics of a given OOM kill. Memory amounts are in pages.
 type OOMKillStats struct {
 	CgroupName string `json:"cgroupName"`
+	CgroupID   uint64 `json:"cgroupId"`
 	Pid        uint32 `json:"pid"`
 	TPid       uint32 `json:"tpid"`
 	FComm      string `json:"fcomm"`
 	TComm      string `json:"tcomm"`
 	Pages      uint64 `json:"pages"`
 	MemCgOOM   uint32 `json:"memcgoom"`
+	// MemCgUsage and MemCgLimit are the usage and limit of the memory cgroup at the time of a cgroup OOM kill
+	MemCgUsage uint64 `json:"memcgUsage"`
+	MemCgLimit uint64 `json:"memcgLimit"`
+	// TRSSFile, TRSSAnon and TRSSShmem are the resident pages of the killed process
+	TRSSFile     uint64 `json:"trssFile"`
+	TRSSAnon     uint64 `json:"trssAnon"`
+	TRSSShmem    uint64 `json:"trssShmem"`
+	TOOMScoreAdj int16  `json:"toomScoreAdj"`
 }
@@ -17,6 +17,7 @@ import (
 	"unsafe"
 
 	"github.com/iovisor/gobpf/pkg/cpupossible"
+	"go.uber.org/atomic"
 	"golang.org/x/sys/unix"
 
 	manager "github.com/DataDog/ebpf-manager"
@@ -24,6 +25,7 @@ import (
 
 	"github.com/DataDog/datadog-agent/pkg/ebpf"
 	"github.com/DataDog/datadog-agent/pkg/ebpf/bytecode/runtime"
+	"github.com/DataDog/datadog-agent/pkg/network/config"
 	"github.com/DataDog/datadog-agent/pkg/process/statsd"
 	"github.com/DataDog/datadog-agent/pkg/util/log"
 )
@@ -35,15 +37,30 @@ import (
 import "C"
 
 const (
-	statsMapName = "tcp_queue_stats"
+	statsMapName     = "tcp_queue_stats"
+	telemetryMapName = "tcp_queue_telemetry"
 )
 
+// the histograms of the eBPF probe and of the check must have the same number of buckets
+var _ = [1]struct{}{}[TCPQueueLengthHistogramBuckets-C.TCP_QUEUE_HIST_BUCKETS]
+
 type TCPQueueLengthTracer struct {
-	m        *manager.Manager
-	statsMap *bpflib.Map
+	m            *manager.Manager
+	statsMap     *bpflib.Map
+	telemetryMap *bpflib.Map
+	cgroups      *cgroupNameResolver
+
+	// statsInsertFailures is the number of samples dropped by the eBPF probes because
+	// `tcp_queue_stats` was full
+	statsInsertFailures *atomic.Uint64
+	// unresolvedCgroups is the number of stats dropped because the name of their cgroup
+	// couldn't be resolved
+	unresolvedCgroups *atomic.Uint64
 }
 
-func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
+// NewTCPQueueLengthTracer creates a tracer tracking at most maxStats (container, local port)
+// pairs between two flushes. The size defined by the eBPF program is kept if maxStats is 0.
+func NewTCPQueueLengthTracer(cfg *ebpf.Config, maxStats int) (*TCPQueueLengthTracer, error) {
 	compiledOutput, err := runtime.TcpQueueLength.Compile(cfg, []string{"-g"}, statsd.Client)
 	if err != nil {
 		return nil, err
@@ -59,6 +76,7 @@ func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
 
 	maps := []*manager.Map{
 		{Name: "tcp_queue_stats"},
+		{Name: "tcp_queue_telemetry"},
 		{Name: "who_recvmsg"},
 		{Name: "who_sendmsg"},
 	}
@@ -68,17 +86,39 @@ func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
 		Maps:   maps,
 	}
 
+	// the client sockets, bound to an ephemeral port, are aggregated together instead of
+	// creating one entry per port
+	ephemeralStart, ephemeralEnd := config.EphemeralPortRange()
+
 	managerOptions := manager.Options{
 		RLimit: &unix.Rlimit{
 			Cur: math.MaxUint64,
 			Max: math.MaxUint64,
 		},
+		ConstantEditors: []manager.ConstantEditor{
+			{Name: "ephemeral_range_begin", Value: uint64(ephemeralStart)},
+			{Name: "ephemeral_range_end", Value: uint64(ephemeralEnd)},
+		},
+	}
+	if maxStats > 0 {
+		managerOptions.MapSpecEditors = map[string]manager.MapSpecEditor{
+			statsMapName: {
+				Type:       bpflib.PerCPUHash,
+				MaxEntries: uint32(maxStats),
+				EditorFlag: manager.EditMaxEntries,
+			},
+		}
 	}
 
 	if err := m.InitWithOptions(compiledOutput, managerOptions); err != nil {
 		return nil, fmt.Errorf("failed to init manager: %w", err)
 	}
 
+	cgroupResolver, err := newCgroupNameResolver(cfg.ProcRoot)
+	if err != nil {
+		return nil, fmt.Errorf("failed to create cgroup resolver: %w", err)
+	}
+
 	if err := m.Start(); err != nil {
 		return nil, fmt.Errorf("failed to start manager: %w", err)
 	}
@@ -90,9 +130,20 @@ func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
 		return nil, fmt.Errorf("failed to get map '%s'", statsMapName)
 	}
 
+	telemetryMap, ok, err := m.GetMap(telemetryMapName)
+	if err != nil {
+		return nil, fmt.Errorf("failed to get map '%s': %w", telemetryMapName, err)
+	} else if !ok {
+		return nil, fmt.Errorf("failed to get map '%s'", telemetryMapName)
+	}
+
 	return &TCPQueueLengthTracer{
-		m:        m,
-		statsMap: statsMap,
+		m:                   m,
+		statsMap:            statsMap,
+		telemetryMap:        telemetryMap,
+		cgroups:             cgroupResolver,
+		statsInsertFailures: atomic.NewUint64(0),
+		unresolvedCgroups:   atomic.NewUint64(0),
 	}, nil
 }
 
@@ -100,6 +151,29 @@ func (t *TCPQueueLengthTracer) Close() {
 	t.m.Stop(manager.CleanAll)
 }
 
+// GetStats returns the telemetry of the tracer
+func (t *TCPQueueLengthTracer) GetStats() map[string]interface{} {
+	return map[string]interface{}{
+		"stats_insert_failures": t.statsInsertFailures.Load(),
+		"unresolved_cgroups":    t.unresolvedCgroups.Load(),
+	}
+}
+
+// updateTelemetry reads the number of samples dropped by the eBPF probes since the last flush
+func (t *TCPQueueLengthTracer) updateTelemetry() {
+	var telemetry C.struct_tcp_queue_telemetry
+	key := uint32(0)
+	if err := t.telemetryMap.Lookup(unsafe.Pointer(&key), unsafe.Pointer(&telemetry)); err != nil {
+		log.Debugf("failed to read map '%s': %s", telemetryMapName, err)
+		return
+	}
+
+	failures := uint64(telemetry.stats_insert_failures)
+	if previous := t.statsInsertFailures.Swap(failures); failures > previous {
+		log.Warnf("%d TCP queue length samples dropped because the map '%s' is full, consider raising system_probe_config.tcp_queue_length_max_stats", failures-previous, statsMapName)
+	}
+}
+
 func (t *TCPQueueLengthTracer) GetAndFlush() TCPQueueLengthStats {
 	cpus, err := cpupossible.Get()
 	if err != nil {
@@ -108,29 +182,31 @@ func (t *TCPQueueLengthTracer) GetAndFlush() TCPQueueLengthStats {
 	}
 	nbCpus := len(cpus)
 
-	result := make(TCPQueueLengthStats)
+	perCgroupID := make(map[uint64]TCPQueueLengthPortStats)
 
 	var statsKey C.struct_stats_key
 	statsValue := make([]C.struct_stats_value, nbCpus)
 	it := t.statsMap.Iterate()
 	for it.Next(unsafe.Pointer(&statsKey), unsafe.Pointer(&statsValue[0])) {
-		cgroupName := C.GoString(&statsKey.cgroup_name[0])
-		// This cannot happen because statsKey.cgroup_name is filled by bpf_probe_read_str which ensures a NULL-terminated string
-		if len(cgroupName) >= C.sizeof_struct_stats_key {
-			log.Critical("statsKey.cgroup_name wasn’t properly NULL-terminated")
-			break
-		}
-
-		max := TCPQueueLengthStatsValue{}
+		var value TCPQueueLengthStatsValue
 		for _, cpu := range cpus {
-			if uint32(statsValue[cpu].read_buffer_max_usage) > max.ReadBufferMaxUsage {
-				max.ReadBufferMaxUsage = uint32(statsValue[cpu].read_buffer_max_usage)
+			if uint32(statsValue[cpu].read_buffer_max_usage) > value.ReadBufferMaxUsage {
+				value.ReadBufferMaxUsage = uint32(statsValue[cpu].read_buffer_max_usage)
+			}
+			if uint32(statsValue[cpu].write_buffer_max_usage) > value.WriteBufferMaxUsage {
+				value.WriteBufferMaxUsage = uint32(statsValue[cpu].write_buffer_max_usage)
 			}
-			if uint32(statsValue[cpu].write_buffer_max_usage) > max.WriteBufferMaxUsage {
-				max.WriteBufferMaxUsage = uint32(statsValue[cpu].write_buffer_max_usage)
+			for i := 0; i < TCPQueueLengthHistogramBuckets; i++ {
+				value.ReadBufferUsage[i] += uint64(statsValue[cpu].read_buffer_usage[i])
+				value.WriteBufferUsage[i] += uint64(statsValue[cpu].write_buffer_usage[i])
 			}
 		}
-		result[cgroupName] = max
+
+		cgroupID := uint64(statsKey.cgroup_id)
+		if perCgroupID[cgroupID] == nil {
+			perCgroupID[cgroupID] = make(TCPQueueLengthPortStats)
+		}
+		perCgroupID[cgroupID][uint16(statsKey.port)] = value
 
 		if err := t.statsMap.Delete(unsafe.Pointer(&statsKey)); err != nil {
 			log.Warnf("failed to delete stat: %s", err)
@@ -141,5 +217,24 @@ func (t *TCPQueueLengthTracer) GetAndFlush() TCPQueueLengthStats {
 		log.Warnf("failed to iterate on TCP queue length stats while flushing: %s", err)
 	}
 
+	t.updateTelemetry()
+
+	cgroupIDs := make([]uint64, 0, len(perCgroupID))
+	for cgroupID := range perCgroupID {
+		cgroupIDs = append(cgroupIDs, cgroupID)
+	}
+	cgroupNames := t.cgroups.Resolve(cgroupIDs)
+
+	result := make(TCPQueueLengthStats, len(perCgroupID))
+	for cgroupID, portStats := range perCgroupID {
+		cgroupName, ok := cgroupNames[cgroupID]
+		if !ok {
+			log.Debugf("failed to resolve the name of cgroup %d", cgroupID)
+			t.unresolvedCgroups.Inc()
+			continue
+		}
+		result[cgroupName] = portStats
+	}
+
 	return result
 }
@@ -0,0 +1,98 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package probe
+
+import (
+	"strings"
+	"sync"
+
+	"golang.org/x/sys/unix"
+
+	"github.com/DataDog/datadog-agent/pkg/util/cgroups"
+	"github.com/DataDog/datadog-agent/pkg/util/log"
+)
+
+// cgroupNameResolver resolves the kernfs ids of cgroups, as reported by the eBPF probes, to cgroup names.
+// The lower 32 bits of a kernfs id are the inode number of the cgroup directory.
+type cgroupNameResolver struct {
+	sync.Mutex
+	reader *cgroups.Reader
+	names  map[uint32]string
+	// seen is used to collect the inodes of the current walk of the cgroup hierarchy
+	seen map[uint32]string
+}
+
+func newCgroupNameResolver(procRoot string) (*cgroupNameResolver, error) {
+	var hostPrefix string
+	if strings.HasPrefix(procRoot, "/host") {
+		hostPrefix = "/host"
+	}
+
+	r := &cgroupNameResolver{
+		names: make(map[uint32]string),
+		seen:  make(map[uint32]string),
+	}
+
+	reader, err := cgroups.NewReader(
+		// the eBPF probes read the cgroup of the first subsystem, which is cpuset
+		cgroups.WithCgroupV1BaseController("cpuset"),
+		cgroups.WithProcPath(procRoot),
+		cgroups.WithHostPrefix(hostPrefix),
+		cgroups.WithReaderFilter(r.filter),
+	)
+	if err != nil {
+		return nil, err
+	}
+	r.reader = reader
+
+	return r, nil
+}
+
+// filter records the inode of every cgroup directory, it never selects any cgroup for the reader
+func (r *cgroupNameResolver) filter(path, name string) (string, error) {
+	var stat unix.Stat_t
+	if err := unix.Stat(path, &stat); err == nil {
+		r.seen[uint32(stat.Ino)] = name
+	}
+	return "", nil
+}
+
+// refresh walks the cgroup hierarchy again, forgetting the cgroups that were removed
+func (r *cgroupNameResolver) refresh() error {
+	r.seen = make(map[uint32]string, len(r.names))
+	if err := r.reader.RefreshCgroups(0); err != nil {
+		return err
+	}
+	r.names = r.seen
+	return nil
+}
+
+// Resolve returns the names of the given cgroup ids. The cgroup hierarchy is walked at most once per call,
+// and only if one of the ids is unknown.
+func (r *cgroupNameResolver) Resolve(ids []uint64) map[uint64]string {
+	r.Lock()
+	defer r.Unlock()
+
+	result := make(map[uint64]string, len(ids))
+	refreshed := false
+	for _, id := range ids {
+		name, ok := r.names[uint32(id)]
+		if !ok && !refreshed {
+			refreshed = true
+			if err := r.refresh(); err != nil {
+				log.Debugf("failed to refresh cgroups: %s", err)
+			}
+			name, ok = r.names[uint32(id)]
+		}
+		if ok {
+			result[id] = name
+		}
+	}
+	return result
+}
@@ -16,7 +16,7 @@ import (
 type TCPQueueLengthTracer struct{}
 
 // NewTCPQueueLengthTracer is not implemented on non-linux systems
-func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
+func NewTCPQueueLengthTracer(cfg *ebpf.Config, maxStats int) (*TCPQueueLengthTracer, error) {
 	return nil, ebpf.ErrNotImplemented
 }
 
@@ -24,11 +24,16 @@ func NewTCPQueueLengthTracer(cfg *ebpf.Config) (*TCPQueueLengthTracer, error) {
 func (t *TCPQueueLengthTracer) Close() {}
 
 // Get is not implemented on non-linux systems
-func (t *TCPQueueLengthTracer) Get() []TCPQueueLengthStats {
+func (t *TCPQueueLengthTracer) Get() TCPQueueLengthStats {
 	return nil
 }
 
+// GetStats is not implemented on non-linux systems
+func (t *TCPQueueLengthTracer) GetStats() map[string]interface{} {
+	return map[string]interface{}{}
+}
+
 // GetAndFlush is not implemented on non-linux systems
-func (t *TCPQueueLengthTracer) GetAndFlush() []TCPQueueLengthStats {
+func (t *TCPQueueLengthTracer) GetAndFlush() TCPQueueLengthStats {
 	return nil
 }
@@ -48,7 +48,7 @@ func TestTCPQueueLengthTracer(t *testing.T) {
 
 	cfg := ebpf.NewConfig()
 
-	tcpTracer, err := NewTCPQueueLengthTracer(cfg)
+	tcpTracer, err := NewTCPQueueLengthTracer(cfg, 0)
 	if err != nil {
 		t.Fatal(err)
 	}
@@ -64,6 +64,10 @@ func TestTCPQueueLengthTracer(t *testing.T) {
 	if afterStats.ReadBufferMaxUsage < 1000 {
 		t.Errorf("max usage of read buffer is too low after the stress test: %d < 1000", afterStats.ReadBufferMaxUsage)
 	}
+	// a usage of 1000 falls in the [512, 1024[ bucket
+	if full := afterStats.ReadBufferUsage[TCPQueueLengthHistogramBuckets-2] + afterStats.ReadBufferUsage[TCPQueueLengthHistogramBuckets-1]; full == 0 {
+		t.Errorf("no full read buffer was recorded in the histogram after the stress test")
+	}
 
 	defer tcpTracer.Close()
 }
@@ -79,12 +83,19 @@ func extractGlobalStats(t *testing.T, tracer *TCPQueueLengthTracer) TCPQueueLeng
 	globalStats := TCPQueueLengthStatsValue{}
 
 	for _, cgroupStats := range stats {
-		if cgroupStats.ReadBufferMaxUsage > globalStats.ReadBufferMaxUsage {
-			globalStats.ReadBufferMaxUsage = cgroupStats.ReadBufferMaxUsage
-		}
+		for _, portStats := range cgroupStats {
+			if portStats.ReadBufferMaxUsage > globalStats.ReadBufferMaxUsage {
+				globalStats.ReadBufferMaxUsage = portStats.ReadBufferMaxUsage
+			}
 
-		if cgroupStats.WriteBufferMaxUsage > globalStats.WriteBufferMaxUsage {
-			globalStats.WriteBufferMaxUsage = cgroupStats.WriteBufferMaxUsage
+			if portStats.WriteBufferMaxUsage > globalStats.WriteBufferMaxUsage {
+				globalStats.WriteBufferMaxUsage = portStats.WriteBufferMaxUsage
+			}
+
+			for i := range portStats.ReadBufferUsage {
+				globalStats.ReadBufferUsage[i] += portStats.ReadBufferUsage[i]
+				globalStats.WriteBufferUsage[i] += portStats.WriteBufferUsage[i]
+			}
 		}
 	}
 
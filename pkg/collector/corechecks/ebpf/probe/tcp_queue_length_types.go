@@ -5,16 +5,45 @@
 
 package probe
 
+import "math"
+
+// TCPQueueLengthHistogramBuckets is the number of buckets of a `TCPQueueLengthHistogram`
+const TCPQueueLengthHistogramBuckets = 12
+
 // TCPQueueLengthStatsKey is the type of the `TCPQueueLengthStats` map key: the container ID
 type TCPQueueLengthStatsKey struct {
 	CgroupName string `json:"cgroupName"`
 }
 
-// TCPQueueLengthStatsValue is the type of the `TCPQueueLengthStats` map value: the maximum fill rate of busiest read and write buffers
+// TCPQueueLengthHistogram is the distribution of the fill rate of buffers, in permille.
+// Bucket 0 counts the empty buffers, bucket i counts the fill rates in [2^(i-1), 2^i[
+// and the last bucket counts all the fill rates above 2^(TCPQueueLengthHistogramBuckets-2).
+type TCPQueueLengthHistogram [TCPQueueLengthHistogramBuckets]uint64
+
+// TCPQueueLengthBucketBounds returns the lower and upper bounds, in permille, of the i-th bucket of a `TCPQueueLengthHistogram`
+func TCPQueueLengthBucketBounds(i int) (float64, float64) {
+	switch {
+	case i == 0:
+		return 0, 1
+	case i == TCPQueueLengthHistogramBuckets-1:
+		return float64(uint64(1) << (i - 1)), math.Inf(1)
+	default:
+		return float64(uint64(1) << (i - 1)), float64(uint64(1) << i)
+	}
+}
+
+// TCPQueueLengthStatsValue is the type of the `TCPQueueLengthStats` map value: the maximum fill rate of busiest read and write buffers,
+// and the distribution of the fill rate of the read and write buffers
 type TCPQueueLengthStatsValue struct {
-	ReadBufferMaxUsage  uint32 `json:"read_buffer_max_usage"`
-	WriteBufferMaxUsage uint32 `json:"write_buffer_max_usage"`
+	ReadBufferMaxUsage  uint32                  `json:"read_buffer_max_usage"`
+	WriteBufferMaxUsage uint32                  `json:"write_buffer_max_usage"`
+	ReadBufferUsage     TCPQueueLengthHistogram `json:"read_buffer_usage"`
+	WriteBufferUsage    TCPQueueLengthHistogram `json:"write_buffer_usage"`
 }
 
-// TCPQueueLengthStats is the map of the maximum fill rate of the read and write buffers per container
-type TCPQueueLengthStats map[string]TCPQueueLengthStatsValue
+// TCPQueueLengthPortStats is the map of the TCP queue length stats per local port.
+// The sockets bound to a port of the ephemeral range are aggregated under port 0.
+type TCPQueueLengthPortStats map[uint16]TCPQueueLengthStatsValue
+
+// TCPQueueLengthStats is the map of the TCP queue length stats per container and per local port
+type TCPQueueLengthStats map[string]TCPQueueLengthPortStats
@@ -13,9 +13,12 @@
 package ebpf
 
 import (
+	"fmt"
+
 	yaml "gopkg.in/yaml.v2"
 
 	sysconfig "github.com/DataDog/datadog-agent/cmd/system-probe/config"
+	"github.com/DataDog/datadog-agent/pkg/aggregator"
 	"github.com/DataDog/datadog-agent/pkg/autodiscovery/integration"
 	"github.com/DataDog/datadog-agent/pkg/collector/check"
 	core "github.com/DataDog/datadog-agent/pkg/collector/corechecks"
@@ -103,7 +106,7 @@ func (t *TCPQueueLengthCheck) Run() error {
 		return log.Errorf("Raw data has incorrect type")
 	}
 
-	for k, v := range stats {
+	for k, portStats := range stats {
 		containerID, err := cgroups.ContainerFilter("", k)
 		if err != nil || containerID == "" {
 			log.Warnf("Unable to extract containerID from cgroup name: %s, err: %v", k, err)
@@ -119,10 +122,28 @@ func (t *TCPQueueLengthCheck) Run() error {
 			}
 		}
 
-		sender.Gauge("tcp_queue.read_buffer_max_usage_pct", float64(v.ReadBufferMaxUsage)/1000.0, "", tags)
-		sender.Gauge("tcp_queue.write_buffer_max_usage_pct", float64(v.WriteBufferMaxUsage)/1000.0, "", tags)
+		for port, v := range portStats {
+			portTags := append(tags[:len(tags):len(tags)], fmt.Sprintf("port:%d", port))
+
+			sender.Gauge("tcp_queue.read_buffer_max_usage_pct", float64(v.ReadBufferMaxUsage)/1000.0, "", portTags)
+			sender.Gauge("tcp_queue.write_buffer_max_usage_pct", float64(v.WriteBufferMaxUsage)/1000.0, "", portTags)
+
+			submitUsageHistogram(sender, "tcp_queue.read_buffer_usage_pct", &v.ReadBufferUsage, portTags)
+			submitUsageHistogram(sender, "tcp_queue.write_buffer_usage_pct", &v.WriteBufferUsage, portTags)
+		}
 	}
 
 	sender.Commit()
 	return nil
 }
+
+// submitUsageHistogram sends the buckets of a usage histogram, the counts are reset by system-probe at each run
+func submitUsageHistogram(sender aggregator.Sender, metric string, histogram *probe.TCPQueueLengthHistogram, tags []string) {
+	for i, count := range histogram {
+		if count == 0 {
+			continue
+		}
+		lowerBound, upperBound := probe.TCPQueueLengthBucketBounds(i)
+		sender.HistogramBucket(metric, int64(count), lowerBound/1000.0, upperBound/1000.0, false, "", tags, true)
+	}
+}
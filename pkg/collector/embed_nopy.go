@@ -8,6 +8,10 @@
 
 package collector
 
+import (
+	"github.com/DataDog/datadog-agent/pkg/autodiscovery/integration"
+)
+
 func pySetup(paths ...string) (pythonVersion, pythonHome, pythonPath string) {
 	return "", "", ""
 }
@@ -15,3 +19,5 @@ func pySetup(paths ...string) (pythonVersion, pythonHome, pythonPath string) {
 func pyPrepareEnv() error {
 	return nil
 }
+
+func pyPreloadChecks(configs []integration.Config) {}
@@ -9,8 +9,11 @@
 package collector
 
 import (
+	"github.com/DataDog/datadog-agent/pkg/autodiscovery/integration"
+	"github.com/DataDog/datadog-agent/pkg/collector/check"
 	"github.com/DataDog/datadog-agent/pkg/collector/python"
 	"github.com/DataDog/datadog-agent/pkg/config"
+	"github.com/DataDog/datadog-agent/pkg/util/containers"
 	"github.com/DataDog/datadog-agent/pkg/util/log"
 )
 
@@ -28,3 +31,16 @@ func pyPrepareEnv() error {
 	}
 	return nil
 }
+
+// pyPreloadChecks starts resolving the python classes of the checks of the
+// configs in the background, without waiting for the imports
+func pyPreloadChecks(configs []integration.Config) {
+	names := make([]string, 0, len(configs))
+	for _, config := range configs {
+		if !config.IsCheckConfig() || config.HasFilter(containers.MetricsFilter) || check.IsJMXConfig(config) {
+			continue
+		}
+		names = append(names, config.Name)
+	}
+	python.PreloadChecksAsync(names)
+}
@@ -9,6 +9,9 @@
 package python
 
 import (
+	"runtime/cgo"
+	"sync/atomic"
+
 	"github.com/DataDog/datadog-agent/pkg/aggregator"
 	chk "github.com/DataDog/datadog-agent/pkg/collector/check"
 	"github.com/DataDog/datadog-agent/pkg/metrics"
@@ -23,12 +26,70 @@ import (
 */
 import "C"
 
+// senderGeneration is bumped each time the sender of a Python check is destroyed, so that the senders
+// cached by the sender handles are looked up again on their next submission
+var senderGeneration uint64
+
+// senderRef is the value behind the sender handle bound to each Python check instance. The sender
+// is looked up by check ID on the first metric submitted by the instance, then reused until a sender
+// is destroyed.
+type senderRef struct {
+	id     chk.ID
+	sender atomic.Value // senderBox
+}
+
+// senderBox wraps the sender so that atomic.Value always stores the same concrete type
+type senderBox struct {
+	aggregator.Sender
+	generation uint64
+}
+
+func (r *senderRef) get() (aggregator.Sender, error) {
+	generation := atomic.LoadUint64(&senderGeneration)
+	if box, ok := r.sender.Load().(senderBox); ok && box.generation == generation {
+		return box.Sender, nil
+	}
+
+	sender, err := aggregator.GetSender(r.id)
+	if err != nil || sender == nil {
+		return nil, err
+	}
+	r.sender.Store(senderBox{Sender: sender, generation: generation})
+	return sender, nil
+}
+
+// destroySender deregisters the sender of a Python check and invalidates the senders cached by the
+// sender handles
+func destroySender(id chk.ID) {
+	aggregator.DestroySender(id)
+	atomic.AddUint64(&senderGeneration, 1)
+}
+
+// GetSenderHandle is called by rtloader once per check instance to bind it a sender handle
+//export GetSenderHandle
+func GetSenderHandle(checkID *C.char) C.sender_handle_t {
+	return C.sender_handle_t(cgo.NewHandle(&senderRef{id: chk.ID(C.GoString(checkID))}))
+}
+
+// ReleaseSenderHandle is called by rtloader when the check instance owning a sender handle is garbage collected
+//export ReleaseSenderHandle
+func ReleaseSenderHandle(handle C.sender_handle_t) {
+	cgo.Handle(handle).Delete()
+}
+
+// getSenderFromHandle returns the sender of a handle, or looks it up by check ID when the submission
+// doesn't come from a check instance created by rtloader
+func getSenderFromHandle(handle C.sender_handle_t, checkID *C.char) (aggregator.Sender, error) {
+	if handle != 0 {
+		return cgo.Handle(handle).Value().(*senderRef).get()
+	}
+	return aggregator.GetSender(chk.ID(C.GoString(checkID)))
+}
+
 // SubmitMetric is the method exposed to Python scripts to submit metrics
 //export SubmitMetric
-func SubmitMetric(checkID *C.char, metricType C.metric_type_t, metricName *C.char, value C.double, tags **C.char, hostname *C.char, flushFirstValue C.bool) {
-	goCheckID := C.GoString(checkID)
-
-	sender, err := aggregator.GetSender(chk.ID(goCheckID))
+func SubmitMetric(senderHandle C.sender_handle_t, checkID *C.char, metricType C.metric_type_t, metricName *C.char, value C.double, tags *C.char, tagsSize C.int, hostname *C.char, flushFirstValue C.bool) {
+	sender, err := getSenderFromHandle(senderHandle, checkID)
 	if err != nil || sender == nil {
 		log.Errorf("Error submitting metric to the Sender: %v", err)
 		return
@@ -37,7 +98,7 @@ func SubmitMetric(checkID *C.char, metricType C.metric_type_t, metricName *C.cha
 	_name := C.GoString(metricName)
 	_value := float64(value)
 	_hostname := C.GoString(hostname)
-	_tags := cStringArrayToSlice(tags)
+	_tags := packedTagsToSlice(tags, tagsSize)
 	_flushFirstValue := bool(flushFirstValue)
 
 	switch metricType {
@@ -115,7 +176,7 @@ func SubmitEvent(checkID *C.char, event *C.event_t) {
 
 // SubmitHistogramBucket is the method exposed to Python scripts to submit metrics
 //export SubmitHistogramBucket
-func SubmitHistogramBucket(checkID *C.char, metricName *C.char, value C.longlong, lowerBound C.float, upperBound C.float, monotonic C.int, hostname *C.char, tags **C.char, flushFirstValue C.bool) {
+func SubmitHistogramBucket(checkID *C.char, metricName *C.char, value C.longlong, lowerBound C.float, upperBound C.float, monotonic C.int, hostname *C.char, tags *C.char, tagsSize C.int, flushFirstValue C.bool) {
 	goCheckID := C.GoString(checkID)
 	sender, err := aggregator.GetSender(chk.ID(goCheckID))
 	if err != nil || sender == nil {
@@ -129,7 +190,7 @@ func SubmitHistogramBucket(checkID *C.char, metricName *C.char, value C.longlong
 	_upperBound := float64(upperBound)
 	_monotonic := (monotonic != 0)
 	_hostname := C.GoString(hostname)
-	_tags := cStringArrayToSlice(tags)
+	_tags := packedTagsToSlice(tags, tagsSize)
 	_flushFirstValue := bool(flushFirstValue)
 
 	sender.HistogramBucket(_name, _value, _lowerBound, _upperBound, _monotonic, _hostname, _tags, _flushFirstValue)
@@ -22,6 +22,10 @@ func TestSubmitMetricEmptyHostname(t *testing.T) {
 	testSubmitMetricEmptyHostname(t)
 }
 
+func TestSubmitMetricSenderHandle(t *testing.T) {
+	testSubmitMetricSenderHandle(t)
+}
+
 func TestSubmitServiceCheck(t *testing.T) {
 	testSubmitServiceCheck(t)
 }
@@ -73,7 +73,16 @@ func NewPythonCheck(name string, class *C.rtloader_pyobject_t) (*PythonCheck, er
 	return pyCheck, nil
 }
 
-func (c *PythonCheck) runCheck(commitMetrics bool) error {
+// runCheck runs the check on a python thread, so that the run reuses the
+// thread state of that thread instead of creating a new one.
+func (c *PythonCheck) runCheck(commitMetrics bool) (err error) {
+	pythonThreads.run(func() {
+		err = c.runCheckOnThread(commitMetrics)
+	})
+	return err
+}
+
+func (c *PythonCheck) runCheckOnThread(commitMetrics bool) error {
 	// Lock the GIL and release it at the end of the run
 	gstate, err := newStickyLock()
 	if err != nil {
@@ -137,7 +146,7 @@ func (c *PythonCheck) Cancel() {
 	if err := getRtLoaderError(); err != nil {
 		log.Warnf("failed to cancel check %s: %s", c.id, err)
 	}
-	aggregator.DestroySender(c.id)
+	destroySender(c.id)
 }
 
 // String representation (for debug and logging)
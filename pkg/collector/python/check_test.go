@@ -16,6 +16,10 @@ func TestRunCheck(t *testing.T) {
 	testRunCheck(t)
 }
 
+func TestRunCheckReusesThreadState(t *testing.T) {
+	testRunCheckReusesThreadState(t)
+}
+
 func TestInitCheckWithRuntimeNotInitialized(t *testing.T) {
 	testInitiCheckWithRuntimeNotInitialized(t)
 }
@@ -9,8 +9,10 @@
 package python
 
 import (
+	"encoding/binary"
 	"fmt"
 	"runtime"
+	"sync"
 	"unsafe"
 
 	"go.uber.org/atomic"
@@ -84,7 +86,9 @@ var (
 
 // newStickyLock registers the current thread with the interpreter and locks
 // the GIL. It also sticks the goroutine to the current thread so that a
-// subsequent call to `Unlock` will unregister the very same thread.
+// subsequent call to `Unlock` will unregister the very same thread. When
+// called from a python thread (see `pythonThreadPool`), the thread state of
+// that thread is reused.
 func newStickyLock() (*stickyLock, error) {
 	runtime.LockOSThread()
 
@@ -136,6 +140,60 @@ func cStringArrayToSlice(array **C.char) []string {
 	return nil
 }
 
+// maxInternedTags caps the number of distinct tags kept by tagsInterner, it's reset once reached
+const maxInternedTags = 16384
+
+// tagInterner deduplicates the tags submitted by the Python checks, which are mostly the same
+// from one submission to the other, so that they're only allocated the first time they're seen.
+type tagInterner struct {
+	sync.Mutex
+	strings map[string]string
+}
+
+var tagsInterner = &tagInterner{strings: make(map[string]string)}
+
+// unpack returns the tags of a buffer packed by rtloader: each tag is its length (32 bits, little
+// endian) followed by its bytes.
+func (i *tagInterner) unpack(packed []byte) []string {
+	tags := make([]string, 0, 8)
+
+	i.Lock()
+	defer i.Unlock()
+	for len(packed) >= 4 {
+		tagLen := binary.LittleEndian.Uint32(packed)
+		packed = packed[4:]
+		if uint64(tagLen) > uint64(len(packed)) {
+			log.Errorf("Malformed tags buffer submitted by rtloader, dropping %d bytes", len(packed))
+			break
+		}
+
+		tag := packed[:tagLen]
+		packed = packed[tagLen:]
+		// the map lookup with string(tag) doesn't allocate
+		if s, found := i.strings[string(tag)]; found {
+			tags = append(tags, s)
+			continue
+		}
+
+		if len(i.strings) >= maxInternedTags {
+			i.strings = make(map[string]string)
+		}
+		s := string(tag)
+		i.strings[s] = s
+		tags = append(tags, s)
+	}
+	return tags
+}
+
+// packedTagsToSlice returns a slice with the tags of a buffer packed by rtloader, converted in a
+// single pass without any cgo call (the function will not free 'packed').
+func packedTagsToSlice(packed *C.char, size C.int) []string {
+	if packed == nil {
+		return nil
+	}
+	return tagsInterner.unpack(unsafe.Slice((*byte)(unsafe.Pointer(packed)), int(size)))
+}
+
 // GetPythonIntegrationList collects python datadog installed integrations list
 func GetPythonIntegrationList() ([]string, error) {
 	glock, err := newStickyLock()
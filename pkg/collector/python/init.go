@@ -112,13 +112,16 @@ void initDatadogAgentModule(rtloader_t *rtloader) {
 // aggregator module
 //
 
-void SubmitMetric(char *, metric_type_t, char *, double, char **, char *, bool);
+sender_handle_t GetSenderHandle(char *);
+void ReleaseSenderHandle(sender_handle_t);
+void SubmitMetric(sender_handle_t, char *, metric_type_t, char *, double, char *, int, char *, bool);
 void SubmitServiceCheck(char *, char *, int, char **, char *, char *);
 void SubmitEvent(char *, event_t *);
-void SubmitHistogramBucket(char *, char *, long long, float, float, int, char *, char **, bool);
+void SubmitHistogramBucket(char *, char *, long long, float, float, int, char *, char *, int, bool);
 void SubmitEventPlatformEvent(char *, char *, char *);
 
 void initAggregatorModule(rtloader_t *rtloader) {
+	set_sender_handle_cbs(rtloader, GetSenderHandle, ReleaseSenderHandle);
 	set_submit_metric_cb(rtloader, SubmitMetric);
 	set_submit_service_check_cb(rtloader, SubmitServiceCheck);
 	set_submit_event_cb(rtloader, SubmitEvent);
@@ -360,6 +363,7 @@ func Initialize(paths ...string) error {
 	// Memory related RTLoader-global initialization
 	if config.Datadog.GetBool("memtrack_enabled") {
 		C.initMemoryTracker()
+		startMemoryTelemetry()
 	}
 
 	// Any platform-specific initialization
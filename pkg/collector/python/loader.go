@@ -14,6 +14,7 @@ import (
 	"fmt"
 	"strings"
 	"sync"
+	"time"
 	"unsafe"
 
 	"github.com/DataDog/datadog-agent/pkg/aggregator"
@@ -40,15 +41,30 @@ import "C"
 var (
 	pyLoaderStats    *expvar.Map
 	configureErrors  map[string][]string
+	importTimes      map[string]float64
 	py3Linted        map[string]struct{}
 	py3Warnings      map[string][]string
 	statsLock        sync.RWMutex
 	py3LintedLock    sync.Mutex
 	linterLock       sync.Mutex
 	agentVersionTags []string
+
+	// errors of the checks that couldn't be preloaded, returned by the next
+	// load of the check instead of trying to import it again
+	preloadErrors     = map[string]error{}
+	preloadErrorsLock sync.Mutex
+
+	// checks queued by PreloadChecksAsync, preloaded by a single goroutine
+	// since imports need the GIL anyway
+	preloadQueue     chan []string
+	preloadQueueOnce sync.Once
 )
 
 const (
+	// preloadQueueSize is the number of batches of checks that can wait for
+	// their preload, the checks of the batches dropped are imported when loaded
+	preloadQueueSize = 16
+
 	wheelNamespace = "datadog_checks"
 	a7TagReady     = "ready"
 	a7TagNotReady  = "not_ready"
@@ -63,11 +79,13 @@ func init() {
 	loaders.RegisterLoader(20, factory)
 
 	configureErrors = map[string][]string{}
+	importTimes = map[string]float64{}
 	py3Linted = map[string]struct{}{}
 	py3Warnings = map[string][]string{}
 	pyLoaderStats = expvar.NewMap("pyLoader")
 	pyLoaderStats.Set("ConfigureErrors", expvar.Func(expvarConfigureErrors))
 	pyLoaderStats.Set("Py3Warnings", expvar.Func(expvarPy3Warnings))
+	pyLoaderStats.Set("ImportTimes", expvar.Func(expvarImportTimes))
 
 	agentVersionTags = []string{}
 	if agentVersion, err := version.Agent(); err == nil {
@@ -109,6 +127,10 @@ func (cl *PythonCheckLoader) Load(config integration.Config, instance integratio
 
 	moduleName := config.Name
 
+	if err := popPreloadError(moduleName); err != nil {
+		return nil, err
+	}
+
 	// Lock the GIL
 	glock, err := newStickyLock()
 	if err != nil {
@@ -220,6 +242,125 @@ func (cl *PythonCheckLoader) String() string {
 	return "Python Check Loader"
 }
 
+// PreloadChecks imports the modules of the given checks and resolves their
+// check class ahead of their loading, which then gets the class from the
+// rtloader cache. The GIL is released between each check, so that the checks
+// already running aren't blocked for the whole preload.
+func PreloadChecks(names []string) {
+	if rtloader == nil {
+		return
+	}
+
+	preloaded := make(map[string]struct{}, len(names))
+	for _, name := range names {
+		if _, found := preloaded[name]; found {
+			continue
+		}
+		preloaded[name] = struct{}{}
+
+		err := preloadCheck(name)
+		preloadErrorsLock.Lock()
+		if err != nil {
+			preloadErrors[name] = err
+		} else {
+			// a previous preload may have failed
+			delete(preloadErrors, name)
+		}
+		preloadErrorsLock.Unlock()
+	}
+}
+
+// PreloadChecksAsync queues the given checks for PreloadChecks in a background
+// goroutine and returns right away, so that the caller doesn't wait for the
+// imports. A check loaded before its preload imports its module itself, the
+// preload then gets its class from the rtloader cache.
+func PreloadChecksAsync(names []string) {
+	if rtloader == nil || len(names) == 0 {
+		return
+	}
+
+	preloadQueueOnce.Do(func() {
+		preloadQueue = make(chan []string, preloadQueueSize)
+		go func() {
+			for names := range preloadQueue {
+				PreloadChecks(names)
+			}
+		}()
+	})
+
+	select {
+	case preloadQueue <- names:
+	default:
+		log.Debugf("python loader: preload queue full, %d checks will be imported when loaded", len(names))
+	}
+}
+
+func preloadCheck(name string) error {
+	glock, err := newStickyLock()
+	if err != nil {
+		return err
+	}
+	defer glock.unlock()
+
+	// Looking for wheels first, like `Load`
+	for _, module := range []string{fmt.Sprintf("%s.%s", wheelNamespace, name), name} {
+		cModule := TrackedCString(module)
+		defer C._free(unsafe.Pointer(cModule))
+
+		modules := [2]*C.char{cModule, nil}
+		var importTime C.longlong
+		if C.preload_checks(rtloader, &modules[0], &importTime) == 1 {
+			setImportTime(name, time.Duration(importTime))
+			log.Debugf("python loader: preloaded check %s from module %s in %s", name, module, time.Duration(importTime))
+			return nil
+		}
+
+		if err = getRtLoaderError(); err != nil {
+			log.Debugf("Unable to preload python module - %s: %v", module, err)
+		} else {
+			err = fmt.Errorf("unable to preload python module %s", module)
+		}
+	}
+
+	return err
+}
+
+// popPreloadError returns the error of the last preload of a check, if it failed,
+// and forgets it so that the check is imported again on the following loads
+func popPreloadError(name string) error {
+	preloadErrorsLock.Lock()
+	defer preloadErrorsLock.Unlock()
+
+	err, found := preloadErrors[name]
+	if found {
+		delete(preloadErrors, name)
+	}
+	return err
+}
+
+func expvarImportTimes() interface{} {
+	statsLock.RLock()
+	defer statsLock.RUnlock()
+
+	importTimesCopy := make(map[string]float64, len(importTimes))
+	for k, v := range importTimes {
+		importTimesCopy[k] = v
+	}
+
+	return importTimesCopy
+}
+
+// setImportTime records the time spent importing the module of a check, in milliseconds. Only
+// the first import is recorded: the module is already cached by python on the following ones.
+func setImportTime(check string, d time.Duration) {
+	statsLock.Lock()
+	defer statsLock.Unlock()
+
+	if importTimes[check] == 0 {
+		importTimes[check] = float64(d) / float64(time.Millisecond)
+	}
+}
+
 func expvarConfigureErrors() interface{} {
 	statsLock.RLock()
 	defer statsLock.RUnlock()
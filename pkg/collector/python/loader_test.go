@@ -19,3 +19,19 @@ func TestLoadWheelCheck(t *testing.T) {
 func TestLoadCustomCheck(t *testing.T) {
 	testLoadCustomCheck(t)
 }
+
+func TestPreloadChecks(t *testing.T) {
+	testPreloadChecks(t)
+}
+
+func TestPreloadChecksAsync(t *testing.T) {
+	testPreloadChecksAsync(t)
+}
+
+func TestPreloadChecksAgain(t *testing.T) {
+	testPreloadChecksAgain(t)
+}
+
+func TestLoadCheckNotPreloaded(t *testing.T) {
+	testLoadCheckNotPreloaded(t)
+}
@@ -13,6 +13,7 @@ import (
 	// "log"
 	"runtime/debug"
 	"sync"
+	"time"
 	"unsafe"
 
 	"github.com/cihub/seelog"
@@ -33,8 +34,13 @@ import (
 	"C"
 )
 
+// memoryTelemetryFlushInterval is the interval at which the memory tracking
+// counters are reported to the telemetry, which is too costly to update on
+// every allocation.
+const memoryTelemetryFlushInterval = 15 * time.Second
+
 var (
-	pointerCache = sync.Map{}
+	trackedPointers = newPointerTable()
 
 	// TODO(remy): if they're not exposed in the status page we may
 	// remove all these expvars
@@ -76,16 +82,13 @@ func MemoryTracker(ptr unsafe.Pointer, sz C.size_t, op C.rtloader_mem_ops_t) {
 	log.Tracef("Memory Tracker - ptr: %v, sz: %v, op: %v", ptr, sz, op)
 	switch op {
 	case C.DATADOG_AGENT_RTLOADER_ALLOCATION:
-		pointerCache.Store(ptr, sz)
+		trackedPointers.store(uintptr(ptr), uint64(sz))
 		allocations.Add(1)
-		tlmAllocations.Inc()
 		allocatedBytes.Add(int64(sz))
-		tlmAllocatedBytes.Add(float64(sz))
 		inuseBytes.Add(int64(sz))
-		tlmInuseBytes.Set(float64(inuseBytes.Value()))
 
 	case C.DATADOG_AGENT_RTLOADER_FREE:
-		bytes, ok := pointerCache.Load(ptr)
+		bytes, ok := trackedPointers.remove(uintptr(ptr))
 		if !ok {
 			log.Debugf("untracked memory was attempted to be freed - set trace level for details")
 			lvl, err := log.GetLogLevel()
@@ -94,18 +97,56 @@ func MemoryTracker(ptr unsafe.Pointer, sz C.size_t, op C.rtloader_mem_ops_t) {
 				log.Tracef("Memory Tracker - stacktrace: \n%s", stack)
 			}
 			untrackedFrees.Add(1)
-			tlmUntrackedFrees.Inc()
 			return
 		}
-		defer pointerCache.Delete(ptr)
 
 		frees.Add(1)
-		tlmFrees.Inc()
-		freedBytes.Add(int64(bytes.(C.size_t)))
-		tlmFreedBytes.Add(float64(bytes.(C.size_t)))
-		inuseBytes.Add(-1 * int64(bytes.(C.size_t)))
-		tlmInuseBytes.Set(float64(inuseBytes.Value()))
+		freedBytes.Add(int64(bytes))
+		inuseBytes.Add(-1 * int64(bytes))
+	}
+}
+
+// memoryTelemetry reports the memory tracking counters to the telemetry
+type memoryTelemetry struct {
+	sync.Mutex
+	// values of the counters at the previous flush
+	allocations    int64
+	allocatedBytes int64
+	frees          int64
+	freedBytes     int64
+	untrackedFrees int64
+}
+
+var rtLoaderMemoryTelemetry memoryTelemetry
+
+// flush adds the increments of the counters since the previous flush to the telemetry
+func (m *memoryTelemetry) flush() {
+	m.Lock()
+	defer m.Unlock()
+
+	addDelta := func(counter telemetry.Counter, previous *int64, value int64) {
+		if value != *previous {
+			counter.Add(float64(value - *previous))
+			*previous = value
+		}
 	}
+	addDelta(tlmAllocations, &m.allocations, allocations.Value())
+	addDelta(tlmAllocatedBytes, &m.allocatedBytes, allocatedBytes.Value())
+	addDelta(tlmFrees, &m.frees, frees.Value())
+	addDelta(tlmFreedBytes, &m.freedBytes, freedBytes.Value())
+	addDelta(tlmUntrackedFrees, &m.untrackedFrees, untrackedFrees.Value())
+	tlmInuseBytes.Set(float64(inuseBytes.Value()))
+}
+
+// startMemoryTelemetry flushes the memory tracking counters to the telemetry periodically
+func startMemoryTelemetry() {
+	go func() {
+		ticker := time.NewTicker(memoryTelemetryFlushInterval)
+		defer ticker.Stop()
+		for range ticker.C {
+			rtLoaderMemoryTelemetry.flush()
+		}
+	}()
 }
 
 func TrackedCString(str string) *C.char {
@@ -0,0 +1,159 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build python
+// +build python
+
+package python
+
+import (
+	"sync"
+)
+
+const (
+	// pointerTableShardBits is the log2 of the number of shards of a pointer table
+	pointerTableShardBits = 6
+	// pointerTableShardSize is the number of slots a shard is allocated with on its first store, a power of 2
+	pointerTableShardSize = 1024
+)
+
+// pointerTable maps the addresses of the memory allocated by rtloader to their
+// size. It is split into shards locked independently, each one being an
+// open-addressing hash table with linear probing, so that storing or removing a
+// pointer neither allocates nor contends with the other threads most of the time.
+// The shards are allocated on their first store, so that the table costs nothing
+// when memory tracking is disabled.
+type pointerTable struct {
+	shards [1 << pointerTableShardBits]pointerTableShard
+}
+
+type pointerTableShard struct {
+	sync.Mutex
+	// 0 marks an empty slot, since rtloader never tracks NULL pointers. Both
+	// slices are nil until the first store in the shard.
+	ptrs  []uintptr
+	sizes []uint64
+	count int
+}
+
+func newPointerTable() *pointerTable {
+	return &pointerTable{}
+}
+
+// hashPointer spreads the pointers over the whole hash, the lower bits of the
+// addresses being always the same due to the alignment of the allocations
+func hashPointer(ptr uintptr) uint64 {
+	h := uint64(ptr) * 0x9e3779b97f4a7c15
+	return h ^ (h >> 32)
+}
+
+func (t *pointerTable) shard(h uint64) *pointerTableShard {
+	return &t.shards[h>>(64-pointerTableShardBits)]
+}
+
+// store records the size of the memory allocated at ptr
+func (t *pointerTable) store(ptr uintptr, size uint64) {
+	if ptr == 0 {
+		return
+	}
+	h := hashPointer(ptr)
+	s := t.shard(h)
+
+	s.Lock()
+	if s.ptrs == nil {
+		s.ptrs = make([]uintptr, pointerTableShardSize)
+		s.sizes = make([]uint64, pointerTableShardSize)
+	}
+	// keep the load factor under 1/2 so that the probe sequences stay short
+	if 2*(s.count+1) > len(s.ptrs) {
+		s.grow()
+	}
+	s.insert(h, ptr, size)
+	s.Unlock()
+}
+
+// remove deletes ptr from the table and returns the size of the memory
+// allocated there, or false if ptr wasn't tracked
+func (t *pointerTable) remove(ptr uintptr) (uint64, bool) {
+	if ptr == 0 {
+		return 0, false
+	}
+	h := hashPointer(ptr)
+	s := t.shard(h)
+
+	s.Lock()
+	defer s.Unlock()
+
+	if s.ptrs == nil {
+		return 0, false
+	}
+
+	mask := uint64(len(s.ptrs) - 1)
+	i := h & mask
+	for s.ptrs[i] != ptr {
+		if s.ptrs[i] == 0 {
+			return 0, false
+		}
+		i = (i + 1) & mask
+	}
+	size := s.sizes[i]
+
+	// shift back the following entries of the cluster that can't be reached
+	// anymore from their home slot, instead of leaving a tombstone
+	j := i
+	for {
+		j = (j + 1) & mask
+		if s.ptrs[j] == 0 {
+			break
+		}
+		home := hashPointer(s.ptrs[j]) & mask
+		if (j-home)&mask >= (j-i)&mask {
+			s.ptrs[i], s.sizes[i] = s.ptrs[j], s.sizes[j]
+			i = j
+		}
+	}
+	s.ptrs[i], s.sizes[i] = 0, 0
+	s.count--
+
+	return size, true
+}
+
+// len returns the number of tracked pointers
+func (t *pointerTable) len() int {
+	n := 0
+	for i := range t.shards {
+		s := &t.shards[i]
+		s.Lock()
+		n += s.count
+		s.Unlock()
+	}
+	return n
+}
+
+func (s *pointerTableShard) insert(h uint64, ptr uintptr, size uint64) {
+	mask := uint64(len(s.ptrs) - 1)
+	i := h & mask
+	for s.ptrs[i] != 0 {
+		if s.ptrs[i] == ptr {
+			s.sizes[i] = size
+			return
+		}
+		i = (i + 1) & mask
+	}
+	s.ptrs[i], s.sizes[i] = ptr, size
+	s.count++
+}
+
+func (s *pointerTableShard) grow() {
+	ptrs, sizes := s.ptrs, s.sizes
+	s.ptrs = make([]uintptr, 2*len(ptrs))
+	s.sizes = make([]uint64, 2*len(sizes))
+	s.count = 0
+	for i, ptr := range ptrs {
+		if ptr != 0 {
+			s.insert(hashPointer(ptr), ptr, sizes[i])
+		}
+	}
+}
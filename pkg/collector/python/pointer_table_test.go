@@ -0,0 +1,114 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build python && test
+// +build python,test
+
+package python
+
+import (
+	"math/rand"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func TestPointerTable(t *testing.T) {
+	table := newPointerTable()
+
+	table.store(0x1000, 16)
+	table.store(0x1010, 32)
+	assert.Equal(t, 2, table.len())
+
+	// storing a tracked pointer again updates its size
+	table.store(0x1010, 64)
+	assert.Equal(t, 2, table.len())
+
+	size, ok := table.remove(0x1010)
+	assert.True(t, ok)
+	assert.Equal(t, uint64(64), size)
+
+	_, ok = table.remove(0x1010)
+	assert.False(t, ok)
+	_, ok = table.remove(0)
+	assert.False(t, ok)
+
+	size, ok = table.remove(0x1000)
+	assert.True(t, ok)
+	assert.Equal(t, uint64(16), size)
+	assert.Equal(t, 0, table.len())
+}
+
+func TestPointerTableLazyShards(t *testing.T) {
+	table := newPointerTable()
+
+	_, ok := table.remove(0x1000)
+	assert.False(t, ok)
+	assert.Equal(t, 0, table.len())
+
+	allocated := func() int {
+		n := 0
+		for i := range table.shards {
+			if table.shards[i].ptrs != nil {
+				n++
+			}
+		}
+		return n
+	}
+	assert.Equal(t, 0, allocated())
+
+	// only the shard of the stored pointer is allocated
+	table.store(0x1000, 16)
+	assert.Equal(t, 1, allocated())
+
+	size, ok := table.remove(0x1000)
+	assert.True(t, ok)
+	assert.Equal(t, uint64(16), size)
+}
+
+func TestPointerTableMatchesMap(t *testing.T) {
+	table := newPointerTable()
+	expected := make(map[uintptr]uint64)
+	rng := rand.New(rand.NewSource(42))
+
+	// enough pointers to grow the shards, with frequent removals to exercise
+	// the backward shifts in the probe sequences
+	for i := 0; i < 200000; i++ {
+		ptr := uintptr(rng.Intn(1<<17)+1) << 4
+		if rng.Intn(3) == 0 {
+			size, ok := table.remove(ptr)
+			expectedSize, expectedOk := expected[ptr]
+			require.Equal(t, expectedOk, ok)
+			require.Equal(t, expectedSize, size)
+			delete(expected, ptr)
+			continue
+		}
+		size := uint64(rng.Intn(4096))
+		table.store(ptr, size)
+		expected[ptr] = size
+	}
+
+	require.Equal(t, len(expected), table.len())
+	for ptr, expectedSize := range expected {
+		size, ok := table.remove(ptr)
+		require.True(t, ok)
+		require.Equal(t, expectedSize, size)
+	}
+	assert.Equal(t, 0, table.len())
+}
+
+func BenchmarkPointerTable(b *testing.B) {
+	table := newPointerTable()
+	b.ReportAllocs()
+	b.RunParallel(func(pb *testing.PB) {
+		ptr := uintptr(rand.Int63()) &^ 0xf
+		for pb.Next() {
+			table.store(ptr, 64)
+			table.remove(ptr)
+			ptr += 16
+		}
+	})
+}
@@ -9,6 +9,7 @@
 package python
 
 import (
+	"encoding/binary"
 	"testing"
 
 	"github.com/DataDog/datadog-agent/pkg/aggregator/mocksender"
@@ -19,65 +20,85 @@ import (
 // #include <datadog_agent_rtloader.h>
 import "C"
 
+// packTags packs tags the way rtloader does for metric submissions
+func packTags(tags ...string) (*C.char, C.int) {
+	var packed []byte
+	var tagLen [4]byte
+	for _, tag := range tags {
+		binary.LittleEndian.PutUint32(tagLen[:], uint32(len(tag)))
+		packed = append(packed, tagLen[:]...)
+		packed = append(packed, tag...)
+	}
+	return (*C.char)(C.CBytes(packed)), C.int(len(packed))
+}
+
 func testSubmitMetric(t *testing.T) {
 	sender := mocksender.NewMockSender(check.ID("testID"))
 	sender.SetupAcceptAll()
 
-	cTags := []*C.char{C.CString("tag1"), C.CString("tag2"), nil}
-	SubmitMetric(C.CString("testID"),
+	cTags, cTagsSize := packTags("tag1", "tag2")
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_GAUGE,
 		C.CString("test_gauge"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_RATE,
 		C.CString("test_rate"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_COUNT,
 		C.CString("test_count"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_MONOTONIC_COUNT,
 		C.CString("test_monotonic_count"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_MONOTONIC_COUNT,
 		C.CString("test_monotonic_count_flush_first_value"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(true))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_COUNTER,
 		C.CString("test_counter"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_HISTOGRAM,
 		C.CString("test_histogram"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
-	SubmitMetric(C.CString("testID"),
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_HISTORATE,
 		C.CString("test_historate"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
 
@@ -95,12 +116,13 @@ func testSubmitMetricEmptyTags(t *testing.T) {
 	sender := mocksender.NewMockSender(check.ID("testID"))
 	sender.SetupAcceptAll()
 
-	cTags := []*C.char{nil}
-	SubmitMetric(C.CString("testID"),
+	cTags, cTagsSize := packTags()
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_GAUGE,
 		C.CString("test_gauge"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		C.CString("my_hostname"),
 		C.bool(false))
 
@@ -111,18 +133,66 @@ func testSubmitMetricEmptyHostname(t *testing.T) {
 	sender := mocksender.NewMockSender(check.ID("testID"))
 	sender.SetupAcceptAll()
 
-	cTags := []*C.char{nil}
-	SubmitMetric(C.CString("testID"),
+	cTags, cTagsSize := packTags()
+	SubmitMetric(0, C.CString("testID"),
 		C.DATADOG_AGENT_RTLOADER_GAUGE,
 		C.CString("test_gauge"),
 		C.double(21),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		nil,
 		C.bool(false))
 
 	sender.AssertMetric(t, "Gauge", "test_gauge", 21, "", nil)
 }
 
+func testSubmitMetricSenderHandle(t *testing.T) {
+	sender := mocksender.NewMockSender(check.ID("testID"))
+	sender.SetupAcceptAll()
+
+	handle := GetSenderHandle(C.CString("testID"))
+	defer ReleaseSenderHandle(handle)
+
+	// the check ID isn't needed once the handle is bound
+	cTags, cTagsSize := packTags()
+	SubmitMetric(handle, nil,
+		C.DATADOG_AGENT_RTLOADER_GAUGE,
+		C.CString("test_gauge"),
+		C.double(21),
+		cTags,
+		cTagsSize,
+		C.CString("my_hostname"),
+		C.bool(false))
+	SubmitMetric(handle, nil,
+		C.DATADOG_AGENT_RTLOADER_COUNT,
+		C.CString("test_count"),
+		C.double(21),
+		cTags,
+		cTagsSize,
+		C.CString("my_hostname"),
+		C.bool(false))
+
+	sender.AssertMetric(t, "Gauge", "test_gauge", 21, "my_hostname", nil)
+	sender.AssertMetric(t, "Count", "test_count", 21, "my_hostname", nil)
+
+	// the handle must not keep submitting to a destroyed sender
+	destroySender(check.ID("testID"))
+	newSender := mocksender.NewMockSender(check.ID("testID"))
+	newSender.SetupAcceptAll()
+
+	SubmitMetric(handle, nil,
+		C.DATADOG_AGENT_RTLOADER_GAUGE,
+		C.CString("test_gauge"),
+		C.double(42),
+		cTags,
+		cTagsSize,
+		C.CString("my_hostname"),
+		C.bool(false))
+
+	newSender.AssertMetric(t, "Gauge", "test_gauge", 42, "my_hostname", nil)
+	sender.Mock.AssertNotCalled(t, "Gauge", "test_gauge", 42.0, "my_hostname", mocksender.MatchTagsContains(nil))
+}
+
 func testSubmitServiceCheck(t *testing.T) {
 	sender := mocksender.NewMockSender(check.ID("testID"))
 	sender.SetupAcceptAll()
@@ -205,7 +275,7 @@ func testSubmitHistogramBucket(t *testing.T) {
 	sender := mocksender.NewMockSender(check.ID("testID"))
 	sender.SetupAcceptAll()
 
-	cTags := []*C.char{C.CString("tag1"), C.CString("tag2"), nil}
+	cTags, cTagsSize := packTags("tag1", "tag2")
 	SubmitHistogramBucket(
 		C.CString("testID"),
 		C.CString("test_histogram"),
@@ -214,7 +284,8 @@ func testSubmitHistogramBucket(t *testing.T) {
 		C.float(2.0),
 		C.int(1),
 		C.CString("my_hostname"),
-		&cTags[0],
+		cTags,
+		cTagsSize,
 		true,
 	)
 
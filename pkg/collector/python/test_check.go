@@ -38,6 +38,18 @@ void release_gil(rtloader_t *s, rtloader_gilstate_t state) {
 	gil_unlocked_calls++;
 }
 
+int acquire_thread_state_calls = 0;
+static char thread_state;
+rtloader_threadstate_t *acquire_thread_state(rtloader_t *s) {
+	acquire_thread_state_calls++;
+	return (rtloader_threadstate_t *)&thread_state;
+}
+
+int release_thread_state_calls = 0;
+void release_thread_state(rtloader_t *s, rtloader_threadstate_t *state) {
+	release_thread_state_calls++;
+}
+
 int rtloader_incref_calls = 0;
 void rtloader_incref(rtloader_t *s, rtloader_pyobject_t *p) {
 	rtloader_incref_calls++;
@@ -152,6 +164,8 @@ rtloader_pyobject_t **check) {
 void reset_check_mock() {
 	gil_locked_calls = 0;
 	gil_unlocked_calls = 0;
+	acquire_thread_state_calls = 0;
+	release_thread_state_calls = 0;
 	rtloader_incref_calls = 0;
 	rtloader_decref_calls = 0;
 	get_checks_warnings_return = NULL;
@@ -217,6 +231,38 @@ func testRunCheck(t *testing.T) {
 	assert.Equal(t, check.lastWarnings, []error{fmt.Errorf("warn1"), fmt.Errorf("warn2")})
 }
 
+func testRunCheckReusesThreadState(t *testing.T) {
+	rtloader = newMockRtLoaderPtr()
+	defer func() { rtloader = nil }()
+
+	threads := pythonThreads
+	pythonThreads = newPythonThreadPool(1)
+	defer func() { pythonThreads = threads }()
+
+	check, err := NewPythonFakeCheck()
+	if !assert.Nil(t, err) {
+		return
+	}
+
+	check.instance = newMockPyObjectPtr()
+
+	C.reset_check_mock()
+	C.run_check_return = C.CString("")
+
+	for i := 0; i < 3; i++ {
+		err = check.runCheck(false)
+		assert.Nil(t, err)
+	}
+
+	assert.Equal(t, C.int(3), C.gil_locked_calls)
+	assert.Equal(t, C.int(3), C.gil_unlocked_calls)
+	assert.Equal(t, C.int(3), C.run_check_calls)
+
+	// the idle thread keeps its thread state between the runs
+	assert.Equal(t, C.int(1), C.acquire_thread_state_calls)
+	assert.Equal(t, C.int(0), C.release_thread_state_calls)
+}
+
 func testRunCheckWithRuntimeNotInitializedError(t *testing.T) {
 	rtloader = newMockRtLoaderPtr()
 	defer func() { rtloader = nil }()
@@ -11,6 +11,7 @@ package python
 import (
 	"runtime"
 	"testing"
+	"time"
 
 	"github.com/DataDog/datadog-agent/pkg/autodiscovery/integration"
 
@@ -62,6 +63,22 @@ int get_attr_string(rtloader_t *rtloader, rtloader_pyobject_t *py_class, const c
 	return get_attr_string_return;
 }
 
+int preload_checks_calls = 0;
+int preload_checks_return = 0;
+int preload_checks_dd_wheel_return = 0;
+long long preload_checks_import_time = 1000000;
+
+int preload_checks(rtloader_t *rtloader, char **modules, long long *import_times) {
+	int loaded = 0;
+	for (int i = 0; modules[i]; i++) {
+		preload_checks_calls++;
+		int ok = strncmp(modules[i], "datadog_checks.", 15) == 0 ? preload_checks_dd_wheel_return : preload_checks_return;
+		import_times[i] = ok ? preload_checks_import_time : -1;
+		loaded += ok;
+	}
+	return loaded;
+}
+
 void reset_loader_mock() {
 	get_class_calls = 0;
 	get_class_return = 0;
@@ -73,6 +90,11 @@ void reset_loader_mock() {
 	get_class_dd_wheel_py_module = NULL;
 	get_class_dd_wheel_py_class = NULL;
 
+	preload_checks_calls = 0;
+	preload_checks_return = 0;
+	preload_checks_dd_wheel_return = 0;
+	preload_checks_import_time = 1000000;
+
 	get_attr_string_return = 0;
 	get_attr_string_py_class = NULL;
 	get_attr_string_attr_name = NULL;
@@ -147,3 +169,85 @@ func testLoadWheelCheck(t *testing.T) {
 	// test we call get_attr_string on the module
 	assert.Equal(t, C.get_attr_string_py_class, C.get_class_dd_wheel_py_module)
 }
+
+func testPreloadChecks(t *testing.T) {
+	C.reset_loader_mock()
+
+	rtloader = newMockRtLoaderPtr()
+	defer func() { rtloader = nil }()
+
+	C.preload_checks_dd_wheel_return = 1
+	PreloadChecks([]string{"fake_check", "fake_check"})
+
+	// the wheel is found first, and each check is only preloaded once
+	assert.Equal(t, C.int(1), C.preload_checks_calls)
+	assert.Equal(t, 1.0, expvarImportTimes().(map[string]float64)["fake_check"])
+	assert.Nil(t, popPreloadError("fake_check"))
+}
+
+func testPreloadChecksAgain(t *testing.T) {
+	C.reset_loader_mock()
+
+	rtloader = newMockRtLoaderPtr()
+	defer func() { rtloader = nil }()
+
+	PreloadChecks([]string{"retried_check"})
+	assert.NotNil(t, popPreloadError("retried_check"))
+
+	PreloadChecks([]string{"retried_check"})
+	C.preload_checks_return = 1
+	PreloadChecks([]string{"retried_check"})
+	// the error of the failed preload is forgotten once the check is preloaded
+	assert.Nil(t, popPreloadError("retried_check"))
+	assert.Equal(t, 1.0, expvarImportTimes().(map[string]float64)["retried_check"])
+
+	// the module is cached by python on the following preloads
+	C.preload_checks_import_time = 1000
+	PreloadChecks([]string{"retried_check"})
+	assert.Equal(t, 1.0, expvarImportTimes().(map[string]float64)["retried_check"])
+}
+
+func testPreloadChecksAsync(t *testing.T) {
+	C.reset_loader_mock()
+
+	rtloader = newMockRtLoaderPtr()
+	defer func() { rtloader = nil }()
+
+	C.preload_checks_return = 1
+	PreloadChecksAsync([]string{"async_check"})
+
+	// the checks are preloaded in the background
+	assert.Eventually(t, func() bool {
+		_, found := expvarImportTimes().(map[string]float64)["async_check"]
+		return found
+	}, time.Second, 10*time.Millisecond)
+	assert.Nil(t, popPreloadError("async_check"))
+}
+
+func testLoadCheckNotPreloaded(t *testing.T) {
+	C.reset_loader_mock()
+
+	conf := integration.Config{
+		Name:       "not_a_check",
+		Instances:  []integration.Data{integration.Data("{\"value\": 1}")},
+		InitConfig: integration.Data("{}"),
+	}
+
+	rtloader = newMockRtLoaderPtr()
+	defer func() { rtloader = nil }()
+
+	loader, err := NewPythonCheckLoader()
+	assert.Nil(t, err)
+
+	PreloadChecks([]string{conf.Name})
+	assert.Equal(t, C.int(2), C.preload_checks_calls)
+
+	// the load following the failed preload doesn't import the modules again
+	_, err = loader.Load(conf, conf.Instances[0])
+	assert.NotNil(t, err)
+	assert.Equal(t, C.int(0), C.get_class_calls)
+
+	// the following ones do
+	loader.Load(conf, conf.Instances[0]) //nolint:errcheck
+	assert.Equal(t, C.int(2), C.get_class_calls)
+}
@@ -0,0 +1,121 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build python
+// +build python
+
+package python
+
+import (
+	"runtime"
+
+	"github.com/DataDog/datadog-agent/pkg/config"
+)
+
+/*
+#include "datadog_agent_rtloader.h"
+*/
+import "C"
+
+// pythonThreads runs the checks. It never keeps more idle threads than the
+// maximum number of check runners, since this bounds the number of checks
+// running concurrently.
+var pythonThreads = newPythonThreadPool(config.MaxNumWorkers)
+
+// pythonThread is a goroutine locked to its OS thread for its whole life, that
+// keeps a Python thread state registered with the interpreter. The sticky locks
+// taken on this thread reuse this thread state, instead of creating and
+// destroying one each time.
+type pythonThread struct {
+	jobs chan func()
+	done chan struct{}
+}
+
+// pythonThreadPool keeps the idle python threads to reuse them across check runs
+type pythonThreadPool struct {
+	idle chan *pythonThread
+}
+
+func newPythonThreadPool(maxIdle int) *pythonThreadPool {
+	return &pythonThreadPool{
+		idle: make(chan *pythonThread, maxIdle),
+	}
+}
+
+// run calls job on an idle python thread, or on a new one if they are all busy,
+// and waits for it to return.
+func (p *pythonThreadPool) run(job func()) {
+	var t *pythonThread
+	select {
+	case t = <-p.idle:
+	default:
+		t = newPythonThread()
+	}
+
+	t.jobs <- job
+	<-t.done
+
+	select {
+	case p.idle <- t:
+	default:
+		t.stop()
+	}
+}
+
+func newPythonThread() *pythonThread {
+	t := &pythonThread{
+		jobs: make(chan func()),
+		done: make(chan struct{}),
+	}
+	go t.loop()
+	return t
+}
+
+func (t *pythonThread) loop() {
+	// The thread state can only be used and released from the thread that acquired it.
+	// The sticky locks taken by the jobs nest with this lock, so the goroutine stays
+	// on this thread when they are released.
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	var state *C.rtloader_threadstate_t
+	for job := range t.jobs {
+		if state == nil {
+			state = acquireThreadState()
+		}
+		job()
+		t.done <- struct{}{}
+	}
+
+	if state != nil {
+		releaseThreadState(state)
+	}
+}
+
+// stop releases the thread state and the OS thread once the current job returns
+func (t *pythonThread) stop() {
+	close(t.jobs)
+}
+
+// acquireThreadState returns nil when rtloader isn't initialized, the jobs then
+// fail to take their sticky lock.
+func acquireThreadState() *C.rtloader_threadstate_t {
+	pyDestroyLock.RLock()
+	defer pyDestroyLock.RUnlock()
+
+	if rtloader == nil {
+		return nil
+	}
+	return C.acquire_thread_state(rtloader)
+}
+
+func releaseThreadState(state *C.rtloader_threadstate_t) {
+	pyDestroyLock.RLock()
+	defer pyDestroyLock.RUnlock()
+
+	if rtloader != nil {
+		C.release_thread_state(rtloader, state)
+	}
+}
@@ -69,6 +69,8 @@ func InitCheckScheduler(collector *Collector) *CheckScheduler {
 
 // Schedule schedules configs to checks
 func (s *CheckScheduler) Schedule(configs []integration.Config) {
+	pyPreloadChecks(configs)
+
 	checks := s.GetChecksFromConfigs(configs, true)
 	for _, c := range checks {
 		_, err := s.collector.RunCheck(c)
@@ -1086,6 +1086,10 @@ func InitConfig(config Config) {
 	config.BindEnvAndSetDefault("runtime_security_config.load_controller.events_count_threshold", 20000)
 	config.BindEnvAndSetDefault("runtime_security_config.load_controller.discarder_timeout", 60)
 	config.BindEnvAndSetDefault("runtime_security_config.load_controller.control_period", 2)
+	config.BindEnvAndSetDefault("runtime_security_config.event_rate_limiter.enabled", false)
+	config.BindEnvAndSetDefault("runtime_security_config.event_rate_limiter.rate", 100)
+	config.BindEnvAndSetDefault("runtime_security_config.event_rate_limiter.burst", 1000)
+	config.BindEnvAndSetDefault("runtime_security_config.event_rate_limiter.event_types", []string{"open", "chmod", "chown", "utimes", "setxattr", "removexattr"})
 	config.BindEnvAndSetDefault("runtime_security_config.pid_cache_size", 10000)
 	config.BindEnvAndSetDefault("runtime_security_config.cookie_cache_size", 100)
 	config.BindEnvAndSetDefault("runtime_security_config.agent_monitoring_events", true)
@@ -1120,6 +1124,9 @@ func InitConfig(config Config) {
 	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.remote_storage.compression", true)
 	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.syscall_monitor.enabled", true)
 	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.syscall_monitor.period", 60)
+	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.stream.enabled", false)
+	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.stream.flush_period", 60)
+	config.BindEnvAndSetDefault("runtime_security_config.activity_dump.stream.output_directory", "/tmp/activity_dumps/streams/")
 	bindEnvAndSetLogsConfigKeys(config, "runtime_security_config.activity_dump.remote_storage.endpoints.")
 	config.BindEnvAndSetDefault("runtime_security_config.event_stream.use_ring_buffer", false)
 	config.BindEnv("runtime_security_config.event_stream.buffer_size")
@@ -4,4 +4,4 @@
 
 package runtime
 
-var Conntrack = NewRuntimeAsset("conntrack.c", "ae54d92e003d6afd947fbedb9ea5b503833d161c9e80b5102483f18a5dbf1d41")
+var Conntrack = NewRuntimeAsset("conntrack.c", "dc72343ffb80d51026b6054eb344e9123e2df2e74546d8284fa401aebc12ea40")
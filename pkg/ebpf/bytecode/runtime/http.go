@@ -4,4 +4,4 @@
 
 package runtime
 
-var Http = NewRuntimeAsset("http.c", "4e83e6edc63551e648c8e4005fdcb6d07b591c4775a130d3ccb71e732949f513")
+var Http = NewRuntimeAsset("http.c", "e36f0785a570470d2a0db13f257aff3e84d5ca9ad4cb5012b43ec86b56cfe149")
@@ -0,0 +1,174 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package runtime
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"time"
+
+	"golang.org/x/sys/unix"
+
+	"github.com/DataDog/datadog-agent/pkg/util/log"
+)
+
+// The runtime compiler output directory is a content-addressed cache of compiled objects, kept across
+// restarts and shared by the system-probe processes using the same directory, e.g. during an upgrade. An
+// object is named after the hashes of everything that affects its content: the running kernel and the
+// generated headers identifying its build and configuration, the asset and the cflags.
+//
+// Objects are written atomically with a rename so that a reader never sees a partial object, and the
+// compilation of a given object is serialized by an flock on a sidecar lock file so that concurrent
+// processes compile it only once. The modification time of an object is its last use, which is used to
+// evict the least recently used objects when the directory grows above its size limit.
+
+const (
+	objectFileSuffix = ".o"
+	lockFileSuffix   = ".lock"
+	tmpFileSuffix    = ".tmp"
+
+	// staleTmpFileAge is the age after which a temporary file is considered left over by a crashed compilation
+	staleTmpFileAge = time.Hour
+)
+
+// kernelHeadersFingerprintFiles are the generated headers which identify a kernel build and its configuration
+var kernelHeadersFingerprintFiles = []string{
+	"include/generated/uapi/linux/version.h",
+	"include/generated/utsrelease.h",
+	"include/generated/autoconf.h",
+}
+
+// kernelHeadersHash returns a hash identifying the running kernel and the headers that the objects are
+// compiled against, so that installing different headers for the same kernel invalidates the cache
+func kernelHeadersHash(uname *unix.Utsname, headerDirs []string) (string, error) {
+	h := sha256.New()
+	io.WriteString(h, unix.ByteSliceToString(uname.Release[:]))
+	io.WriteString(h, unix.ByteSliceToString(uname.Version[:]))
+	for _, dir := range headerDirs {
+		io.WriteString(h, dir)
+		for _, name := range kernelHeadersFingerprintFiles {
+			content, err := ioutil.ReadFile(filepath.Join(dir, name))
+			if err != nil {
+				if os.IsNotExist(err) {
+					continue
+				}
+				return "", err
+			}
+			h.Write(content)
+		}
+	}
+	return hex.EncodeToString(h.Sum(nil)), nil
+}
+
+// lockObject takes an exclusive lock on the given object, blocking until any other compilation of the same
+// object is done. The returned function releases the lock.
+func lockObject(objectFile string) (func(), error) {
+	f, err := os.OpenFile(objectFile+lockFileSuffix, os.O_CREATE|os.O_RDWR, 0600)
+	if err != nil {
+		return nil, err
+	}
+
+	for {
+		err = unix.Flock(int(f.Fd()), unix.LOCK_EX)
+		if err != unix.EINTR {
+			break
+		}
+	}
+	if err != nil {
+		f.Close()
+		return nil, err
+	}
+
+	return func() {
+		_ = unix.Flock(int(f.Fd()), unix.LOCK_UN)
+		f.Close()
+	}, nil
+}
+
+// touchObject marks the object as recently used
+func touchObject(objectFile string) {
+	now := time.Now()
+	if err := os.Chtimes(objectFile, now, now); err != nil {
+		log.Debugf("unable to update the modification time of %s: %s", objectFile, err)
+	}
+}
+
+// evictObjects removes the least recently used objects of the directory until its total size is below
+// maxSize, never removing the object to keep. It returns the number of removed objects.
+func evictObjects(dir string, maxSize int64, keep string) (int, error) {
+	if maxSize <= 0 {
+		return 0, nil
+	}
+
+	entries, err := ioutil.ReadDir(dir)
+	if err != nil {
+		return 0, err
+	}
+
+	var objects []os.FileInfo
+	var totalSize int64
+	for _, entry := range entries {
+		name := entry.Name()
+		switch {
+		case strings.HasSuffix(name, objectFileSuffix):
+			objects = append(objects, entry)
+			totalSize += entry.Size()
+		case strings.HasSuffix(name, tmpFileSuffix) && time.Since(entry.ModTime()) > staleTmpFileAge:
+			_ = os.Remove(filepath.Join(dir, name))
+		}
+	}
+
+	sort.Slice(objects, func(i, j int) bool {
+		return objects[i].ModTime().Before(objects[j].ModTime())
+	})
+
+	evicted := 0
+	for _, object := range objects {
+		if totalSize <= maxSize {
+			break
+		}
+
+		path := filepath.Join(dir, object.Name())
+		if path == keep {
+			continue
+		}
+		if err := os.Remove(path); err != nil && !os.IsNotExist(err) {
+			log.Warnf("unable to evict compiled object %s: %s", path, err)
+			continue
+		}
+		removeLockFile(path)
+		totalSize -= object.Size()
+		evicted++
+		log.Debugf("evicted compiled object %s", path)
+	}
+	return evicted, nil
+}
+
+// removeLockFile removes the lock file of an evicted object, unless a compilation currently holds it. An agent
+// that opened the lock file just before its removal may compile the object concurrently with another one,
+// which only costs a duplicate compilation since objects are renamed into place atomically.
+func removeLockFile(objectFile string) {
+	lockFile := objectFile + lockFileSuffix
+	f, err := os.Open(lockFile)
+	if err != nil {
+		return
+	}
+	defer f.Close()
+
+	if err := unix.Flock(int(f.Fd()), unix.LOCK_EX|unix.LOCK_NB); err != nil {
+		return
+	}
+	_ = os.Remove(lockFile)
+}
@@ -0,0 +1,82 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package runtime
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"golang.org/x/sys/unix"
+)
+
+func TestEvictObjects(t *testing.T) {
+	dir := t.TempDir()
+	now := time.Now()
+
+	writeObject := func(name string, size int, age time.Duration) string {
+		path := filepath.Join(dir, name)
+		require.NoError(t, os.WriteFile(path, make([]byte, size), 0644))
+		require.NoError(t, os.WriteFile(path+lockFileSuffix, nil, 0600))
+		require.NoError(t, os.Chtimes(path, now.Add(-age), now.Add(-age)))
+		return path
+	}
+
+	oldest := writeObject("oldest.o", 100, 3*time.Hour)
+	old := writeObject("old.o", 100, 2*time.Hour)
+	recent := writeObject("recent.o", 100, time.Hour)
+	kept := writeObject("kept.o", 100, 4*time.Hour)
+
+	staleTmp := filepath.Join(dir, "stale.o.123"+tmpFileSuffix)
+	require.NoError(t, os.WriteFile(staleTmp, nil, 0600))
+	require.NoError(t, os.Chtimes(staleTmp, now.Add(-2*staleTmpFileAge), now.Add(-2*staleTmpFileAge)))
+
+	evicted, err := evictObjects(dir, 250, kept)
+	require.NoError(t, err)
+	assert.Equal(t, 2, evicted)
+
+	assert.NoFileExists(t, oldest)
+	assert.NoFileExists(t, oldest+lockFileSuffix)
+	assert.NoFileExists(t, old)
+	assert.FileExists(t, recent)
+	assert.FileExists(t, kept)
+	assert.NoFileExists(t, staleTmp)
+
+	// a zero limit disables eviction
+	evicted, err = evictObjects(dir, 0, "")
+	require.NoError(t, err)
+	assert.Zero(t, evicted)
+	assert.FileExists(t, recent)
+}
+
+func TestKernelHeadersHash(t *testing.T) {
+	var uname unix.Utsname
+	copy(uname.Release[:], "5.15.0-1019-aws")
+
+	headers := t.TempDir()
+	autoconf := filepath.Join(headers, "include/generated/autoconf.h")
+	require.NoError(t, os.MkdirAll(filepath.Dir(autoconf), 0755))
+	require.NoError(t, os.WriteFile(autoconf, []byte("#define CONFIG_BPF 1\n"), 0644))
+
+	hash, err := kernelHeadersHash(&uname, []string{headers})
+	require.NoError(t, err)
+
+	same, err := kernelHeadersHash(&uname, []string{headers})
+	require.NoError(t, err)
+	assert.Equal(t, hash, same)
+
+	// reconfigured headers for the same kernel must not reuse the compiled objects
+	require.NoError(t, os.WriteFile(autoconf, []byte("#define CONFIG_BPF 1\n#define CONFIG_BPF_JIT 1\n"), 0644))
+	reconfigured, err := kernelHeadersHash(&uname, []string{headers})
+	require.NoError(t, err)
+	assert.NotEqual(t, hash, reconfigured)
+}
@@ -4,4 +4,4 @@
 
 package runtime
 
-var OomKill = NewRuntimeAsset("oom-kill.c", "5dcb629bf0dfe63368846ce069813f797015c76dfb9a5b2ffa8ec060dc4c75fb")
+var OomKill = NewRuntimeAsset("oom-kill.c", "0e4bc629f568f55f61fea0c2ff2b0da89fbbfe410a48e5d759b46352bf324d17")
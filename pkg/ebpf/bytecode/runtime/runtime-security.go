@@ -4,4 +4,4 @@
 
 package runtime
 
-var RuntimeSecurity = NewRuntimeAsset("runtime-security.c", "94d9914261d9db4f33cd2d7a2423b4e2b94a44e5aae3a7b3531e75e8008614d8")
+var RuntimeSecurity = NewRuntimeAsset("runtime-security.c", "1014b9c545ee812caaa5fbe86f2bb05bd72b86ba6b66be15a4f0e2733f68e6f4")
@@ -16,8 +16,7 @@ import (
 	"os"
 	"path/filepath"
 	"strings"
-
-	"golang.org/x/sys/unix"
+	"sync"
 
 	model "github.com/DataDog/agent-payload/v5/process"
 	"github.com/DataDog/datadog-go/v5/statsd"
@@ -60,6 +59,16 @@ type RuntimeAsset struct {
 	hash     string
 
 	runtimeCompiler *RuntimeCompiler
+
+	mu             sync.Mutex
+	precompilation *precompilation
+}
+
+// precompilation is a compilation of the asset started in the background
+type precompilation struct {
+	flagHash  string
+	done      chan struct{}
+	telemetry RuntimeCompilationTelemetry
 }
 
 func NewRuntimeAsset(filename, hash string) *RuntimeAsset {
@@ -96,11 +105,53 @@ func (a *RuntimeAsset) Verify(dir string) (io.Reader, string, error) {
 
 // Compile compiles the runtime asset if necessary and returns the resulting file.
 func (a *RuntimeAsset) Compile(config *ebpf.Config, cflags []string, client statsd.ClientInterface) (CompiledOutput, error) {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+
+	p := a.precompilation
+	a.precompilation = nil
+	if p != nil {
+		<-p.done
+	}
+
 	output, err := a.runtimeCompiler.CompileObjectFile(config, cflags, a.filename, a)
+	if p != nil && p.flagHash == hashFlags(append(defaultFlags, cflags...)) &&
+		a.runtimeCompiler.GetRCTelemetry().compilationResult == compiledOutputFound {
+		// the object was compiled in the background, report that compilation
+		a.runtimeCompiler.setRCTelemetry(p.telemetry)
+	}
 	a.SubmitTelemetry(client)
 	return output, err
 }
 
+// Precompile starts compiling the runtime asset in the background, so that independent assets are compiled
+// concurrently at startup. The next call to Compile waits for it and uses its output.
+func (a *RuntimeAsset) Precompile(config *ebpf.Config, cflags []string) {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+
+	if a.precompilation != nil {
+		return
+	}
+
+	p := &precompilation{
+		flagHash: hashFlags(append(defaultFlags, cflags...)),
+		done:     make(chan struct{}),
+	}
+	a.precompilation = p
+
+	go func() {
+		defer close(p.done)
+		output, err := a.runtimeCompiler.CompileObjectFile(config, cflags, a.filename, a)
+		if err != nil {
+			log.Debugf("background compilation of %s failed: %s", a.filename, err)
+		} else {
+			output.Close()
+		}
+		p.telemetry = a.runtimeCompiler.GetRCTelemetry()
+	}()
+}
+
 func (a *RuntimeAsset) GetInputReader(config *ebpf.Config, tm *RuntimeCompilationTelemetry) (io.Reader, error) {
 	inputReader, _, err := a.Verify(config.BPFDir)
 	if err != nil {
@@ -111,17 +162,12 @@ func (a *RuntimeAsset) GetInputReader(config *ebpf.Config, tm *RuntimeCompilatio
 	return inputReader, nil
 }
 
-func (a *RuntimeAsset) GetOutputFilePath(config *ebpf.Config, uname *unix.Utsname, flagHash string, tm *RuntimeCompilationTelemetry) (string, error) {
-	// filename includes kernel version, input file hash, and cflags hash
+func (a *RuntimeAsset) GetOutputFilePath(config *ebpf.Config, kernelHash string, flagHash string, tm *RuntimeCompilationTelemetry) (string, error) {
+	// filename includes kernel headers hash, input file hash, and cflags hash
 	// this ensures we re-compile when either of the input changes
 	baseName := strings.TrimSuffix(a.filename, filepath.Ext(a.filename))
 
-	unameHash, err := UnameHash(uname)
-	if err != nil {
-		return "", err
-	}
-
-	outputFile := filepath.Join(config.RuntimeCompilerOutputDir, fmt.Sprintf("%s-%s-%s-%s.o", baseName, unameHash, a.hash, flagHash))
+	outputFile := filepath.Join(config.RuntimeCompilerOutputDir, fmt.Sprintf("%s-%s-%s-%s.o", baseName, kernelHash, a.hash, flagHash))
 	return outputFile, nil
 }
 
@@ -169,6 +215,12 @@ func (a *RuntimeAsset) SubmitTelemetry(statsdClient statsd.ClientInterface) {
 		if err := statsdClient.Count("datadog.system_probe.runtime_compilation.attempted", 1.0, rcTags, 1.0); err != nil {
 			log.Warnf("error submitting runtime compilation metric to statsd: %s", err)
 		}
+
+		if tm.compilationResult == compilationSuccess {
+			if err := statsdClient.Gauge("datadog.system_probe.runtime_compilation.compile_duration", float64(tm.compileDuration.Milliseconds()), tags, 1.0); err != nil {
+				log.Warnf("error submitting runtime compilation duration metric to statsd: %s", err)
+			}
+		}
 	}
 
 	if tm.headerFetchResult != kernel.NotAttempted {
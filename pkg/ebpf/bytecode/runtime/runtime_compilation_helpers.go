@@ -13,7 +13,10 @@ import (
 	"encoding/hex"
 	"fmt"
 	"io"
+	"io/ioutil"
 	"os"
+	"path/filepath"
+	"sync"
 	"time"
 
 	"golang.org/x/sys/unix"
@@ -63,6 +66,13 @@ type RuntimeCompilationTelemetry struct {
 	compilationResult   CompilationResult
 	compilationDuration time.Duration
 	headerFetchResult   kernel.HeaderFetchResult
+
+	// compileDuration is the time spent in the compiler, which is zero when the compiled object was cached
+	compileDuration time.Duration
+	// lockWaitDuration is the time spent waiting for other agents compiling the same object
+	lockWaitDuration time.Duration
+	// evictedObjects is the number of cached objects evicted to make room for the compiled object
+	evictedObjects int
 }
 
 func NewRuntimeCompilationTelemetry() RuntimeCompilationTelemetry {
@@ -80,6 +90,9 @@ func (tm *RuntimeCompilationTelemetry) GetTelemetry() map[string]int64 {
 		stats["runtime_compilation_result"] = int64(tm.compilationResult)
 		stats["kernel_header_fetch_result"] = int64(tm.headerFetchResult)
 		stats["runtime_compilation_duration"] = tm.compilationDuration.Nanoseconds()
+		stats["runtime_compilation_compile_duration"] = tm.compileDuration.Nanoseconds()
+		stats["runtime_compilation_lock_wait_duration"] = tm.lockWaitDuration.Nanoseconds()
+		stats["runtime_compilation_evicted_objects"] = int64(tm.evictedObjects)
 	} else {
 		stats["runtime_compilation_enabled"] = 0
 	}
@@ -113,11 +126,13 @@ func (tm *RuntimeCompilationTelemetry) SendMetrics(client statsd.ClientInterface
 
 type RuntimeCompilationFileProvider interface {
 	GetInputReader(config *ebpf.Config, tm *RuntimeCompilationTelemetry) (io.Reader, error)
-	GetOutputFilePath(config *ebpf.Config, uname *unix.Utsname, flagHash string, tm *RuntimeCompilationTelemetry) (string, error)
+	GetOutputFilePath(config *ebpf.Config, kernelHash string, flagHash string, tm *RuntimeCompilationTelemetry) (string, error)
 }
 
 type RuntimeCompiler struct {
-	telemetry RuntimeCompilationTelemetry
+	// telemetry is published at the end of each compilation, which may run in the background
+	telemetryLock sync.Mutex
+	telemetry     RuntimeCompilationTelemetry
 }
 
 func NewRuntimeCompiler() *RuntimeCompiler {
@@ -127,75 +142,136 @@ func NewRuntimeCompiler() *RuntimeCompiler {
 }
 
 func (rc *RuntimeCompiler) GetRCTelemetry() RuntimeCompilationTelemetry {
+	rc.telemetryLock.Lock()
+	defer rc.telemetryLock.Unlock()
 	return rc.telemetry
 }
 
+func (rc *RuntimeCompiler) setRCTelemetry(tm RuntimeCompilationTelemetry) {
+	rc.telemetryLock.Lock()
+	defer rc.telemetryLock.Unlock()
+	rc.telemetry = tm
+}
+
 func (rc *RuntimeCompiler) CompileObjectFile(config *ebpf.Config, cflags []string, inputFileName string, provider RuntimeCompilationFileProvider) (CompiledOutput, error) {
+	tm := rc.GetRCTelemetry()
+	output, err := compileObjectFile(config, cflags, inputFileName, provider, &tm)
+	rc.setRCTelemetry(tm)
+	return output, err
+}
+
+func compileObjectFile(config *ebpf.Config, cflags []string, inputFileName string, provider RuntimeCompilationFileProvider, tm *RuntimeCompilationTelemetry) (CompiledOutput, error) {
 	start := time.Now()
 	defer func() {
-		rc.telemetry.compilationDuration = time.Since(start)
-		rc.telemetry.compilationEnabled = true
+		tm.compilationDuration = time.Since(start)
+		tm.compilationEnabled = true
 	}()
 
 	// we use the raw uname instead of the kernel version, because some kernel versions
 	// can be clamped to 255 thus causing collisions
 	var uname unix.Utsname
 	if err := unix.Uname(&uname); err != nil {
-		rc.telemetry.compilationResult = kernelVersionErr
+		tm.compilationResult = kernelVersionErr
 		return nil, fmt.Errorf("unable to get kernel version: %w", err)
 	}
 
-	inputReader, err := provider.GetInputReader(config, &rc.telemetry)
+	inputReader, err := provider.GetInputReader(config, tm)
 	if err != nil {
 		return nil, err
 	}
 
 	if err := os.MkdirAll(config.RuntimeCompilerOutputDir, 0755); err != nil {
-		rc.telemetry.compilationResult = outputDirErr
+		tm.compilationResult = outputDirErr
 		return nil, fmt.Errorf("unable to create compiler output directory %s: %w", config.RuntimeCompilerOutputDir, err)
 	}
 
-	flags := append(defaultFlags, cflags...)
-	outputFile, err := provider.GetOutputFilePath(config, &uname, hashFlags(flags), &rc.telemetry)
+	dirs, res, err := kernel.GetKernelHeaders(config.EnableKernelHeaderDownload, config.KernelHeadersDirs, config.KernelHeadersDownloadDir, config.AptConfigDir, config.YumReposDir, config.ZypperReposDir)
+	tm.headerFetchResult = res
+	if err != nil {
+		tm.compilationResult = headerFetchErr
+		return nil, fmt.Errorf("unable to find kernel headers: %w", err)
+	}
 
+	kernelHash, err := kernelHeadersHash(&uname, dirs)
+	if err != nil {
+		tm.compilationResult = headerFetchErr
+		return nil, fmt.Errorf("unable to hash kernel headers: %w", err)
+	}
+
+	flags := append(defaultFlags, cflags...)
+	outputFile, err := provider.GetOutputFilePath(config, kernelHash, hashFlags(flags), tm)
 	if err != nil {
 		return nil, err
 	}
 
+	// another agent may be compiling the same object, in which case we wait for it and use its output
+	lockStart := time.Now()
+	unlock, err := lockObject(outputFile)
+	if err != nil {
+		tm.compilationResult = outputFileErr
+		return nil, fmt.Errorf("unable to lock output file %s: %w", outputFile, err)
+	}
+	defer unlock()
+	tm.lockWaitDuration = time.Since(lockStart)
+
 	if _, err := os.Stat(outputFile); err != nil {
 		if !os.IsNotExist(err) {
-			rc.telemetry.compilationResult = outputFileErr
+			tm.compilationResult = outputFileErr
 			return nil, fmt.Errorf("error stat-ing output file %s: %w", outputFile, err)
 		}
-		dirs, res, err := kernel.GetKernelHeaders(config.EnableKernelHeaderDownload, config.KernelHeadersDirs, config.KernelHeadersDownloadDir, config.AptConfigDir, config.YumReposDir, config.ZypperReposDir)
-		rc.telemetry.headerFetchResult = res
-		if err != nil {
-			rc.telemetry.compilationResult = headerFetchErr
-			return nil, fmt.Errorf("unable to find kernel headers: %w", err)
-		}
-		if err := compiler.CompileToObjectFile(inputReader, outputFile, flags, dirs); err != nil {
-			rc.telemetry.compilationResult = compilationErr
+
+		compileStart := time.Now()
+		if err := compileToObjectFile(inputReader, outputFile, flags, dirs); err != nil {
+			tm.compilationResult = compilationErr
 			return nil, fmt.Errorf("failed to compile runtime version of %s: %s", inputFileName, err)
 		}
-		rc.telemetry.compilationResult = compilationSuccess
-		log.Infof("successfully compiled runtime version of %s", inputFileName)
+		tm.compileDuration = time.Since(compileStart)
+		tm.compilationResult = compilationSuccess
+		log.Infof("successfully compiled runtime version of %s in %s", inputFileName, tm.compileDuration)
+
+		evicted, err := evictObjects(config.RuntimeCompilerOutputDir, config.RuntimeCompilerOutputDirMaxSize, outputFile)
+		if err != nil {
+			log.Warnf("unable to evict compiled objects from %s: %s", config.RuntimeCompilerOutputDir, err)
+		}
+		tm.evictedObjects = evicted
 	} else {
-		rc.telemetry.compilationResult = compiledOutputFound
+		tm.compilationResult = compiledOutputFound
+		touchObject(outputFile)
 	}
 
 	err = bytecode.VerifyAssetPermissions(outputFile)
 	if err != nil {
-		rc.telemetry.compilationResult = outputFileErr
+		tm.compilationResult = outputFileErr
 		return nil, err
 	}
 
 	out, err := os.Open(outputFile)
 	if err != nil {
-		rc.telemetry.compilationResult = resultReadErr
+		tm.compilationResult = resultReadErr
 	}
 	return out, err
 }
 
+// compileToObjectFile compiles the input to a temporary file which is then renamed to the output file,
+// so that the output file is never seen partially written by other agents
+func compileToObjectFile(in io.Reader, outputFile string, flags []string, headerDirs []string) error {
+	tmpFile, err := ioutil.TempFile(filepath.Dir(outputFile), filepath.Base(outputFile)+".*"+tmpFileSuffix)
+	if err != nil {
+		return err
+	}
+	tmpPath := tmpFile.Name()
+	tmpFile.Close()
+	defer os.Remove(tmpPath)
+
+	if err := compiler.CompileToObjectFile(in, tmpPath, flags, headerDirs); err != nil {
+		return err
+	}
+	if err := os.Chmod(tmpPath, 0644); err != nil {
+		return err
+	}
+	return os.Rename(tmpPath, outputFile)
+}
+
 // Sha256hex returns the hex string of the sha256 of the provided buffer
 func Sha256hex(buf []byte) (string, error) {
 	hasher := sha256.New()
@@ -4,4 +4,4 @@
 
 package runtime
 
-var TcpQueueLength = NewRuntimeAsset("tcp-queue-length.c", "aa298d8b67da8a6b56e7307696ae68114b5411cd6e0ac6f2e1413f095972051d")
+var TcpQueueLength = NewRuntimeAsset("tcp-queue-length.c", "60b1636a719874f18bbc47ff0f0c51f78093194da8cdd47ce90c8b2bfee05d34")
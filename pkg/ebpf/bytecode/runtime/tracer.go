@@ -4,4 +4,4 @@
 
 package runtime
 
-var Tracer = NewRuntimeAsset("tracer.c", "01c59509da6b180c124ec280691685810e41c04916d9edd62bf01e3ab72b909d")
+var Tracer = NewRuntimeAsset("tracer.c", "213bef0bb5b10c9abe33ba6644c2d13cc2df5a663b7a58f7a333f9b23720129c")
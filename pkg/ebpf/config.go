@@ -48,6 +48,10 @@ type Config struct {
 	// RuntimeCompilerOutputDir is the directory where the runtime compiler will store compiled programs
 	RuntimeCompilerOutputDir string
 
+	// RuntimeCompilerOutputDirMaxSize is the size in bytes above which the least recently used compiled programs are
+	// removed from the runtime compiler output directory. Zero disables the limit.
+	RuntimeCompilerOutputDirMaxSize int64
+
 	// AptConfigDir is the path to the apt config directory
 	AptConfigDir string
 
@@ -77,14 +81,15 @@ func NewConfig() *Config {
 		EnableTracepoints:        cfg.GetBool(key(spNS, "enable_tracepoints")),
 		ProcRoot:                 util.GetProcRoot(),
 
-		EnableRuntimeCompiler:      cfg.GetBool(key(spNS, "enable_runtime_compiler")),
-		RuntimeCompilerOutputDir:   cfg.GetString(key(spNS, "runtime_compiler_output_dir")),
-		EnableKernelHeaderDownload: cfg.GetBool(key(spNS, "enable_kernel_header_download")),
-		KernelHeadersDirs:          cfg.GetStringSlice(key(spNS, "kernel_header_dirs")),
-		KernelHeadersDownloadDir:   cfg.GetString(key(spNS, "kernel_header_download_dir")),
-		AptConfigDir:               cfg.GetString(key(spNS, "apt_config_dir")),
-		YumReposDir:                cfg.GetString(key(spNS, "yum_repos_dir")),
-		ZypperReposDir:             cfg.GetString(key(spNS, "zypper_repos_dir")),
-		AllowPrecompiledFallback:   cfg.GetBool(key(spNS, "allow_precompiled_fallback")),
+		EnableRuntimeCompiler:           cfg.GetBool(key(spNS, "enable_runtime_compiler")),
+		RuntimeCompilerOutputDir:        cfg.GetString(key(spNS, "runtime_compiler_output_dir")),
+		RuntimeCompilerOutputDirMaxSize: cfg.GetInt64(key(spNS, "runtime_compiler_output_dir_max_size")),
+		EnableKernelHeaderDownload:      cfg.GetBool(key(spNS, "enable_kernel_header_download")),
+		KernelHeadersDirs:               cfg.GetStringSlice(key(spNS, "kernel_header_dirs")),
+		KernelHeadersDownloadDir:        cfg.GetString(key(spNS, "kernel_header_download_dir")),
+		AptConfigDir:                    cfg.GetString(key(spNS, "apt_config_dir")),
+		YumReposDir:                     cfg.GetString(key(spNS, "yum_repos_dir")),
+		ZypperReposDir:                  cfg.GetString(key(spNS, "zypper_repos_dir")),
+		AllowPrecompiledFallback:        cfg.GetBool(key(spNS, "allow_precompiled_fallback")),
 	}
 }
@@ -0,0 +1,112 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package ebpf
+
+import (
+	"errors"
+	"runtime"
+	"unsafe"
+
+	"golang.org/x/sys/unix"
+)
+
+// batch commands of the bpf(2) syscall, available since Linux 5.6
+const (
+	bpfMapLookupBatch = 24
+	bpfMapDeleteBatch = 27
+
+	// errno returned by the kernel when a map type doesn't implement batch operations
+	enotsupp = unix.Errno(524)
+)
+
+// mapBatchAttr is the `batch` member of `union bpf_attr`
+type mapBatchAttr struct {
+	inBatch   uint64
+	outBatch  uint64
+	keys      uint64
+	values    uint64
+	count     uint32
+	mapFd     uint32
+	elemFlags uint64
+	flags     uint64
+}
+
+// mapBatch calls the bpf(2) syscall with a batch command. The buffers referenced by `attr` must be kept
+// alive by the caller until the call returns.
+func mapBatch(cmd int, attr *mapBatchAttr) error {
+	_, _, errno := unix.Syscall(unix.SYS_BPF, uintptr(cmd), uintptr(unsafe.Pointer(attr)), unsafe.Sizeof(*attr))
+	runtime.KeepAlive(attr)
+	if errno != 0 {
+		return errno
+	}
+	return nil
+}
+
+// isBatchUnsupported returns whether the error returned by a batch command means that either the kernel
+// or the map type doesn't support batch operations
+func isBatchUnsupported(err error) bool {
+	return errors.Is(err, unix.EINVAL) || errors.Is(err, enotsupp) || errors.Is(err, unix.EOPNOTSUPP)
+}
+
+// lookupBatch reads up to `count` entries of the map, starting at the position stored in `cursor`, or at the
+// beginning of the map if `cursor` is nil. The position of the next batch is stored in `nextCursor`.
+// Reaching the end of the map is reported by `done`, the last entries read are still returned in that case.
+func lookupBatch(fd int, cursor, nextCursor, keys, values []byte, count int) (n int, done bool, err error) {
+	attr := mapBatchAttr{
+		outBatch: uint64(uintptr(unsafe.Pointer(&nextCursor[0]))),
+		keys:     uint64(uintptr(unsafe.Pointer(&keys[0]))),
+		values:   uint64(uintptr(unsafe.Pointer(&values[0]))),
+		count:    uint32(count),
+		mapFd:    uint32(fd),
+	}
+	if cursor != nil {
+		attr.inBatch = uint64(uintptr(unsafe.Pointer(&cursor[0])))
+	}
+
+	err = mapBatch(bpfMapLookupBatch, &attr)
+	runtime.KeepAlive(cursor)
+	runtime.KeepAlive(nextCursor)
+	runtime.KeepAlive(keys)
+	runtime.KeepAlive(values)
+
+	if errors.Is(err, unix.ENOENT) {
+		return int(attr.count), true, nil
+	}
+	if err != nil {
+		return 0, false, err
+	}
+	return int(attr.count), false, nil
+}
+
+// deleteBatch deletes the keys stored back to back in `keys`. The keys that don't exist anymore are skipped.
+func deleteBatch(fd int, keys []byte, keySize int) (int, error) {
+	deleted := 0
+	for len(keys) > 0 {
+		attr := mapBatchAttr{
+			keys:  uint64(uintptr(unsafe.Pointer(&keys[0]))),
+			count: uint32(len(keys) / keySize),
+			mapFd: uint32(fd),
+		}
+
+		err := mapBatch(bpfMapDeleteBatch, &attr)
+		runtime.KeepAlive(keys)
+
+		deleted += int(attr.count)
+		if err == nil {
+			break
+		}
+		if !errors.Is(err, unix.ENOENT) {
+			return deleted, err
+		}
+
+		// the kernel stops at the first key that doesn't exist anymore
+		keys = keys[(int(attr.count)+1)*keySize:]
+	}
+	return deleted, nil
+}
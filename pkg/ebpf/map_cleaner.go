@@ -20,7 +20,9 @@ import (
 	"unsafe"
 
 	cebpf "github.com/cilium/ebpf"
+	"go.uber.org/atomic"
 
+	"github.com/DataDog/datadog-agent/pkg/util/atomicstats"
 	"github.com/DataDog/datadog-agent/pkg/util/log"
 	"github.com/DataDog/datadog-agent/pkg/util/native"
 )
@@ -38,11 +40,45 @@ type MapCleaner struct {
 	keyPtr unsafe.Pointer
 	valPtr unsafe.Pointer
 
+	// keyBytes and valBytes alias the memory of the key and value variables. They are only set
+	// when the Go types have the exact size of the map key and value, in which case the entries
+	// are decoded with plain copies
+	keyBytes []byte
+	valBytes []byte
+
+	// batch holds the buffers of the BPF_MAP_*_BATCH commands, nil if the map can't be
+	// cleaned with batch operations
+	batch *mapCleanerBatch
+
+	// keysToDelete holds the keys to delete back to back, it is reused across cleaning passes
+	keysToDelete []byte
+
+	telemetry *mapCleanerTelemetry
+
 	// termination
 	stopOnce sync.Once
 	done     chan struct{}
 }
 
+// mapCleanerBatchSize is the maximum number of entries read by a BPF_MAP_LOOKUP_BATCH command
+const mapCleanerBatchSize = 512
+
+type mapCleanerBatch struct {
+	keys       []byte
+	values     []byte
+	cursor     []byte
+	nextCursor []byte
+}
+
+type mapCleanerTelemetry struct {
+	passes         *atomic.Int64    `stats:""`
+	batchPasses    *atomic.Int64    `stats:""`
+	entriesChecked *atomic.Int64    `stats:""`
+	entriesDeleted *atomic.Int64    `stats:""`
+	lastPassTime   *atomic.Duration `stats:""`
+	totalPassTime  *atomic.Duration `stats:""`
+}
+
 // NewMapCleaner instantiates a new MapCleaner
 func NewMapCleaner(emap *cebpf.Map, key, val interface{}) (*MapCleaner, error) {
 	// we force types to be of pointer kind because of the reasons mentioned above
@@ -53,14 +89,44 @@ func NewMapCleaner(emap *cebpf.Map, key, val interface{}) (*MapCleaner, error) {
 		return nil, fmt.Errorf("%T is not a pointer kind", val)
 	}
 
-	return &MapCleaner{
+	mc := &MapCleaner{
 		emap:   emap,
 		key:    key,
 		val:    val,
 		keyPtr: unsafe.Pointer(reflect.ValueOf(key).Elem().Addr().Pointer()),
 		valPtr: unsafe.Pointer(reflect.ValueOf(val).Elem().Addr().Pointer()),
-		done:   make(chan struct{}),
-	}, nil
+		telemetry: &mapCleanerTelemetry{
+			passes:         atomic.NewInt64(0),
+			batchPasses:    atomic.NewInt64(0),
+			entriesChecked: atomic.NewInt64(0),
+			entriesDeleted: atomic.NewInt64(0),
+			lastPassTime:   atomic.NewDuration(0),
+			totalPassTime:  atomic.NewDuration(0),
+		},
+		done: make(chan struct{}),
+	}
+
+	keySize, valSize := int(emap.KeySize()), int(emap.ValueSize())
+	if reflect.TypeOf(key).Elem().Size() == uintptr(keySize) && reflect.TypeOf(val).Elem().Size() == uintptr(valSize) {
+		mc.keyBytes = unsafe.Slice((*byte)(mc.keyPtr), keySize)
+		mc.valBytes = unsafe.Slice((*byte)(mc.valPtr), valSize)
+
+		// per-CPU maps can't be cleaned by the predicate on a single value anyway
+		if emap.Type() == cebpf.Hash || emap.Type() == cebpf.LRUHash {
+			cursorSize := keySize
+			if cursorSize < 8 {
+				cursorSize = 8
+			}
+			mc.batch = &mapCleanerBatch{
+				keys:       make([]byte, mapCleanerBatchSize*keySize),
+				values:     make([]byte, mapCleanerBatchSize*valSize),
+				cursor:     make([]byte, cursorSize),
+				nextCursor: make([]byte, cursorSize),
+			}
+		}
+	}
+
+	return mc, nil
 }
 
 // Clean eBPF map
@@ -95,6 +161,14 @@ func (mc *MapCleaner) Clean(interval time.Duration, shouldClean func(nowTS int64
 	})
 }
 
+// GetStats returns the telemetry of the cleaning passes
+func (mc *MapCleaner) GetStats() map[string]interface{} {
+	if mc == nil {
+		return map[string]interface{}{}
+	}
+	return atomicstats.Report(mc.telemetry)
+}
+
 func (mc *MapCleaner) Stop() {
 	if mc == nil {
 		return
@@ -108,10 +182,95 @@ func (mc *MapCleaner) Stop() {
 }
 
 func (mc *MapCleaner) clean(nowTS int64, shouldClean func(nowTS int64, k, v interface{}) bool) error {
+	var (
+		totalCount, deletedCount int
+		err                      error
+		batch                    bool
+	)
+	now := time.Now()
+
+	if mc.batch != nil {
+		totalCount, deletedCount, err = mc.cleanBatch(nowTS, shouldClean)
+		if err != nil && isBatchUnsupported(err) && totalCount == 0 {
+			log.Debugf("batch operations aren't supported for map=%s, falling back to iteration: %s", mc.emap, err)
+			mc.batch = nil
+		} else {
+			batch = true
+		}
+	}
+	if !batch {
+		totalCount, deletedCount, err = mc.cleanIterate(nowTS, shouldClean)
+	}
+
+	elapsed := time.Now().Sub(now)
+	mc.telemetry.passes.Inc()
+	if batch {
+		mc.telemetry.batchPasses.Inc()
+	}
+	mc.telemetry.entriesChecked.Add(int64(totalCount))
+	mc.telemetry.entriesDeleted.Add(int64(deletedCount))
+	mc.telemetry.lastPassTime.Store(elapsed)
+	mc.telemetry.totalPassTime.Add(elapsed)
+
+	log.Debugf(
+		"finished cleaning map=%s batch=%t entries_checked=%d entries_deleted=%d error=%v elapsed=%s",
+		mc.emap,
+		batch,
+		totalCount,
+		deletedCount,
+		err,
+		elapsed,
+	)
+	return nil
+}
+
+// cleanBatch reads the map with BPF_MAP_LOOKUP_BATCH and deletes the entries with BPF_MAP_DELETE_BATCH.
+// The entries are decoded by copying the raw bytes into the key and value variables.
+func (mc *MapCleaner) cleanBatch(nowTS int64, shouldClean func(nowTS int64, k, v interface{}) bool) (int, int, error) {
+	keySize, valSize := len(mc.keyBytes), len(mc.valBytes)
+	fd := mc.emap.FD()
+	b := mc.batch
+	mc.keysToDelete = mc.keysToDelete[:0]
+	totalCount := 0
+
+	var cursor []byte
+	for {
+		n, done, err := lookupBatch(fd, cursor, b.nextCursor, b.keys, b.values, mapCleanerBatchSize)
+		if err != nil {
+			return totalCount, 0, err
+		}
+
+		for i := 0; i < n; i++ {
+			totalCount++
+
+			key := b.keys[i*keySize : (i+1)*keySize]
+			copy(mc.keyBytes, key)
+			copy(mc.valBytes, b.values[i*valSize:(i+1)*valSize])
+
+			if shouldClean(nowTS, mc.key, mc.val) {
+				mc.keysToDelete = append(mc.keysToDelete, key...)
+			}
+		}
+
+		if done {
+			break
+		}
+		copy(b.cursor, b.nextCursor)
+		cursor = b.cursor
+	}
+
+	if len(mc.keysToDelete) == 0 {
+		return totalCount, 0, nil
+	}
+	deletedCount, err := deleteBatch(fd, mc.keysToDelete, keySize)
+	return totalCount, deletedCount, err
+}
+
+// cleanIterate walks the map with one syscall per entry, it is used on kernels without batch operations
+func (mc *MapCleaner) cleanIterate(nowTS int64, shouldClean func(nowTS int64, k, v interface{}) bool) (int, int, error) {
 	keySize := int(mc.emap.KeySize())
 	keysToDelete := make([][]byte, 0, 128)
 	totalCount, deletedCount := 0, 0
-	now := time.Now()
 
 	entries := mc.emap.Iterate()
 	for entries.Next(mc.keyPtr, mc.valPtr) {
@@ -121,9 +280,15 @@ func (mc *MapCleaner) clean(nowTS int64, shouldClean func(nowTS int64, k, v inte
 			continue
 		}
 
-		marshalledKey, err := marshalBytes(mc.key, keySize)
-		if err != nil {
-			continue
+		var marshalledKey []byte
+		if mc.keyBytes != nil {
+			marshalledKey = append([]byte(nil), mc.keyBytes...)
+		} else {
+			var err error
+			marshalledKey, err = marshalBytes(mc.key, keySize)
+			if err != nil {
+				continue
+			}
 		}
 
 		// we accumulate alll keys to delete because it isn't safe to delete map
@@ -140,17 +305,7 @@ func (mc *MapCleaner) clean(nowTS int64, shouldClean func(nowTS int64, k, v inte
 		}
 	}
 
-	iterationErr := entries.Err()
-	elapsed := time.Now().Sub(now)
-	log.Debugf(
-		"finished cleaning map=%s entries_checked=%d entries_deleted=%d iteration_error=%v elapsed=%s",
-		mc.emap,
-		totalCount,
-		deletedCount,
-		iterationErr,
-		elapsed,
-	)
-	return nil
+	return totalCount, deletedCount, entries.Err()
 }
 
 // marshalBytes converts an arbitrary value into a byte buffer.
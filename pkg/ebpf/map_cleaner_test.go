@@ -54,6 +54,11 @@ func TestMapCleaner(t *testing.T) {
 	time.Sleep(1 * time.Second)
 	cleaner.Stop()
 
+	stats := cleaner.GetStats()
+	assert.NotZero(t, stats["passes"])
+	assert.GreaterOrEqual(t, stats["entries_checked"], int64(numMapEntries))
+	assert.Equal(t, int64(numMapEntries/2), stats["entries_deleted"])
+
 	for i := 0; i < numMapEntries; i++ {
 		*key = int64(i)
 		err := m.Lookup(key, val)
@@ -75,6 +75,10 @@ type Config struct {
 	// Supported libraries: OpenSSL
 	EnableHTTPSMonitoring bool
 
+	// EnableGoTLSSupport specifies whether the tracer should monitor HTTPS traffic done through Go's crypto/tls,
+	// by attaching uprobes to the Go binaries running on the host. It requires EnableHTTPSMonitoring and runtime compilation.
+	EnableGoTLSSupport bool
+
 	// UDPConnTimeout determines the length of traffic inactivity between two
 	// (IP, port)-pairs before declaring a UDP connection as inactive. This is
 	// set to /proc/sys/net/netfilter/nf_conntrack_udp_timeout on Linux by
@@ -150,6 +154,10 @@ type Config struct {
 	// OffsetGuessThreshold is the size of the byte threshold we will iterate over when guessing offsets
 	OffsetGuessThreshold uint64
 
+	// OffsetGuessCacheDir is the directory where the guessed offsets are persisted, so that they are
+	// reused across restarts on the same kernel. An empty value disables the cache.
+	OffsetGuessCacheDir string
+
 	// EnableMonotonicCount (Windows only) determines if we will calculate send/recv bytes of connections with headers and retransmits
 	EnableMonotonicCount bool
 
@@ -198,6 +206,7 @@ func New() *Config {
 
 		CollectIPv6Conns:               !cfg.GetBool(join(spNS, "disable_ipv6")),
 		OffsetGuessThreshold:           uint64(cfg.GetInt64(join(spNS, "offset_guess_threshold"))),
+		OffsetGuessCacheDir:            cfg.GetString(join(spNS, "offset_guess_cache_dir")),
 		ExcludedSourceConnections:      cfg.GetStringMapStringSlice(join(spNS, "source_excludes")),
 		ExcludedDestinationConnections: cfg.GetStringMapStringSlice(join(spNS, "dest_excludes")),
 
@@ -217,6 +226,7 @@ func New() *Config {
 
 		EnableHTTPMonitoring:  cfg.GetBool(join(netNS, "enable_http_monitoring")),
 		EnableHTTPSMonitoring: cfg.GetBool(join(netNS, "enable_https_monitoring")),
+		EnableGoTLSSupport:    cfg.GetBool(join(smNS, "enable_go_tls_support")),
 		MaxHTTPStatsBuffered:  cfg.GetInt(join(netNS, "max_http_stats_buffered")),
 
 		EnableConntrack:              cfg.GetBool(join(spNS, "enable_conntrack")),
@@ -7,6 +7,7 @@ package config
 
 import (
 	"os"
+	"path/filepath"
 	"testing"
 
 	"github.com/stretchr/testify/require"
@@ -33,3 +34,19 @@ func TestDisableRootNetNamespace(t *testing.T) {
 	defer ns.Close()
 	require.True(t, ns.Equal(rootNs))
 }
+
+func TestReadEphemeralPortRange(t *testing.T) {
+	procRoot := t.TempDir()
+	sysctlPath := filepath.Join(procRoot, "sys/net/ipv4/ip_local_port_range")
+	require.NoError(t, os.MkdirAll(filepath.Dir(sysctlPath), 0755))
+
+	require.NoError(t, os.WriteFile(sysctlPath, []byte("1024\t65000\n"), 0644))
+	start, end, err := readEphemeralPortRange(procRoot)
+	require.NoError(t, err)
+	require.Equal(t, uint16(1024), start)
+	require.Equal(t, uint16(65000), end)
+
+	require.NoError(t, os.WriteFile(sysctlPath, []byte("60000\t1024\n"), 0644))
+	_, _, err = readEphemeralPortRange(procRoot)
+	require.Error(t, err)
+}
@@ -0,0 +1,42 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+package config
+
+import (
+	"sync"
+
+	"github.com/DataDog/datadog-agent/pkg/util/log"
+)
+
+const (
+	// DefaultEphemeralRangeStart is the default start of net.ipv4.ip_local_port_range on Linux
+	DefaultEphemeralRangeStart = 32768
+	// DefaultEphemeralRangeEnd is the default end of net.ipv4.ip_local_port_range on Linux
+	DefaultEphemeralRangeEnd = 60999
+)
+
+var ephemeralRange struct {
+	once       sync.Once
+	start, end uint16
+}
+
+// EphemeralPortRange returns the range of local ports the host assigns to the client side of connections.
+// It is read once, since the eBPF programs normalizing connection tuples are loaded with it and the keys
+// built in userspace must match theirs.
+func EphemeralPortRange() (start, end uint16) {
+	ephemeralRange.once.Do(func() {
+		ephemeralRange.start, ephemeralRange.end = DefaultEphemeralRangeStart, DefaultEphemeralRangeEnd
+
+		start, end, err := hostEphemeralPortRange()
+		if err != nil {
+			log.Debugf("unable to read the ephemeral port range, defaulting to %d-%d: %s", DefaultEphemeralRangeStart, DefaultEphemeralRangeEnd, err)
+			return
+		}
+		log.Infof("ephemeral port range: %d-%d", start, end)
+		ephemeralRange.start, ephemeralRange.end = start, end
+	})
+	return ephemeralRange.start, ephemeralRange.end
+}
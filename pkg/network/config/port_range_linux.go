@@ -0,0 +1,32 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package config
+
+import (
+	"fmt"
+	"math"
+
+	"github.com/DataDog/datadog-agent/pkg/network/config/sysctl"
+	"github.com/DataDog/datadog-agent/pkg/process/util"
+)
+
+func hostEphemeralPortRange() (uint16, uint16, error) {
+	return readEphemeralPortRange(util.GetProcRoot())
+}
+
+func readEphemeralPortRange(procRoot string) (uint16, uint16, error) {
+	start, end, err := sysctl.NewIntPair(procRoot, "net/ipv4/ip_local_port_range", 0).Get()
+	if err != nil {
+		return 0, 0, err
+	}
+	if start <= 0 || end > math.MaxUint16 || start > end {
+		return 0, 0, fmt.Errorf("invalid ephemeral port range %d-%d", start, end)
+	}
+	return uint16(start), uint16(end), nil
+}
@@ -97,13 +97,37 @@ static __always_inline int nf_conntrack_tuple_to_conntrack_tuple(conntrack_tuple
     return 1;
 }
 
-static __always_inline void increment_telemetry_registers_count() {
+enum conntrack_telemetry_counter
+{
+    registers,
+    registers_dropped,
+    deletes,
+};
+
+static __always_inline void increment_conntrack_telemetry_count(enum conntrack_telemetry_counter counter_name) {
     u64 key = 0;
     conntrack_telemetry_t *val = bpf_map_lookup_elem(&conntrack_telemetry, &key);
     if (val == NULL) {
         return;
     }
-    __sync_fetch_and_add(&val->registers, 1);
+
+    switch (counter_name) {
+    case registers:
+        __sync_fetch_and_add(&val->registers, 1);
+        break;
+    case registers_dropped:
+        __sync_fetch_and_add(&val->registers_dropped, 1);
+        break;
+    case deletes:
+        __sync_fetch_and_add(&val->deletes, 1);
+        break;
+    }
+}
+
+// is_nat_conntrack returns true for the confirmed conntrack entries of NAT'd connections,
+// which are the only ones tracked in the conntrack map
+static __always_inline bool is_nat_conntrack(u32 status) {
+    return (status&IPS_CONFIRMED) && (status&IPS_NAT_MASK);
 }
 
 static __always_inline int nf_conn_to_conntrack_tuples(struct nf_conn* ct, conntrack_tuple_t* orig, conntrack_tuple_t* reply) {
@@ -135,6 +159,31 @@ static __always_inline int nf_conn_to_conntrack_tuples(struct nf_conn* ct, connt
     return 0;
 }
 
+// insert_conntrack_tuples maps both directions of a NAT'd connection to each other
+static __always_inline void insert_conntrack_tuples(conntrack_tuple_t *orig, conntrack_tuple_t *reply) {
+    if (bpf_map_update_elem(&conntrack, orig, reply, BPF_ANY) != 0) {
+        increment_conntrack_telemetry_count(registers_dropped);
+        return;
+    }
+    if (bpf_map_update_elem(&conntrack, reply, orig, BPF_ANY) != 0) {
+        // don't leave a one-way translation behind, nothing would delete it
+        bpf_map_delete_elem(&conntrack, orig);
+        increment_conntrack_telemetry_count(registers_dropped);
+        return;
+    }
+    increment_conntrack_telemetry_count(registers);
+}
+
+// delete_conntrack_tuples removes both directions of a NAT'd connection
+static __always_inline void delete_conntrack_tuples(conntrack_tuple_t *orig, conntrack_tuple_t *reply) {
+    // a translation may already have been removed by system-probe once the connection closed
+    int orig_err = bpf_map_delete_elem(&conntrack, orig);
+    int reply_err = bpf_map_delete_elem(&conntrack, reply);
+    if (orig_err == 0 || reply_err == 0) {
+        increment_conntrack_telemetry_count(deletes);
+    }
+}
+
 static __always_inline bool proc_t_comm_prefix_equals(const char* prefix, int prefix_len, proc_t c) {
     if (prefix_len > TASK_COMM_LEN) {
         return false;
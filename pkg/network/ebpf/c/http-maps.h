@@ -21,6 +21,9 @@ BPF_HASH_MAP(http_batches, http_batch_key_t, http_batch_t, 0)
 /* This map holds one entry per CPU storing state associated to current http batch*/
 BPF_PERCPU_ARRAY_MAP(http_batch_state, __u32, http_batch_state_t, 1)
 
+/* This map holds the counters of the HTTP programs read by userspace for telemetry */
+BPF_ARRAY_MAP(http_telemetry, http_telemetry_t, 1)
+
 BPF_HASH_MAP(ssl_sock_by_ctx, void *, ssl_sock_t, 1)
 
 BPF_HASH_MAP(ssl_read_args, u64, ssl_read_args_t, 1024)
@@ -84,6 +84,12 @@ typedef struct {
     __u64 idx_to_notify;
 } http_batch_state_t;
 
+typedef struct {
+    // ambiguous_tuples counts the requests of connections whose ports are both in or both out of the
+    // ephemeral port range, which the port range heuristic can't normalize reliably
+    __u64 ambiguous_tuples;
+} http_telemetry_t;
+
 typedef struct {
     __u64 idx;
     __u8 pos;
@@ -109,9 +115,17 @@ typedef struct {
     void *buf;
 } ssl_read_args_t;
 
+// HTTPS_SKIP_READ and HTTPS_SKIP_WRITE are set in ssl_sock_t.skip once an HTTP message started in the
+// corresponding direction. With HTTP/1.x a new message only starts in a given direction after data
+// flowed in the other one (the response to a request, or the next request after a response), so
+// until then the fragments of that direction are body chunks that are not captured.
+#define HTTPS_SKIP_READ (1 << 0)
+#define HTTPS_SKIP_WRITE (1 << 1)
+
 typedef struct {
     conn_tuple_t tup;
     __u32 fd;
+    __u8 skip;
 } ssl_sock_t;
 
  #define LIB_PATH_MAX_SIZE 120
@@ -144,6 +144,23 @@ static __always_inline void http_parse_data(char const *p, http_packet_t *packet
 }
 
 
+// http_count_ambiguous_request accounts for the requests of tuples that the port range heuristic
+// couldn't normalize, whose transactions may be split across two entries of http_in_flight
+static __always_inline void http_count_ambiguous_request(char const *buffer) {
+    http_packet_t packet_type = HTTP_PACKET_UNKNOWN;
+    http_method_t method = HTTP_METHOD_UNKNOWN;
+    http_parse_data(buffer, &packet_type, &method);
+    if (packet_type != HTTP_REQUEST) {
+        return;
+    }
+
+    u32 key = 0;
+    http_telemetry_t *telemetry = bpf_map_lookup_elem(&http_telemetry, &key);
+    if (telemetry != NULL) {
+        __sync_fetch_and_add(&telemetry->ambiguous_tuples, 1);
+    }
+}
+
 static __always_inline http_transaction_t *http_fetch_state(http_transaction_t *http, skb_info_t *skb_info, http_packet_t packet_type) {
     if (packet_type == HTTP_PACKET_UNKNOWN) {
         return bpf_map_lookup_elem(&http_in_flight, &http->tup);
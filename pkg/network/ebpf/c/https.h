@@ -12,12 +12,38 @@
 
 static __always_inline int read_conn_tuple(conn_tuple_t* t, struct sock* skp, u64 pid_tgid, metadata_mask_t type);
 
-static __always_inline void https_process(conn_tuple_t *t, void *buffer, size_t len, __u64 tags) {
+// https_skip_fragment accounts for a body fragment of the ongoing transaction without capturing it,
+// which is all that http_process does for fragments that don't start an HTTP message
+static __always_inline void https_skip_fragment(conn_tuple_t *t, __u64 tags) {
+    http_transaction_t *http = bpf_map_lookup_elem(&http_in_flight, t);
+    if (http == NULL) {
+        return;
+    }
+    http->tags |= tags;
+    http->response_last_seen = bpf_ktime_get_ns();
+}
+
+static __always_inline void https_process(ssl_sock_t *ssl_sock, void *buffer, size_t len, __u8 direction, __u64 tags) {
+    if (ssl_sock->skip & direction) {
+        https_skip_fragment(&ssl_sock->tup, tags);
+        return;
+    }
+    // data flows in this direction, so a new message may start in the other one
+    ssl_sock->skip = 0;
+
     http_transaction_t http;
     __builtin_memset(&http, 0, sizeof(http));
-    __builtin_memcpy(&http.tup, t, sizeof(conn_tuple_t));
+    __builtin_memcpy(&http.tup, &ssl_sock->tup, sizeof(conn_tuple_t));
     read_into_buffer((char *)http.request_fragment, buffer, len);
     http.owned_by_src_port = http.tup.sport;
+
+    http_packet_t packet_type = HTTP_PACKET_UNKNOWN;
+    http_method_t method = HTTP_METHOD_UNKNOWN;
+    http_parse_data((char *)http.request_fragment, &packet_type, &method);
+    if (packet_type != HTTP_PACKET_UNKNOWN) {
+        ssl_sock->skip |= direction;
+    }
+
     http_process(&http, NULL, tags);
 }
 
@@ -32,14 +58,14 @@ static __always_inline void https_finish(conn_tuple_t *t) {
     http_process(&http, &skb_info, NO_TAGS);
 }
 
-static __always_inline conn_tuple_t* tup_from_ssl_ctx(void *ssl_ctx, u64 pid_tgid) {
+static __always_inline ssl_sock_t* ssl_sock_from_ctx(void *ssl_ctx, u64 pid_tgid) {
     ssl_sock_t *ssl_sock = bpf_map_lookup_elem(&ssl_sock_by_ctx, &ssl_ctx);
     if (ssl_sock == NULL) {
         return NULL;
     }
 
     if (ssl_sock->tup.sport != 0 && ssl_sock->tup.dport != 0) {
-        return &ssl_sock->tup;
+        return ssl_sock;
     }
 
     // the code path below should be executed only once during the lifecycle of a SSL session
@@ -73,7 +99,7 @@ static __always_inline conn_tuple_t* tup_from_ssl_ctx(void *ssl_ctx, u64 pid_tgi
         flip_tuple(&ssl_sock->tup);
     }
 
-    return &ssl_sock->tup;
+    return ssl_sock;
 }
 
 static __always_inline void init_ssl_sock(void *ssl_ctx, u32 socket_fd) {
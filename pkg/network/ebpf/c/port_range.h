@@ -1,29 +1,46 @@
 #ifndef __PORT_RANGE_H
 #define __PORT_RANGE_H
 
-// TODO: Replace those by injected constants based on system configuration
-// once we have port range detection merged into the codebase.
-#define EPHEMERAL_RANGE_BEG 32768
-#define EPHEMERAL_RANGE_END 60999
+#include "defs.h"
+
+// The ephemeral port range is read from net.ipv4.ip_local_port_range by system-probe
+// and injected when the programs are loaded
+static __always_inline __u16 ephemeral_range_begin() {
+    __u64 val = 0;
+    LOAD_CONSTANT("ephemeral_range_begin", val);
+    return (__u16)val;
+}
+
+static __always_inline __u16 ephemeral_range_end() {
+    __u64 val = 0;
+    LOAD_CONSTANT("ephemeral_range_end", val);
+    return (__u16)val;
+}
 
 static __always_inline int is_ephemeral_port(u16 port) {
-    return port >= EPHEMERAL_RANGE_BEG && port <= EPHEMERAL_RANGE_END;
+    return port >= ephemeral_range_begin() && port <= ephemeral_range_end();
 }
 
 // ensure that the given tuple is in the (src: client, dst: server) format based
-// on the port range heuristic
-static __always_inline void normalize_tuple(conn_tuple_t *t) {
-    if (is_ephemeral_port(t->sport) && !is_ephemeral_port(t->dport)) {
-        return;
+// on the port range heuristic. Returns false when both ports are in the same range,
+// in which case the client can't be told apart from the server.
+static __always_inline bool normalize_tuple(conn_tuple_t *t) {
+    bool sport_ephemeral = is_ephemeral_port(t->sport);
+    bool dport_ephemeral = is_ephemeral_port(t->dport);
+    if (sport_ephemeral != dport_ephemeral) {
+        // flip the tuple if it is currently in the (server, client) format
+        if (dport_ephemeral) {
+            flip_tuple(t);
+        }
+        return true;
     }
 
-    if ((!is_ephemeral_port(t->sport) && is_ephemeral_port(t->dport)) || t->dport > t->sport) {
-        // flip the tuple if:
-        // 1) the tuple is currently in the (server, client) format;
-        // 2) unlikely: if both ports are in the same range we ensure that sport > dport to make
-        // this function return a deterministic result for a given pair of ports;
+    // unlikely: both ports are in the same range, we ensure that sport > dport to make
+    // this function return a deterministic result for a given pair of ports
+    if (t->dport > t->sport) {
         flip_tuple(t);
     }
+    return false;
 }
 
 #endif
@@ -101,9 +101,12 @@ int socket__http_filter(struct __sk_buff* skb) {
     // src_port represents the source port number *before* normalization
     // for more context please refer to http-types.h comment on `owned_by_src_port` field
     http.owned_by_src_port = http.tup.sport;
-    normalize_tuple(&http.tup);
+    bool normalized = normalize_tuple(&http.tup);
 
     read_into_buffer_skb((char *)http.request_fragment, skb, &skb_info);
+    if (!normalized) {
+        http_count_ambiguous_request((char *)http.request_fragment);
+    }
     http_process(&http, &skb_info, NO_TAGS);
     return 0;
 }
@@ -222,13 +225,16 @@ int uretprobe__SSL_read(struct pt_regs* ctx) {
     }
 
     void *ssl_ctx = args->ctx;
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         goto cleanup;
     }
 
-    u32 len = (u32)PT_REGS_RC(ctx);
-    https_process(t, args->buf, len, LIBSSL);
+    int len = (int)PT_REGS_RC(ctx);
+    if (len <= 0) {
+        goto cleanup;
+    }
+    https_process(ssl_sock, args->buf, len, HTTPS_SKIP_READ, LIBSSL);
 cleanup:
     bpf_map_delete_elem(&ssl_read_args, &pid_tgid);
     return 0;
@@ -238,14 +244,14 @@ SEC("uprobe/SSL_write")
 int uprobe__SSL_write(struct pt_regs* ctx) {
     void *ssl_ctx = (void *)PT_REGS_PARM1(ctx);
     u64 pid_tgid = bpf_get_current_pid_tgid();
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
     void *ssl_buffer = (void *)PT_REGS_PARM2(ctx);
     size_t len = (size_t)PT_REGS_PARM3(ctx);
-    https_process(t, ssl_buffer, len, LIBSSL);
+    https_process(ssl_sock, ssl_buffer, len, HTTPS_SKIP_WRITE, LIBSSL);
     return 0;
 }
 
@@ -253,12 +259,12 @@ SEC("uprobe/SSL_shutdown")
 int uprobe__SSL_shutdown(struct pt_regs* ctx) {
     void *ssl_ctx = (void *)PT_REGS_PARM1(ctx);
     u64 pid_tgid = bpf_get_current_pid_tgid();
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
-    https_finish(t);
+    https_finish(&ssl_sock->tup);
     bpf_map_delete_elem(&ssl_sock_by_ctx, &ssl_ctx);
     return 0;
 }
@@ -354,12 +360,15 @@ int uretprobe__gnutls_record_recv(struct pt_regs *ctx) {
 
     void *ssl_session = args->ctx;
     log_debug("uret/gnutls_record_recv: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         goto cleanup;
     }
 
-    https_process(t, args->buf, read_len, LIBGNUTLS);
+    if (read_len <= 0) {
+        goto cleanup;
+    }
+    https_process(ssl_sock, args->buf, read_len, HTTPS_SKIP_READ, LIBGNUTLS);
 cleanup:
     bpf_map_delete_elem(&ssl_read_args, &pid_tgid);
     return 0;
@@ -374,24 +383,24 @@ int uprobe__gnutls_record_send(struct pt_regs *ctx) {
 
     u64 pid_tgid = bpf_get_current_pid_tgid();
     log_debug("gnutls_record_send: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
-    https_process(t, data, data_size, LIBGNUTLS);
+    https_process(ssl_sock, data, data_size, HTTPS_SKIP_WRITE, LIBGNUTLS);
     return 0;
 }
 
 static __always_inline void gnutls_goodbye(void *ssl_session) {
     u64 pid_tgid = bpf_get_current_pid_tgid();
     log_debug("gnutls_goodbye: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         return;
     }
 
-    https_finish(t);
+    https_finish(&ssl_sock->tup);
     bpf_map_delete_elem(&ssl_sock_by_ctx, &ssl_session);
 }
 
@@ -2,21 +2,12 @@
 #define __SOCK_H
 
 #include "kconfig.h"
-
-/* The LOAD_CONSTANT macro is used to define a named constant that will be replaced
- * at runtime by the Go code. This replaces usage of a bpf_map for storing values, which
- * eliminates a bpf_map_lookup_elem per kprobe hit. The constants are best accessed with a
- * dedicated inlined function. See example functions offset_* below.
- */
-#define LOAD_CONSTANT(param, var) asm("%0 = " param " ll" \
-                                      : "=r"(var))
+#include "defs.h"
 
 // source include/linux/socket.h
 #define __AF_INET   2
 #define __AF_INET6 10
 
-static const __u64 ENABLED = 1;
-
 static __always_inline bool dns_stats_enabled() {
     __u64 val = 0;
     LOAD_CONSTANT("dns_stats_enabled", val);
@@ -22,6 +22,10 @@ typedef struct {
 
 typedef struct {
     __u64 registers;
+    // translations that couldn't be inserted because the conntrack map is full
+    __u64 registers_dropped;
+    // translations removed when the kernel deleted their conntrack entry
+    __u64 deletes;
 } conntrack_telemetry_t;
 
 
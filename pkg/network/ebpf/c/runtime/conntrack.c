@@ -21,7 +21,7 @@ int kprobe___nf_conntrack_hash_insert(struct pt_regs* ctx) {
     struct nf_conn *ct = (struct nf_conn*)PT_REGS_PARM1(ctx);
 
     u32 status = ct_status(ct);
-    if (!(status&IPS_CONFIRMED) || !(status&IPS_NAT_MASK)) {
+    if (!is_nat_conntrack(status)) {
         return 0;
     }
     
@@ -32,9 +32,30 @@ int kprobe___nf_conntrack_hash_insert(struct pt_regs* ctx) {
         return 0;
     }
 
-    bpf_map_update_elem(&conntrack, &orig, &reply, BPF_ANY);
-    bpf_map_update_elem(&conntrack, &reply, &orig, BPF_ANY);
-    increment_telemetry_registers_count();
+    insert_conntrack_tuples(&orig, &reply);
+
+    return 0;
+}
+
+// nf_ct_delete is called whenever the kernel removes a conntrack entry, be it because it
+// timed out, was evicted or flushed, so that translations don't outlive their connection
+SEC("kprobe/nf_ct_delete")
+int kprobe_nf_ct_delete(struct pt_regs* ctx) {
+    struct nf_conn *ct = (struct nf_conn*)PT_REGS_PARM1(ctx);
+
+    u32 status = ct_status(ct);
+    if (!is_nat_conntrack(status)) {
+        return 0;
+    }
+
+    log_debug("kprobe/nf_ct_delete: netns: %u, status: %x\n", get_netns(&ct->ct_net), status);
+
+    conntrack_tuple_t orig = {}, reply = {};
+    if (nf_conn_to_conntrack_tuples(ct, &orig, &reply) != 0) {
+        return 0;
+    }
+
+    delete_conntrack_tuples(&orig, &reply);
 
     return 0;
 }
@@ -53,7 +74,7 @@ int kprobe_ctnetlink_fill_info(struct pt_regs* ctx) {
     struct nf_conn *ct = (struct nf_conn*)PT_REGS_PARM5(ctx);
 
     u32 status = ct_status(ct);
-    if (!(status&IPS_CONFIRMED) || !(status&IPS_NAT_MASK)) {
+    if (!is_nat_conntrack(status)) {
         return 0;
     }
     
@@ -64,9 +85,7 @@ int kprobe_ctnetlink_fill_info(struct pt_regs* ctx) {
         return 0;
     }
 
-    bpf_map_update_elem(&conntrack, &orig, &reply, BPF_ANY);
-    bpf_map_update_elem(&conntrack, &reply, &orig, BPF_ANY);
-    increment_telemetry_registers_count();
+    insert_conntrack_tuples(&orig, &reply);
 
     return 0;
 }
@@ -0,0 +1,72 @@
+#ifndef __GO_TLS_TYPES_H
+#define __GO_TLS_TYPES_H
+
+#include <linux/types.h>
+
+// location_t describes where a word-sized function argument or return value lives when a uprobe fires:
+// either in a register, identified by its DWARF number, or on the stack, at an offset from the stack pointer
+typedef struct {
+    __s64 stack_offset;
+    __u64 _register;
+    __u8 in_register;
+    __u8 exists;
+} location_t;
+
+// slice_location_t describes the data pointer and the length of a []byte argument.
+// The capacity is never needed, and is often optimized out by the compiler.
+typedef struct {
+    location_t ptr;
+    location_t len;
+} slice_location_t;
+
+// goroutine_id_metadata_t describes how to find the ID of the current goroutine, which is what ties
+// the entry of crypto/tls.(*Conn).Read to its returns, since the goroutine may be rescheduled on another
+// thread in between
+typedef struct {
+    __u64 goroutine_id_offset;
+    // the g pointer is stored in a register with the register-based ABI, and in the thread local
+    // storage with the stack-based ABI on amd64
+    __s64 runtime_g_tls_addr_offset;
+    __u64 runtime_g_register;
+    __u8 runtime_g_in_register;
+} goroutine_id_metadata_t;
+
+// tls_conn_layout_t holds the offsets needed to go from a *tls.Conn to the file descriptor of its socket:
+// tls.Conn.conn (net.Conn holding a *net.TCPConn) -> net.TCPConn.conn -> net.conn.fd (*net.netFD)
+// -> net.netFD.pfd (poll.FD) -> poll.FD.Sysfd
+typedef struct {
+    __u64 tls_conn_inner_conn_offset;
+    __u64 tcp_conn_inner_conn_offset;
+    __u64 conn_fd_offset;
+    __u64 net_fd_pfd_offset;
+    __u64 fd_sysfd_offset;
+} tls_conn_layout_t;
+
+// tls_offsets_data_t is everything the Go TLS uprobes need to know about a given binary, as resolved
+// by the inspection of its symbols by system-probe
+typedef struct {
+    goroutine_id_metadata_t goroutine_id;
+    tls_conn_layout_t conn_layout;
+
+    location_t read_conn_pointer;
+    slice_location_t read_buffer;
+    location_t read_return_bytes;
+
+    location_t write_conn_pointer;
+    slice_location_t write_buffer;
+
+    location_t close_conn_pointer;
+} tls_offsets_data_t;
+
+typedef struct {
+    __u64 goroutine_id;
+    __u32 pid;
+    __u32 _pad;
+} go_tls_read_args_key_t;
+
+typedef struct {
+    void *conn_pointer;
+    void *b_data;
+} go_tls_read_args_data_t;
+
+#endif
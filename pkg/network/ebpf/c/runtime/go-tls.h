@@ -0,0 +1,138 @@
+#ifndef __GO_TLS_H
+#define __GO_TLS_H
+
+#include <linux/sched.h>
+
+#include "bpf_helpers.h"
+#include "map-defs.h"
+#include "https.h"
+#include "go-tls-types.h"
+
+/* This map holds the offsets resolved by system-probe for the Go binaries using crypto/tls, keyed by PID */
+BPF_HASH_MAP(go_tls_offsets_data, __u32, tls_offsets_data_t, 1024)
+
+/* This map passes the arguments of crypto/tls.(*Conn).Read from its entry to its return probes.
+ * It is an LRU so that the entries of the reads which never return don't fill it up, and its size
+ * is overridden by system-probe with the maximum number of tracked connections. */
+BPF_LRU_MAP(go_tls_read_args, go_tls_read_args_key_t, go_tls_read_args_data_t, 2048)
+
+#define GO_REG(n, field) case n: val = ctx->field; break;
+
+// read_register reads a register identified by its DWARF number. Only the registers used by the Go ABI
+// for the arguments and return values of the hooked functions, and for the g pointer, are supported.
+static __always_inline int read_register(struct pt_regs *ctx, __u64 regnum, __u64 *dest) {
+    __u64 val = 0;
+    switch (regnum) {
+#if defined(__x86_64__)
+    GO_REG(0, ax)
+    GO_REG(1, dx)
+    GO_REG(2, cx)
+    GO_REG(3, bx)
+    GO_REG(4, si)
+    GO_REG(5, di)
+    GO_REG(8, r8)
+    GO_REG(9, r9)
+    GO_REG(10, r10)
+    GO_REG(11, r11)
+    GO_REG(12, r12)
+    GO_REG(13, r13)
+    GO_REG(14, r14)
+    GO_REG(15, r15)
+#elif defined(__aarch64__)
+    GO_REG(0, regs[0])
+    GO_REG(1, regs[1])
+    GO_REG(2, regs[2])
+    GO_REG(3, regs[3])
+    GO_REG(4, regs[4])
+    GO_REG(5, regs[5])
+    GO_REG(6, regs[6])
+    GO_REG(7, regs[7])
+    GO_REG(8, regs[8])
+    GO_REG(9, regs[9])
+    GO_REG(10, regs[10])
+    GO_REG(11, regs[11])
+    GO_REG(12, regs[12])
+    GO_REG(13, regs[13])
+    GO_REG(14, regs[14])
+    GO_REG(15, regs[15])
+    GO_REG(28, regs[28])
+#endif
+    default:
+        return 1;
+    }
+    *dest = val;
+    return 0;
+}
+
+// read_location reads a word-sized argument or return value
+static __always_inline int read_location(struct pt_regs *ctx, location_t *loc, void *dest) {
+    if (!loc->exists) {
+        return 1;
+    }
+
+    if (loc->in_register) {
+        return read_register(ctx, loc->_register, (__u64 *)dest);
+    }
+    return bpf_probe_read_user(dest, sizeof(__u64), (void *)(PT_REGS_SP(ctx) + loc->stack_offset));
+}
+
+static __always_inline int read_goroutine_id(struct pt_regs *ctx, goroutine_id_metadata_t *m, __u64 *dest) {
+    __u64 g = 0;
+    if (m->runtime_g_in_register) {
+        if (read_register(ctx, m->runtime_g_register, &g)) {
+            return 1;
+        }
+    } else {
+#if defined(__x86_64__)
+        struct task_struct *task = (struct task_struct *)bpf_get_current_task();
+        __u64 fsbase = 0;
+        if (bpf_probe_read_kernel(&fsbase, sizeof(fsbase), &task->thread.fsbase)) {
+            return 1;
+        }
+        if (bpf_probe_read_user(&g, sizeof(g), (void *)(fsbase + m->runtime_g_tls_addr_offset))) {
+            return 1;
+        }
+#else
+        return 1;
+#endif
+    }
+
+    return bpf_probe_read_user(dest, sizeof(*dest), (void *)(g + m->goroutine_id_offset));
+}
+
+static __always_inline tls_offsets_data_t *get_offsets_data(__u64 pid_tgid) {
+    __u32 pid = pid_tgid >> 32;
+    return bpf_map_lookup_elem(&go_tls_offsets_data, &pid);
+}
+
+// conn_ssl_sock returns the ssl_sock_t of a *tls.Conn, reading the file descriptor of its socket out
+// of the Go structs the first time the connection is seen
+static __always_inline ssl_sock_t *conn_ssl_sock(tls_conn_layout_t *l, void *conn, __u64 pid_tgid) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(conn, pid_tgid);
+    if (ssl_sock != NULL) {
+        return ssl_sock;
+    }
+
+    // tls.Conn.conn is a net.Conn interface: skip its itab to get its data pointer, which is assumed
+    // to be a *net.TCPConn. This holds for the connections created by crypto/tls.Dial and by the
+    // listeners of net/http, but not for a tls.Conn wrapping another net.Conn implementation.
+    void *tcp_conn = NULL;
+    if (bpf_probe_read_user(&tcp_conn, sizeof(tcp_conn), conn + l->tls_conn_inner_conn_offset + sizeof(void *))) {
+        return NULL;
+    }
+
+    void *net_fd = NULL;
+    if (bpf_probe_read_user(&net_fd, sizeof(net_fd), tcp_conn + l->tcp_conn_inner_conn_offset + l->conn_fd_offset)) {
+        return NULL;
+    }
+
+    __s64 sysfd = 0;
+    if (bpf_probe_read_user(&sysfd, sizeof(sysfd), net_fd + l->net_fd_pfd_offset + l->fd_sysfd_offset)) {
+        return NULL;
+    }
+
+    init_ssl_sock(conn, (u32)sysfd);
+    return ssl_sock_from_ctx(conn, pid_tgid);
+}
+
+#endif
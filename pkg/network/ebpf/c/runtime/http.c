@@ -10,6 +10,7 @@
 #include "tags-types.h"
 #include "port_range.h"
 #include "https.h"
+#include "go-tls.h"
 #include "conn-tuple.h"
 
 #if LINUX_VERSION_CODE < KERNEL_VERSION(4, 5, 0)
@@ -109,9 +110,12 @@ int socket__http_filter(struct __sk_buff *skb) {
     // src_port represents the source port number *before* normalization
     // for more context please refer to http-types.h comment on `owned_by_src_port` field
     http.owned_by_src_port = http.tup.sport;
-    normalize_tuple(&http.tup);
+    bool normalized = normalize_tuple(&http.tup);
 
     read_into_buffer_skb((char *)http.request_fragment, skb, &skb_info);
+    if (!normalized) {
+        http_count_ambiguous_request((char *)http.request_fragment);
+    }
     http_process(&http, &skb_info, NO_TAGS);
     return 0;
 }
@@ -229,13 +233,16 @@ int uretprobe__SSL_read(struct pt_regs *ctx) {
     }
 
     void *ssl_ctx = args->ctx;
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         goto cleanup;
     }
 
-    u32 len = (u32)PT_REGS_RC(ctx);
-    https_process(t, args->buf, len, LIBSSL);
+    int len = (int)PT_REGS_RC(ctx);
+    if (len <= 0) {
+        goto cleanup;
+    }
+    https_process(ssl_sock, args->buf, len, HTTPS_SKIP_READ, LIBSSL);
 cleanup:
     bpf_map_delete_elem(&ssl_read_args, &pid_tgid);
     return 0;
@@ -245,14 +252,14 @@ SEC("uprobe/SSL_write")
 int uprobe__SSL_write(struct pt_regs *ctx) {
     void *ssl_ctx = (void *)PT_REGS_PARM1(ctx);
     u64 pid_tgid = bpf_get_current_pid_tgid();
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
     void *ssl_buffer = (void *)PT_REGS_PARM2(ctx);
     size_t len = (size_t)PT_REGS_PARM3(ctx);
-    https_process(t, ssl_buffer, len, LIBSSL);
+    https_process(ssl_sock, ssl_buffer, len, HTTPS_SKIP_WRITE, LIBSSL);
     return 0;
 }
 
@@ -260,12 +267,12 @@ SEC("uprobe/SSL_shutdown")
 int uprobe__SSL_shutdown(struct pt_regs *ctx) {
     void *ssl_ctx = (void *)PT_REGS_PARM1(ctx);
     u64 pid_tgid = bpf_get_current_pid_tgid();
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_ctx, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_ctx, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
-    https_finish(t);
+    https_finish(&ssl_sock->tup);
     bpf_map_delete_elem(&ssl_sock_by_ctx, &ssl_ctx);
     return 0;
 }
@@ -361,12 +368,15 @@ int uretprobe__gnutls_record_recv(struct pt_regs *ctx) {
 
     void *ssl_session = args->ctx;
     log_debug("uret/gnutls_record_recv: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         goto cleanup;
     }
 
-    https_process(t, args->buf, read_len, LIBGNUTLS);
+    if (read_len <= 0) {
+        goto cleanup;
+    }
+    https_process(ssl_sock, args->buf, read_len, HTTPS_SKIP_READ, LIBGNUTLS);
 cleanup:
     bpf_map_delete_elem(&ssl_read_args, &pid_tgid);
     return 0;
@@ -381,24 +391,24 @@ int uprobe__gnutls_record_send(struct pt_regs *ctx) {
 
     u64 pid_tgid = bpf_get_current_pid_tgid();
     log_debug("gnutls_record_send: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         return 0;
     }
 
-    https_process(t, data, data_size, LIBGNUTLS);
+    https_process(ssl_sock, data, data_size, HTTPS_SKIP_WRITE, LIBGNUTLS);
     return 0;
 }
 
 static __always_inline void gnutls_goodbye(void *ssl_session) {
     u64 pid_tgid = bpf_get_current_pid_tgid();
     log_debug("gnutls_goodbye: pid=%llu ctx=%llx\n", pid_tgid, ssl_session);
-    conn_tuple_t *t = tup_from_ssl_ctx(ssl_session, pid_tgid);
-    if (t == NULL) {
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(ssl_session, pid_tgid);
+    if (ssl_sock == NULL) {
         return;
     }
 
-    https_finish(t);
+    https_finish(&ssl_sock->tup);
     bpf_map_delete_elem(&ssl_sock_by_ctx, &ssl_session);
 }
 
@@ -418,6 +428,129 @@ int uprobe__gnutls_deinit(struct pt_regs *ctx) {
     return 0;
 }
 
+// func (c *Conn) Write(b []byte) (int, error)
+SEC("uprobe/crypto/tls.(*Conn).Write")
+int uprobe__crypto_tls_Conn_Write(struct pt_regs *ctx) {
+    u64 pid_tgid = bpf_get_current_pid_tgid();
+    tls_offsets_data_t *od = get_offsets_data(pid_tgid);
+    if (od == NULL) {
+        return 0;
+    }
+
+    void *conn_pointer = NULL;
+    if (read_location(ctx, &od->write_conn_pointer, &conn_pointer)) {
+        return 0;
+    }
+
+    void *b_data = NULL;
+    if (read_location(ctx, &od->write_buffer.ptr, &b_data)) {
+        return 0;
+    }
+    u64 b_len = 0;
+    if (read_location(ctx, &od->write_buffer.len, &b_len)) {
+        return 0;
+    }
+
+    ssl_sock_t *ssl_sock = conn_ssl_sock(&od->conn_layout, conn_pointer, pid_tgid);
+    if (ssl_sock == NULL) {
+        return 0;
+    }
+
+    https_process(ssl_sock, b_data, b_len, HTTPS_SKIP_WRITE, GO);
+    return 0;
+}
+
+// func (c *Conn) Read(b []byte) (int, error)
+SEC("uprobe/crypto/tls.(*Conn).Read")
+int uprobe__crypto_tls_Conn_Read(struct pt_regs *ctx) {
+    u64 pid_tgid = bpf_get_current_pid_tgid();
+    tls_offsets_data_t *od = get_offsets_data(pid_tgid);
+    if (od == NULL) {
+        return 0;
+    }
+
+    go_tls_read_args_key_t key = { 0 };
+    key.pid = pid_tgid >> 32;
+    if (read_goroutine_id(ctx, &od->goroutine_id, &key.goroutine_id)) {
+        return 0;
+    }
+
+    go_tls_read_args_data_t args = { 0 };
+    if (read_location(ctx, &od->read_conn_pointer, &args.conn_pointer)) {
+        return 0;
+    }
+    if (read_location(ctx, &od->read_buffer.ptr, &args.b_data)) {
+        return 0;
+    }
+
+    bpf_map_update_elem(&go_tls_read_args, &key, &args, BPF_ANY);
+    return 0;
+}
+
+// Go doesn't play well with uretprobes, as the runtime moves stacks around, so this probe is attached
+// to each return instruction of crypto/tls.(*Conn).Read instead
+SEC("uprobe/crypto/tls.(*Conn).Read/return")
+int uprobe__crypto_tls_Conn_Read__return(struct pt_regs *ctx) {
+    u64 pid_tgid = bpf_get_current_pid_tgid();
+    tls_offsets_data_t *od = get_offsets_data(pid_tgid);
+    if (od == NULL) {
+        return 0;
+    }
+
+    go_tls_read_args_key_t key = { 0 };
+    key.pid = pid_tgid >> 32;
+    if (read_goroutine_id(ctx, &od->goroutine_id, &key.goroutine_id)) {
+        return 0;
+    }
+
+    go_tls_read_args_data_t *args = bpf_map_lookup_elem(&go_tls_read_args, &key);
+    if (args == NULL) {
+        return 0;
+    }
+
+    void *conn_pointer = args->conn_pointer;
+    void *b_data = args->b_data;
+    bpf_map_delete_elem(&go_tls_read_args, &key);
+
+    s64 bytes_read = 0;
+    if (read_location(ctx, &od->read_return_bytes, &bytes_read) || bytes_read <= 0) {
+        return 0;
+    }
+
+    ssl_sock_t *ssl_sock = conn_ssl_sock(&od->conn_layout, conn_pointer, pid_tgid);
+    if (ssl_sock == NULL) {
+        return 0;
+    }
+
+    https_process(ssl_sock, b_data, bytes_read, HTTPS_SKIP_READ, GO);
+    return 0;
+}
+
+// func (c *Conn) Close() error
+SEC("uprobe/crypto/tls.(*Conn).Close")
+int uprobe__crypto_tls_Conn_Close(struct pt_regs *ctx) {
+    u64 pid_tgid = bpf_get_current_pid_tgid();
+    tls_offsets_data_t *od = get_offsets_data(pid_tgid);
+    if (od == NULL) {
+        return 0;
+    }
+
+    void *conn_pointer = NULL;
+    if (read_location(ctx, &od->close_conn_pointer, &conn_pointer)) {
+        return 0;
+    }
+
+    // a connection that was never read from nor written to has nothing to flush
+    ssl_sock_t *ssl_sock = ssl_sock_from_ctx(conn_pointer, pid_tgid);
+    if (ssl_sock == NULL) {
+        return 0;
+    }
+
+    https_finish(&ssl_sock->tup);
+    bpf_map_delete_elem(&ssl_sock_by_ctx, &conn_pointer);
+    return 0;
+}
+
 static __always_inline int fill_path_safe(lib_path_t *path, char *path_argument) {
 #pragma unroll
     for (int i = 0; i < LIB_PATH_MAX_SIZE; i++) {
@@ -6,6 +6,7 @@ enum static_tags {
     NO_TAGS = 0,
     LIBGNUTLS = (1<<0),
     LIBSSL = (1<<1),
+    GO = (1<<2),
 };
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef __TRACER_CHANGES_H
+#define __TRACER_CHANGES_H
+
+#include "tracer.h"
+#include "tracer-maps.h"
+#include "tracer-telemetry.h"
+
+static __always_inline __u32 get_read_generation() {
+    __u32 key = 0;
+    __u32 *generation = bpf_map_lookup_elem(&conn_read_generation, &key);
+    if (generation == NULL) {
+        return 0;
+    }
+    return *generation;
+}
+
+// log_conn_change adds a connection to the change set of the given read generation, so that
+// system-probe reads it the next time it polls the connections
+static __always_inline void log_conn_change(conn_tuple_t *t, __u32 generation) {
+    if (generation == 0) {
+        return;
+    }
+
+    __u8 changed = 1;
+    int ret = 0;
+    if (generation & 1) {
+        ret = bpf_map_update_elem(&conn_changes_odd, t, &changed, BPF_ANY);
+    } else {
+        ret = bpf_map_update_elem(&conn_changes_even, t, &changed, BPF_ANY);
+    }
+    if (ret == -E2BIG) {
+        // system-probe falls back to a full read of the connections
+        increment_telemetry_count(conn_changes_max_entries_hit);
+    }
+}
+
+// mark_conn_changed logs a connection the first time it is updated during the current read generation
+static __always_inline void mark_conn_changed(conn_tuple_t *t, conn_stats_ts_t *stats) {
+    __u32 generation = get_read_generation();
+    if (generation == 0 || stats->read_generation == generation) {
+        return;
+    }
+    stats->read_generation = generation;
+    log_conn_change(t, generation);
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "tracer-maps.h"
 #include "tracer-telemetry.h"
+#include "tracer-changes.h"
 #include "tcp_states.h"
 
 #include "bpf_helpers.h"
@@ -42,6 +43,9 @@ static __always_inline void cleanup_conn(conn_tuple_t *tup) {
     }
     conn.conn_stats.timestamp = bpf_ktime_get_ns();
 
+    // let system-probe drop the connection from its cache
+    log_conn_change(tup, get_read_generation());
+
     // Batch TCP closed connections before generating a perf event
     batch_t *batch_ptr = bpf_map_lookup_elem(&conn_close_batch, &cpu);
     if (batch_ptr == NULL) {
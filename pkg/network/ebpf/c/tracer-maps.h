@@ -69,6 +69,20 @@ BPF_HASH_MAP(udp_port_bindings, port_binding_t, __u32, 0)
  */
 BPF_HASH_MAP(pending_bind, __u64, bind_syscall_args_t, 8192)
     
+/* This map holds the read generation of the connection maps, only key 0 is used.
+ * It is incremented by system-probe each time it reads the connections that changed since its
+ * previous read. 0 means that system-probe doesn't track the changes.
+ */
+BPF_ARRAY_MAP(conn_read_generation, __u32, 1)
+
+/* These maps are the sets of the connections that changed during the even and odd read generations.
+ * The probes fill the set of the current generation, while system-probe drains the set of the
+ * previous one after incrementing the generation.
+ * The keys are conn_tuple_t, the values are unused.
+ */
+BPF_HASH_MAP(conn_changes_even, conn_tuple_t, __u8, 0)
+BPF_HASH_MAP(conn_changes_odd, conn_tuple_t, __u8, 0)
+
 /* This map is used for telemetry in kernelspace
  * only key 0 is used
  * value is a telemetry object
@@ -4,6 +4,7 @@
 #include "tracer.h"
 #include "tracer-maps.h"
 #include "tracer-telemetry.h"
+#include "tracer-changes.h"
 
 static int read_conn_tuple(conn_tuple_t *t, struct sock *skp, u64 pid_tgid, metadata_mask_t type);
 
@@ -91,6 +92,8 @@ static __always_inline void update_conn_stats(conn_tuple_t *t, size_t sent_bytes
         }
         val->direction = (port_count != NULL && *port_count > 0) ? CONN_DIRECTION_INCOMING : CONN_DIRECTION_OUTGOING;
     }
+
+    mark_conn_changed(t, val);
 }
 
 static __always_inline void update_tcp_stats(conn_tuple_t *t, tcp_stats_t stats) {
@@ -122,6 +125,11 @@ static __always_inline void update_tcp_stats(conn_tuple_t *t, tcp_stats_t stats)
     if (stats.state_transitions > 0) {
         val->state_transitions |= stats.state_transitions;
     }
+
+    // RTT updates come along with an update of the connection stats, which logs the connection
+    if (stats.retransmits > 0 || stats.state_transitions > 0) {
+        log_conn_change(t, get_read_generation());
+    }
 }
 
 static __always_inline int handle_message(conn_tuple_t *t, size_t sent_bytes, size_t recv_bytes, conn_direction_t dir,
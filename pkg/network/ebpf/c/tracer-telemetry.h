@@ -13,6 +13,7 @@ enum telemetry_counter
     udp_send_processed,
     udp_send_missed,
     conn_stats_max_entries_hit,
+    conn_changes_max_entries_hit,
 };
 
 static __always_inline void increment_telemetry_count(enum telemetry_counter counter_name) {
@@ -39,6 +40,9 @@ static __always_inline void increment_telemetry_count(enum telemetry_counter cou
     case conn_stats_max_entries_hit:
         __sync_fetch_and_add(&val->conn_stats_max_entries_hit, 1);
         break;
+    case conn_changes_max_entries_hit:
+        __sync_fetch_and_add(&val->conn_changes_max_entries_hit, 1);
+        break;
     }
 }
 
@@ -29,6 +29,8 @@ typedef struct {
     __u64 timestamp;
     __u32 flags;
     __u32 cookie;
+    // read generation during which the connection was last logged in the change sets
+    __u32 read_generation;
     __u8 direction;
     __u64 sent_packets;
     __u64 recv_packets;
@@ -129,6 +131,7 @@ typedef struct {
     __u64 udp_sends_processed;
     __u64 udp_sends_missed;
     __u64 conn_stats_max_entries_hit;
+    __u64 conn_changes_max_entries_hit;
 } telemetry_t;
 
 typedef struct {
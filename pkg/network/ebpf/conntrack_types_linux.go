@@ -16,5 +16,7 @@ type ConntrackTuple struct {
 }
 
 type ConntrackTelemetry struct {
-	Registers uint64
+	Registers         uint64
+	Registers_dropped uint64
+	Deletes           uint64
 }
@@ -22,14 +22,15 @@ type TCPStats struct {
 	Pad_cgo_0         [2]byte
 }
 type ConnStats struct {
-	Sent_bytes   uint64
-	Recv_bytes   uint64
-	Timestamp    uint64
-	Flags        uint32
-	Cookie       uint32
-	Direction    uint8
-	Sent_packets uint64
-	Recv_packets uint64
+	Sent_bytes      uint64
+	Recv_bytes      uint64
+	Timestamp       uint64
+	Flags           uint32
+	Cookie          uint32
+	Read_generation uint32
+	Direction       uint8
+	Sent_packets    uint64
+	Recv_packets    uint64
 }
 type Conn struct {
 	Tup        ConnTuple
@@ -45,12 +46,13 @@ type Batch struct {
 	Id  uint64
 }
 type Telemetry struct {
-	Tcp_sent_miscounts         uint64
-	Missed_tcp_close           uint64
-	Missed_udp_close           uint64
-	Udp_sends_processed        uint64
-	Udp_sends_missed           uint64
-	Conn_stats_max_entries_hit uint64
+	Tcp_sent_miscounts           uint64
+	Missed_tcp_close             uint64
+	Missed_udp_close             uint64
+	Udp_sends_processed          uint64
+	Udp_sends_missed             uint64
+	Conn_stats_max_entries_hit   uint64
+	Conn_changes_max_entries_hit uint64
 }
 type PortBinding struct {
 	Netns     uint32
@@ -94,11 +96,13 @@ type ConnTag = uint64
 const (
 	GnuTLS  ConnTag = 0x1
 	OpenSSL ConnTag = 0x2
+	Go      ConnTag = 0x4
 )
 
 var (
 	StaticTags = map[ConnTag]string{
 		GnuTLS:  "tls.library:gnutls",
 		OpenSSL: "tls.library:openssl",
+		Go:      "tls.library:go",
 	}
 )
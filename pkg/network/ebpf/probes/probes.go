@@ -113,6 +113,9 @@ const (
 	// ConntrackHashInsert is the probe for new conntrack entries
 	ConntrackHashInsert ProbeName = "kprobe/__nf_conntrack_hash_insert"
 
+	// ConntrackDelete is the probe for removed conntrack entries
+	ConntrackDelete ProbeName = "kprobe/nf_ct_delete"
+
 	// ConntrackFillInfo is the probe for for dumping existing conntrack entries
 	ConntrackFillInfo ProbeName = "kprobe/ctnetlink_fill_info"
 
@@ -141,6 +144,9 @@ const (
 	PortBindingsMap       BPFMapName = "port_bindings"
 	UdpPortBindingsMap    BPFMapName = "udp_port_bindings"
 	TelemetryMap          BPFMapName = "telemetry"
+	ConnReadGenerationMap BPFMapName = "conn_read_generation"
+	ConnChangesEvenMap    BPFMapName = "conn_changes_even"
+	ConnChangesOddMap     BPFMapName = "conn_changes_odd"
 	ConnCloseBatchMap     BPFMapName = "conn_close_batch"
 	ConntrackMap          BPFMapName = "conntrack"
 	ConntrackTelemetryMap BPFMapName = "conntrack_telemetry"
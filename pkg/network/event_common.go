@@ -332,6 +332,86 @@ func (c ConnectionStats) ByteKeyNAT(buf []byte) []byte {
 	return generateConnectionKey(c, buf, true)
 }
 
+// ConnectionKey is a fixed-size comparable key uniquely identifying a connection. It follows the
+// layout of the conn_tuple_t struct of the eBPF programs and holds the same fields as `ByteKey`,
+// so that it can be used as a map key without allocating.
+type ConnectionKey struct {
+	SrcIPHigh uint64
+	SrcIPLow  uint64
+	DstIPHigh uint64
+	DstIPLow  uint64
+	Pid       uint32
+	SrcPort   uint16
+	DstPort   uint16
+	// Family (4 bits) + Type (4 bits)
+	Metadata uint32
+}
+
+// Key returns the fixed-size key of this connection
+func (c ConnectionStats) Key() ConnectionKey {
+	return newConnectionKey(&c, c.Source, c.SPort, c.Dest, c.DPort)
+}
+
+// KeyNAT returns the fixed-size key of this connection, built with the translated addresses.
+// It identifies the same connections as `ByteKeyNAT`.
+func (c ConnectionStats) KeyNAT() ConnectionKey {
+	laddr, sport := GetNATLocalAddress(c)
+	raddr, dport := GetNATRemoteAddress(c)
+	return newConnectionKey(&c, laddr, sport, raddr, dport)
+}
+
+func newConnectionKey(c *ConnectionStats, laddr util.Address, sport uint16, raddr util.Address, dport uint16) ConnectionKey {
+	k := ConnectionKey{
+		Pid:      c.Pid,
+		SrcPort:  sport,
+		DstPort:  dport,
+		Metadata: uint32(uint8(c.Family)<<4 | uint8(c.Type)),
+	}
+	var srcV6, dstV6 bool
+	k.SrcIPLow, k.SrcIPHigh, srcV6 = addressToLowHigh(laddr)
+	k.DstIPLow, k.DstIPHigh, dstV6 = addressToLowHigh(raddr)
+	// the address lengths are part of the byte key
+	if srcV6 {
+		k.Metadata |= connectionKeySrcV6
+	}
+	if dstV6 {
+		k.Metadata |= connectionKeyDstV6
+	}
+	return k
+}
+
+const (
+	connectionKeySrcV6 = 1 << 8
+	connectionKeyDstV6 = 1 << 9
+)
+
+// addressToLowHigh mirrors `util.ToLowHigh`, but like `util.Address.WriteTo` it also accepts
+// the zero address, which is written as a 16 bytes address
+func addressToLowHigh(a util.Address) (l, h uint64, v6 bool) {
+	if a.Is4() {
+		b := a.As4()
+		return uint64(binary.LittleEndian.Uint32(b[:])), 0, false
+	}
+	b := a.As16()
+	return binary.LittleEndian.Uint64(b[8:]), binary.LittleEndian.Uint64(b[:8]), true
+}
+
+// String returns a human readable key (used for debugging purposes)
+func (k ConnectionKey) String() string {
+	toAddress := func(l, h uint64, v6 bool) util.Address {
+		if v6 {
+			return util.V6Address(l, h)
+		}
+		return util.V4Address(uint32(l))
+	}
+
+	return fmt.Sprintf(keyFmt, k.Pid,
+		toAddress(k.SrcIPLow, k.SrcIPHigh, k.Metadata&connectionKeySrcV6 != 0), k.SrcPort,
+		toAddress(k.DstIPLow, k.DstIPHigh, k.Metadata&connectionKeyDstV6 != 0), k.DstPort,
+		(k.Metadata>>4)&0xf, k.Metadata&0xf,
+	)
+}
+
 // IsShortLived returns true when a connection went through its whole lifecycle
 // between two connection checks
 func (c ConnectionStats) IsShortLived() bool {
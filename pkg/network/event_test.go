@@ -120,6 +120,33 @@ func TestConnStatsByteKey(t *testing.T) {
 		keyA = string(test.a.ByteKey(buf))
 		keyB = string(test.b.ByteKey(buf))
 		assert.NotEqual(t, keyA, keyB)
+		assert.NotEqual(t, test.a.Key(), test.b.Key())
+	}
+}
+
+func TestConnectionKeyString(t *testing.T) {
+	for _, c := range []ConnectionStats{
+		testConn,
+		{
+			Pid:    345,
+			Type:   1,
+			Family: AFINET6,
+			Source: util.AddressFromNetIP(net.ParseIP("::1")),
+			Dest:   util.AddressFromNetIP(net.ParseIP("2001:db8::2:1")),
+			SPort:  4444,
+			DPort:  8888,
+		},
+		{
+			Pid:    32065,
+			Family: AFINET,
+			Source: util.AddressFromString("172.21.148.124"),
+			Dest:   util.AddressFromString("130.211.21.187"),
+			SPort:  52012,
+			DPort:  443,
+		},
+	} {
+		buf := make([]byte, ConnectionByteKeyMaxLen)
+		assert.Equal(t, BeautifyKey(string(c.ByteKey(buf))), c.Key().String())
 	}
 }
 func TestByteKeyNAT(t *testing.T) {
@@ -212,6 +239,7 @@ func TestByteKeyNAT(t *testing.T) {
 		assert.Equalf(t, test.shouldMatch, actual,
 			"a: %s\nb:%s\nshouldMatch: %v\ngot: %v", test.a, test.b, test.shouldMatch, actual,
 		)
+		assert.Equal(t, actual, test.a.KeyNAT() == test.b.KeyNAT())
 	}
 }
 
@@ -256,3 +284,15 @@ func BenchmarkByteKey(b *testing.B) {
 	}
 	runtime.KeepAlive(buf)
 }
+
+func BenchmarkConnectionKey(b *testing.B) {
+	addrA := util.AddressFromString("127.0.0.1")
+	addrB := util.AddressFromString("127.0.0.2")
+	c := ConnectionStats{Pid: 1, Dest: addrB, Family: 0, Type: 1, Source: addrA}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		_ = c.Key()
+	}
+}
@@ -21,6 +21,13 @@ func getRuntimeCompiledHTTP(config *config.Config) (runtime.CompiledOutput, erro
 	return runtime.Http.Compile(&config.Config, getCFlags(config), statsd.Client)
 }
 
+// PrecompileRuntime starts compiling the runtime version of the HTTP program in the background, if it is going to be used
+func PrecompileRuntime(config *config.Config) {
+	if config.EnableHTTPMonitoring && enableRuntimeCompilation(config) {
+		runtime.Http.Precompile(&config.Config, getCFlags(config))
+	}
+}
+
 func getCFlags(config *config.Config) []string {
 	var cflags []string
 
@@ -0,0 +1,571 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package http
+
+import (
+	"debug/elf"
+	"fmt"
+	"path/filepath"
+	"runtime"
+	"strconv"
+	"sync"
+	"time"
+	"unsafe"
+
+	manager "github.com/DataDog/ebpf-manager"
+	"github.com/cilium/ebpf"
+	"github.com/go-delve/delve/pkg/goversion"
+	"go.uber.org/atomic"
+	"golang.org/x/sys/unix"
+
+	"github.com/DataDog/datadog-agent/pkg/network/config"
+	"github.com/DataDog/datadog-agent/pkg/network/go/bininspect"
+	"github.com/DataDog/datadog-agent/pkg/network/go/goid"
+	"github.com/DataDog/datadog-agent/pkg/network/http/gotls/lookup"
+	"github.com/DataDog/datadog-agent/pkg/process/util"
+	"github.com/DataDog/datadog-agent/pkg/util/log"
+)
+
+const (
+	goTLSOffsetsDataMap = "go_tls_offsets_data"
+	goTLSReadArgsMap    = "go_tls_read_args"
+
+	// goTLSScanInterval controls the frequency at which the running processes are scanned for new Go binaries.
+	// The processes which exit before the next scan are never monitored.
+	goTLSScanInterval = 5 * time.Second
+
+	goTLSWriteFunc = "crypto/tls.(*Conn).Write"
+	goTLSReadFunc  = "crypto/tls.(*Conn).Read"
+	goTLSCloseFunc = "crypto/tls.(*Conn).Close"
+
+	// DWARF numbers of the registers holding the current goroutine (g)
+	amd64GRegister = 14
+	arm64GRegister = 28
+	// with the stack-based ABI on amd64, g is stored in the thread local storage, right below the thread pointer
+	amd64GTLSOffset = -8
+
+	goPointerSize = 8
+	goSliceSize   = 3 * goPointerSize
+)
+
+var (
+	goTLSWriteProbe      = ebpfSectionFunction{section: "uprobe/" + goTLSWriteFunc, function: "uprobe__crypto_tls_Conn_Write"}
+	goTLSReadProbe       = ebpfSectionFunction{section: "uprobe/" + goTLSReadFunc, function: "uprobe__crypto_tls_Conn_Read"}
+	goTLSReadReturnProbe = ebpfSectionFunction{section: "uprobe/" + goTLSReadFunc + "/return", function: "uprobe__crypto_tls_Conn_Read__return"}
+	goTLSCloseProbe      = ebpfSectionFunction{section: "uprobe/" + goTLSCloseFunc, function: "uprobe__crypto_tls_Conn_Close"}
+)
+
+// binaryID identifies a binary by its device and inode, so that a binary run by several processes is only inspected once
+type binaryID struct {
+	dev, ino uint64
+}
+
+// goTLSHook is an uprobe to attach at a given offset of a binary
+type goTLSHook struct {
+	ebpfSectionFunction
+	offset uint64
+}
+
+type goTLSBinary struct {
+	// offsets is nil when the binary doesn't use crypto/tls or isn't supported
+	offsets *tlsOffsetsData
+	probes  []manager.ProbeIdentificationPair
+	// processes is the number of running processes of the binary, whose uprobes are detached once it drops to zero
+	processes int
+}
+
+// goTLSProgram monitors the HTTPS traffic of the Go binaries using crypto/tls. These binaries are usually
+// statically linked, so they are discovered by scanning the running processes rather than through the
+// shared libraries they open.
+type goTLSProgram struct {
+	cfg            *config.Config
+	manager        *manager.Manager
+	offsetsDataMap *ebpf.Map
+
+	// offsetsInsertFailures is the number of monitored processes whose offsets couldn't be stored,
+	// usually because go_tls_offsets_data is full
+	offsetsInsertFailures *atomic.Int64
+
+	binaries  map[binaryID]*goTLSBinary
+	processes map[uint32]binaryID
+
+	done chan struct{}
+	wg   sync.WaitGroup
+}
+
+var _ subprogram = &goTLSProgram{}
+
+func newGoTLSProgram(c *config.Config) *goTLSProgram {
+	if !c.EnableHTTPSMonitoring || !c.EnableGoTLSSupport || !httpsSupported() {
+		return nil
+	}
+
+	return &goTLSProgram{
+		cfg:                   c,
+		binaries:              make(map[binaryID]*goTLSBinary),
+		processes:             make(map[uint32]binaryID),
+		offsetsInsertFailures: atomic.NewInt64(0),
+		done:                  make(chan struct{}),
+	}
+}
+
+func (p *goTLSProgram) ConfigureManager(m *manager.Manager) {
+	if p == nil {
+		return
+	}
+
+	p.manager = m
+	m.Maps = append(m.Maps,
+		&manager.Map{Name: goTLSOffsetsDataMap},
+		&manager.Map{Name: goTLSReadArgsMap},
+	)
+}
+
+func (p *goTLSProgram) ConfigureOptions(options *manager.Options) {
+	if p == nil {
+		return
+	}
+
+	// the reads which never return, such as the ones of a process killed while blocked in a read, leave
+	// their arguments behind: they are evicted by the LRU rather than looked up when the process exits
+	options.MapSpecEditors[goTLSReadArgsMap] = manager.MapSpecEditor{
+		Type:       ebpf.LRUHash,
+		MaxEntries: uint32(p.cfg.MaxTrackedConnections),
+		EditorFlag: manager.EditMaxEntries,
+	}
+}
+
+// GetStats returns the telemetry of the Go TLS monitoring
+func (p *goTLSProgram) GetStats() map[string]interface{} {
+	if p == nil {
+		return map[string]interface{}{}
+	}
+
+	return map[string]interface{}{
+		"offsets_insert_failures": p.offsetsInsertFailures.Load(),
+	}
+}
+
+func (p *goTLSProgram) Start() {
+	if p == nil {
+		return
+	}
+
+	var err error
+	p.offsetsDataMap, _, err = p.manager.GetMap(goTLSOffsetsDataMap)
+	if err != nil {
+		log.Errorf("could not get %s map, Go TLS monitoring disabled: %s", goTLSOffsetsDataMap, err)
+		return
+	}
+
+	p.wg.Add(1)
+	go func() {
+		defer p.wg.Done()
+
+		ticker := time.NewTicker(goTLSScanInterval)
+		defer ticker.Stop()
+
+		p.scan()
+		for {
+			select {
+			case <-p.done:
+				return
+			case <-ticker.C:
+				p.scan()
+			}
+		}
+	}()
+}
+
+func (p *goTLSProgram) Stop() {
+	if p == nil {
+		return
+	}
+
+	close(p.done)
+	p.wg.Wait()
+}
+
+// scan registers the processes started since the last scan and unregisters the ones that exited
+func (p *goTLSProgram) scan() {
+	thisPID, _ := util.GetRootNSPID()
+	alive := make(map[uint32]struct{}, len(p.processes))
+	_ = util.WithAllProcs(p.cfg.ProcRoot, func(pid int) error {
+		if pid == thisPID {
+			return nil
+		}
+		alive[uint32(pid)] = struct{}{}
+		p.registerProcess(uint32(pid))
+		return nil
+	})
+
+	for pid := range p.processes {
+		if _, ok := alive[pid]; !ok {
+			p.unregisterProcess(pid)
+		}
+	}
+}
+
+func (p *goTLSProgram) registerProcess(pid uint32) {
+	exePath := filepath.Join(p.cfg.ProcRoot, strconv.Itoa(int(pid)), "exe")
+	var stat unix.Stat_t
+	if err := unix.Stat(exePath, &stat); err != nil {
+		// kernel threads have no executable
+		return
+	}
+
+	id := binaryID{dev: uint64(stat.Dev), ino: stat.Ino}
+	if known, ok := p.processes[pid]; ok {
+		if known == id {
+			return
+		}
+		// the process executed another binary
+		p.unregisterProcess(pid)
+	}
+
+	bin, ok := p.binaries[id]
+	if !ok {
+		bin = p.registerBinary(id, exePath)
+		p.binaries[id] = bin
+	}
+	bin.processes++
+	p.processes[pid] = id
+
+	if bin.offsets == nil {
+		return
+	}
+	if err := p.offsetsDataMap.Put(unsafe.Pointer(&pid), unsafe.Pointer(bin.offsets)); err != nil {
+		p.offsetsInsertFailures.Inc()
+		log.Warnf("could not register Go TLS offsets of pid %d: %s", pid, err)
+	}
+}
+
+func (p *goTLSProgram) unregisterProcess(pid uint32) {
+	id, ok := p.processes[pid]
+	if !ok {
+		return
+	}
+	delete(p.processes, pid)
+
+	bin := p.binaries[id]
+	if bin.offsets != nil {
+		_ = p.offsetsDataMap.Delete(unsafe.Pointer(&pid))
+	}
+
+	bin.processes--
+	if bin.processes > 0 {
+		return
+	}
+	p.detach(bin.probes)
+	delete(p.binaries, id)
+}
+
+// registerBinary inspects a binary and attaches the uprobes to it if it uses crypto/tls. The result is
+// kept for as long as a process runs the binary, including when the binary isn't monitored, so that
+// it isn't inspected again.
+func (p *goTLSProgram) registerBinary(id binaryID, exePath string) *goTLSBinary {
+	bin := &goTLSBinary{}
+
+	inspection, err := inspectGoTLSBinary(exePath)
+	if err != nil {
+		log.Tracef("not monitoring Go TLS traffic of %s: %s", exePath, err)
+		return bin
+	}
+
+	uid := getUID(fmt.Sprintf("%d:%d", id.dev, id.ino))
+	probes, err := p.attach(exePath, uid, inspection.hooks)
+	if err != nil {
+		log.Warnf("could not attach Go TLS uprobes to %s: %s", exePath, err)
+		return bin
+	}
+
+	log.Debugf("monitoring Go TLS traffic of %s", exePath)
+	bin.offsets = &inspection.offsets
+	bin.probes = probes
+	return bin
+}
+
+func (p *goTLSProgram) attach(exePath string, uid string, hooks []goTLSHook) ([]manager.ProbeIdentificationPair, error) {
+	attached := make([]manager.ProbeIdentificationPair, 0, len(hooks))
+	for i, hook := range hooks {
+		id := manager.ProbeIdentificationPair{
+			EBPFSection:  hook.section,
+			EBPFFuncName: hook.function,
+			UID:          uid + "_" + strconv.Itoa(i),
+		}
+		err := p.manager.AddHook("", &manager.Probe{
+			ProbeIdentificationPair: id,
+			BinaryPath:              exePath,
+			UprobeOffset:            hook.offset,
+		})
+		if err != nil {
+			p.detach(attached)
+			return nil, fmt.Errorf("%s at offset %#x: %w", hook.section, hook.offset, err)
+		}
+		attached = append(attached, id)
+	}
+	return attached, nil
+}
+
+func (p *goTLSProgram) detach(probes []manager.ProbeIdentificationPair) {
+	for _, id := range probes {
+		probe, found := p.manager.GetProbe(id)
+		if !found {
+			continue
+		}
+
+		program := probe.Program()
+		if err := p.manager.DetachHook(id); err != nil {
+			log.Debugf("detachhook %s/%s/%s : %s", id.EBPFSection, id.EBPFFuncName, id.UID, err)
+		}
+		if program != nil {
+			program.Close()
+		}
+	}
+}
+
+type goTLSInspection struct {
+	offsets tlsOffsetsData
+	hooks   []goTLSHook
+}
+
+// inspectGoTLSBinary resolves the offsets of the crypto/tls functions in a Go binary, and the locations of
+// their arguments for the ABI it was built with
+func inspectGoTLSBinary(path string) (*goTLSInspection, error) {
+	f, err := elf.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	arch, err := bininspect.GetArchitecture(f)
+	if err != nil {
+		return nil, err
+	}
+	if string(arch) != runtime.GOARCH {
+		return nil, fmt.Errorf("binary built for %s", arch)
+	}
+
+	version, err := bininspect.FindGoVersion(f)
+	if err != nil {
+		return nil, err
+	}
+	if !version.AfterOrEqual(lookup.MinGoVersion) {
+		return nil, fmt.Errorf("unsupported go%d.%d.%d", version.Major, version.Minor, version.Rev)
+	}
+
+	abi, err := bininspect.FindABI(version, arch)
+	if err != nil {
+		return nil, err
+	}
+
+	offsets, err := goTLSOffsets(version, arch, abi)
+	if err != nil {
+		return nil, err
+	}
+
+	symbols, err := bininspect.GetAllSymbolsByName(f, path)
+	if err != nil {
+		return nil, err
+	}
+
+	inspection := &goTLSInspection{offsets: offsets}
+	for _, fn := range []struct {
+		name    string
+		probe   ebpfSectionFunction
+		returns bool
+	}{
+		{goTLSWriteFunc, goTLSWriteProbe, false},
+		{goTLSReadFunc, goTLSReadProbe, true},
+		{goTLSCloseFunc, goTLSCloseProbe, false},
+	} {
+		sym, ok := symbols[fn.name]
+		if !ok {
+			return nil, fmt.Errorf("symbol %s not found", fn.name)
+		}
+
+		offset, err := symbolFileOffset(f, sym)
+		if err != nil {
+			return nil, err
+		}
+		inspection.hooks = append(inspection.hooks, goTLSHook{fn.probe, offset})
+
+		if !fn.returns {
+			continue
+		}
+		// uretprobes crash Go programs, since the runtime moves goroutine stacks around,
+		// so the return of the function is hooked at each of its return instructions instead
+		returns, err := bininspect.FindReturnLocations(f, sym, offset)
+		if err != nil {
+			return nil, fmt.Errorf("could not find the returns of %s: %w", fn.name, err)
+		}
+		for _, ret := range returns {
+			inspection.hooks = append(inspection.hooks, goTLSHook{goTLSReadReturnProbe, ret})
+		}
+	}
+
+	return inspection, nil
+}
+
+// symbolFileOffset converts the virtual address of a symbol to its offset in the binary, which is what
+// uprobes are attached to
+func symbolFileOffset(f *elf.File, sym elf.Symbol) (uint64, error) {
+	for _, prog := range f.Progs {
+		if prog.Type != elf.PT_LOAD || prog.Flags&elf.PF_X == 0 {
+			continue
+		}
+		if sym.Value >= prog.Vaddr && sym.Value < prog.Vaddr+prog.Memsz {
+			return sym.Value - prog.Vaddr + prog.Off, nil
+		}
+	}
+	return 0, fmt.Errorf("symbol %s is not in an executable segment", sym.Name)
+}
+
+// goTLSOffsets builds the offsets data of the eBPF programs from the lookup tables generated for each
+// supported Go version and architecture
+func goTLSOffsets(version goversion.GoVersion, arch bininspect.GoArch, abi bininspect.GoABI) (tlsOffsetsData, error) {
+	var data tlsOffsetsData
+	goarch := string(arch)
+
+	goroutineID, err := goroutineIDLocation(version, arch, abi)
+	if err != nil {
+		return data, err
+	}
+	data.Goroutine_id = goroutineID
+
+	// The socket of a tls.Conn is found by assuming that its net.Conn is a *net.TCPConn, which is the case
+	// of the connections created by crypto/tls and net/http. The monitored traffic of a tls.Conn wrapping
+	// another net.Conn implementation is attributed to the socket found at these offsets, if any.
+	for _, field := range []struct {
+		offset *uint64
+		lookup func(goversion.GoVersion, string) (uint64, error)
+	}{
+		{&data.Conn_layout.Tls_conn_inner_conn_offset, lookup.GetTLSConnInnerConnOffset},
+		{&data.Conn_layout.Tcp_conn_inner_conn_offset, lookup.GetTCPConnInnerConnOffset},
+		{&data.Conn_layout.Conn_fd_offset, lookup.GetConnFDOffset},
+		{&data.Conn_layout.Net_fd_pfd_offset, lookup.GetNetFD_PFDOffset},
+		{&data.Conn_layout.Fd_sysfd_offset, lookup.GetFD_SysfdOffset},
+	} {
+		if *field.offset, err = field.lookup(version, goarch); err != nil {
+			return data, err
+		}
+	}
+
+	readParams, err := lookup.GetReadParams(version, goarch)
+	if err != nil {
+		return data, err
+	}
+	if data.Read_conn_pointer, err = receiverLocation(readParams); err != nil {
+		return data, err
+	}
+	if data.Read_buffer, err = bufferLocation(abi, readParams); err != nil {
+		return data, err
+	}
+	if data.Read_return_bytes, err = readReturnBytesLocation(abi, readParams); err != nil {
+		return data, err
+	}
+
+	writeParams, err := lookup.GetWriteParams(version, goarch)
+	if err != nil {
+		return data, err
+	}
+	if data.Write_conn_pointer, err = receiverLocation(writeParams); err != nil {
+		return data, err
+	}
+	if data.Write_buffer, err = bufferLocation(abi, writeParams); err != nil {
+		return data, err
+	}
+
+	closeParams, err := lookup.GetCloseParams(version, goarch)
+	if err != nil {
+		return data, err
+	}
+	data.Close_conn_pointer, err = receiverLocation(closeParams)
+	return data, err
+}
+
+func goroutineIDLocation(version goversion.GoVersion, arch bininspect.GoArch, abi bininspect.GoABI) (goroutineIDMetadata, error) {
+	offset, err := goid.GetGoroutineIDOffset(version, string(arch))
+	if err != nil {
+		return goroutineIDMetadata{}, err
+	}
+
+	m := goroutineIDMetadata{Goroutine_id_offset: offset}
+	switch {
+	case arch == bininspect.GoArchARM64:
+		// g is kept in a register regardless of the ABI on arm64
+		m.Runtime_g_in_register = 1
+		m.Runtime_g_register = arm64GRegister
+	case abi == bininspect.GoABIRegister:
+		m.Runtime_g_in_register = 1
+		m.Runtime_g_register = amd64GRegister
+	default:
+		m.Runtime_g_tls_addr_offset = amd64GTLSOffset
+	}
+	return m, nil
+}
+
+func pieceLocation(piece bininspect.ParameterPiece) location {
+	if piece.InReg {
+		return location{X_register: uint64(piece.Register), In_register: 1, Exists: 1}
+	}
+	return stackLocation(piece.StackOffset)
+}
+
+func stackLocation(offset int64) location {
+	return location{Stack_offset: offset, Exists: 1}
+}
+
+func receiverLocation(params []bininspect.ParameterMetadata) (location, error) {
+	if len(params) == 0 || len(params[0].Pieces) == 0 {
+		return location{}, fmt.Errorf("missing receiver location")
+	}
+	return pieceLocation(params[0].Pieces[0]), nil
+}
+
+// bufferLocation returns the location of the []byte argument following the receiver. Some Go versions
+// omit it from their debug information, in which case it is derived from the stack-based ABI.
+func bufferLocation(abi bininspect.GoABI, params []bininspect.ParameterMetadata) (sliceLocation, error) {
+	if len(params) > 1 && len(params[1].Pieces) > 1 {
+		return sliceLocation{
+			Ptr: pieceLocation(params[1].Pieces[0]),
+			Len: pieceLocation(params[1].Pieces[1]),
+		}, nil
+	}
+
+	receiver, err := receiverLocation(params)
+	if err != nil {
+		return sliceLocation{}, err
+	}
+	if abi != bininspect.GoABIStack || receiver.In_register == 1 {
+		return sliceLocation{}, fmt.Errorf("missing buffer location")
+	}
+	return sliceLocation{
+		Ptr: stackLocation(receiver.Stack_offset + goPointerSize),
+		Len: stackLocation(receiver.Stack_offset + 2*goPointerSize),
+	}, nil
+}
+
+// readReturnBytesLocation returns the location of the number of bytes returned by crypto/tls.(*Conn).Read
+// at its return instructions. The register-based ABI assigns the results to the argument registers starting
+// over from the first one, and the stack-based ABI stores them right after the arguments.
+func readReturnBytesLocation(abi bininspect.GoABI, params []bininspect.ParameterMetadata) (location, error) {
+	receiver, err := receiverLocation(params)
+	if err != nil {
+		return location{}, err
+	}
+
+	if abi == bininspect.GoABIRegister {
+		return location{X_register: 0, In_register: 1, Exists: 1}, nil
+	}
+	if receiver.In_register == 1 {
+		return location{}, fmt.Errorf("unexpected receiver in register with the stack-based ABI")
+	}
+	return stackLocation(receiver.Stack_offset + goPointerSize + goSliceSize), nil
+}
@@ -0,0 +1,51 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package http
+
+import (
+	"testing"
+
+	"github.com/go-delve/delve/pkg/goversion"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+
+	"github.com/DataDog/datadog-agent/pkg/network/go/bininspect"
+)
+
+func TestGoTLSOffsets(t *testing.T) {
+	t.Run("register ABI", func(t *testing.T) {
+		data, err := goTLSOffsets(goversion.GoVersion{Major: 1, Minor: 18}, bininspect.GoArchX86_64, bininspect.GoABIRegister)
+		require.NoError(t, err)
+
+		assert.Equal(t, location{X_register: 0, In_register: 1, Exists: 1}, data.Read_conn_pointer)
+		assert.Equal(t, location{X_register: 3, In_register: 1, Exists: 1}, data.Read_buffer.Ptr)
+		assert.Equal(t, location{X_register: 2, In_register: 1, Exists: 1}, data.Read_buffer.Len)
+		assert.Equal(t, location{X_register: 0, In_register: 1, Exists: 1}, data.Read_return_bytes)
+		assert.Equal(t, uint8(1), data.Goroutine_id.Runtime_g_in_register)
+		assert.Equal(t, uint64(amd64GRegister), data.Goroutine_id.Runtime_g_register)
+	})
+
+	t.Run("stack ABI with missing buffer location", func(t *testing.T) {
+		// go1.16 doesn't describe the location of the buffer passed to crypto/tls.(*Conn).Read
+		data, err := goTLSOffsets(goversion.GoVersion{Major: 1, Minor: 16}, bininspect.GoArchX86_64, bininspect.GoABIStack)
+		require.NoError(t, err)
+
+		assert.Equal(t, stackLocation(8), data.Read_conn_pointer)
+		assert.Equal(t, stackLocation(16), data.Read_buffer.Ptr)
+		assert.Equal(t, stackLocation(24), data.Read_buffer.Len)
+		assert.Equal(t, stackLocation(40), data.Read_return_bytes)
+		assert.Equal(t, uint8(0), data.Goroutine_id.Runtime_g_in_register)
+		assert.Equal(t, int64(amd64GTLSOffset), data.Goroutine_id.Runtime_g_tls_addr_offset)
+	})
+
+	t.Run("unsupported version", func(t *testing.T) {
+		_, err := goTLSOffsets(goversion.GoVersion{Major: 1, Minor: 12}, bininspect.GoArchX86_64, bininspect.GoABIStack)
+		assert.Error(t, err)
+	})
+}
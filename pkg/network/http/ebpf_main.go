@@ -32,6 +32,7 @@ const (
 	httpBatchesMap           = "http_batches"
 	httpBatchStateMap        = "http_batch_state"
 	httpNotificationsPerfMap = "http_notifications"
+	httpTelemetryMap         = "http_telemetry"
 
 	// ELF section of the BPF_PROG_TYPE_SOCKET_FILTER program used
 	// to inspect plain HTTP traffic
@@ -57,6 +58,7 @@ type ebpfProgram struct {
 	bytecode    bytecode.AssetReader
 	offsets     []manager.ConstantEditor
 	subprograms []subprogram
+	goTLS       *goTLSProgram
 	mapCleaner  *ddebpf.MapCleaner
 
 	batchCompletionHandler *ddebpf.PerfHandler
@@ -82,6 +84,7 @@ func newEBPFProgram(c *config.Config, offsets []manager.ConstantEditor, sockFD *
 		}
 	}
 
+	runtimeCompiled := bc != nil
 	if bc == nil {
 		bc, err = netebpf.ReadHTTPModule(c.BPFDir, c.BPFDebug)
 		if err != nil {
@@ -95,6 +98,7 @@ func newEBPFProgram(c *config.Config, offsets []manager.ConstantEditor, sockFD *
 			{Name: httpInFlightMap},
 			{Name: httpBatchesMap},
 			{Name: httpBatchStateMap},
+			{Name: httpTelemetryMap},
 			{Name: sslSockByCtxMap},
 			{Name: httpProgsMap},
 			{Name: "ssl_read_args"},
@@ -142,13 +146,19 @@ func newEBPFProgram(c *config.Config, offsets []manager.ConstantEditor, sockFD *
 	}
 
 	sslProgram, _ := newSSLProgram(c, sockFD)
+	goTLSProgram := newGoTLSProgram(c)
+	if goTLSProgram != nil && !runtimeCompiled {
+		log.Warn("Go TLS monitoring requires the runtime compilation of the http tracer, disabling it")
+		goTLSProgram = nil
+	}
 	program := &ebpfProgram{
 		Manager:                mgr,
 		bytecode:               bc,
 		cfg:                    c,
 		offsets:                offsets,
 		batchCompletionHandler: batchCompletionHandler,
-		subprograms:            []subprogram{sslProgram},
+		subprograms:            []subprogram{sslProgram, goTLSProgram},
+		goTLS:                  goTLSProgram,
 	}
 
 	return program, nil
@@ -217,7 +227,7 @@ func (e *ebpfProgram) Init() error {
 				},
 			},
 		},
-		ConstantEditors: e.offsets,
+		ConstantEditors: append(ephemeralRangeEditors(), e.offsets...),
 	}
 
 	for _, s := range e.subprograms {
@@ -283,6 +293,16 @@ func (e *ebpfProgram) setupMapCleaner() {
 	e.mapCleaner = httpMapCleaner
 }
 
+// ephemeralRangeEditors injects the ephemeral port range of the host, which is used to normalize the
+// connection tuples into the (client, server) format
+func ephemeralRangeEditors() []manager.ConstantEditor {
+	start, end := config.EphemeralPortRange()
+	return []manager.ConstantEditor{
+		{Name: "ephemeral_range_begin", Value: uint64(start)},
+		{Name: "ephemeral_range_end", Value: uint64(end)},
+	}
+}
+
 func enableRuntimeCompilation(c *config.Config) bool {
 	if !c.EnableRuntimeCompiler {
 		return false
@@ -11,11 +11,13 @@ package http
 /*
 #include "../ebpf/c/tracer.h"
 #include "../ebpf/c/http-types.h"
+#include "../ebpf/c/runtime/go-tls-types.h"
 */
 import "C"
 
 type httpConnTuple C.conn_tuple_t
 type httpBatchState C.http_batch_state_t
+type httpTelemetry C.http_telemetry_t
 type sslSock C.ssl_sock_t
 type sslReadArgs C.ssl_read_args_t
 
@@ -26,6 +28,12 @@ type httpBatchKey C.http_batch_key_t
 
 type libPath C.lib_path_t
 
+type location C.location_t
+type sliceLocation C.slice_location_t
+type goroutineIDMetadata C.goroutine_id_metadata_t
+type tlsConnLayout C.tls_conn_layout_t
+type tlsOffsetsData C.tls_offsets_data_t
+
 const (
 	HTTPBatchSize  = C.HTTP_BATCH_SIZE
 	HTTPBatchPages = C.HTTP_BATCH_PAGES
@@ -20,10 +20,14 @@ type httpBatchState struct {
 	Pos           uint8
 	Idx_to_notify uint64
 }
+type httpTelemetry struct {
+	Ambiguous_tuples uint64
+}
 type sslSock struct {
 	Tup       httpConnTuple
 	Fd        uint32
-	Pad_cgo_0 [4]byte
+	Skip      uint8
+	Pad_cgo_0 [3]byte
 }
 type sslReadArgs struct {
 	Ctx *byte
@@ -61,6 +65,42 @@ type libPath struct {
 	Buf [120]byte
 }
 
+type location struct {
+	Stack_offset int64
+	X_register   uint64
+	In_register  uint8
+	Exists       uint8
+	Pad_cgo_0    [6]byte
+}
+type sliceLocation struct {
+	Ptr location
+	Len location
+}
+type goroutineIDMetadata struct {
+	Goroutine_id_offset       uint64
+	Runtime_g_tls_addr_offset int64
+	Runtime_g_register        uint64
+	Runtime_g_in_register     uint8
+	Pad_cgo_0                 [7]byte
+}
+type tlsConnLayout struct {
+	Tls_conn_inner_conn_offset uint64
+	Tcp_conn_inner_conn_offset uint64
+	Conn_fd_offset             uint64
+	Net_fd_pfd_offset          uint64
+	Fd_sysfd_offset            uint64
+}
+type tlsOffsetsData struct {
+	Goroutine_id       goroutineIDMetadata
+	Conn_layout        tlsConnLayout
+	Read_conn_pointer  location
+	Read_buffer        sliceLocation
+	Read_return_bytes  location
+	Write_conn_pointer location
+	Write_buffer       sliceLocation
+	Close_conn_pointer location
+}
+
 const (
 	HTTPBatchSize  = 0xf
 	HTTPBatchPages = 0xf
@@ -11,6 +11,7 @@ package http
 import (
 	"fmt"
 	"sync"
+	"unsafe"
 
 	"github.com/cilium/ebpf"
 
@@ -19,6 +20,7 @@ import (
 	ddebpf "github.com/DataDog/datadog-agent/pkg/ebpf"
 	"github.com/DataDog/datadog-agent/pkg/network/config"
 	filterpkg "github.com/DataDog/datadog-agent/pkg/network/filter"
+	"github.com/DataDog/datadog-agent/pkg/util/log"
 )
 
 // HTTPMonitorStats is used for holding two kinds of stats:
@@ -45,6 +47,9 @@ type Monitor struct {
 	pollRequests           chan chan HTTPMonitorStats
 	statkeeper             *httpStatKeeper
 
+	telemetryMap        *ebpf.Map
+	lastAmbiguousTuples uint64
+
 	// termination
 	mux           sync.Mutex
 	eventLoopWG   sync.WaitGroup
@@ -78,6 +83,11 @@ func NewMonitor(c *config.Config, offsets []manager.ConstantEditor, sockFD *ebpf
 		return nil, err
 	}
 
+	telemetryMap, _, err := mgr.GetMap(httpTelemetryMap)
+	if err != nil {
+		return nil, err
+	}
+
 	notificationMap, _, _ := mgr.GetMap(httpNotificationsPerfMap)
 	numCPUs := int(notificationMap.MaxEntries())
 
@@ -108,6 +118,7 @@ func NewMonitor(c *config.Config, offsets []manager.ConstantEditor, sockFD *ebpf
 		pollRequests:           make(chan chan HTTPMonitorStats),
 		closeFilterFn:          closeFilterFn,
 		statkeeper:             statkeeper,
+		telemetryMap:           telemetryMap,
 	}, nil
 }
 
@@ -149,6 +160,7 @@ func (m *Monitor) Start() error {
 
 				transactions := m.batchManager.GetPendingTransactions()
 				m.process(transactions, nil)
+				m.readKernelTelemetry()
 
 				delta := m.telemetry.reset()
 
@@ -204,7 +216,10 @@ func (m *Monitor) GetStats() map[string]interface{} {
 		return empty
 	}
 
-	return m.telemetrySnapshot.report()
+	stats := m.telemetrySnapshot.report()
+	stats["map_cleaner"] = m.ebpfProgram.mapCleaner.GetStats()
+	stats["go_tls"] = m.ebpfProgram.goTLS.GetStats()
+	return stats
 }
 
 // Stop HTTP monitoring
@@ -234,6 +249,19 @@ func (m *Monitor) process(transactions []httpTX, err error) {
 	}
 }
 
+// readKernelTelemetry accounts for the counters incremented by the eBPF programs since the last read
+func (m *Monitor) readKernelTelemetry() {
+	var key uint32
+	var kernelTelemetry httpTelemetry
+	if err := m.telemetryMap.Lookup(unsafe.Pointer(&key), unsafe.Pointer(&kernelTelemetry)); err != nil {
+		log.Debugf("error reading %s map: %s", httpTelemetryMap, err)
+		return
+	}
+
+	m.telemetry.ambiguousTuples.Add(int64(kernelTelemetry.Ambiguous_tuples - m.lastAmbiguousTuples))
+	m.lastAmbiguousTuples = kernelTelemetry.Ambiguous_tuples
+}
+
 func (m *Monitor) DumpMaps(maps ...string) (string, error) {
 	return m.ebpfProgram.Manager.DumpMaps(maps...)
 }
@@ -27,22 +27,24 @@ type telemetry struct {
 	rejected                                    *atomic.Int64 `stats:""` // this happens when an user-defined reject-filter matches a request
 	malformed                                   *atomic.Int64 `stats:""` // this happens when the request doesn't have the expected format
 	aggregations                                *atomic.Int64 `stats:""`
+	ambiguousTuples                             *atomic.Int64 `stats:""` // this happens when the ports of a connection can't tell its client from its server
 }
 
 func newTelemetry() (*telemetry, error) {
 	t := &telemetry{
-		then:         atomic.NewInt64(time.Now().Unix()),
-		elapsed:      atomic.NewInt64(0),
-		hits1XX:      atomic.NewInt64(0),
-		hits2XX:      atomic.NewInt64(0),
-		hits3XX:      atomic.NewInt64(0),
-		hits4XX:      atomic.NewInt64(0),
-		hits5XX:      atomic.NewInt64(0),
-		misses:       atomic.NewInt64(0),
-		dropped:      atomic.NewInt64(0),
-		rejected:     atomic.NewInt64(0),
-		malformed:    atomic.NewInt64(0),
-		aggregations: atomic.NewInt64(0),
+		then:            atomic.NewInt64(time.Now().Unix()),
+		elapsed:         atomic.NewInt64(0),
+		hits1XX:         atomic.NewInt64(0),
+		hits2XX:         atomic.NewInt64(0),
+		hits3XX:         atomic.NewInt64(0),
+		hits4XX:         atomic.NewInt64(0),
+		hits5XX:         atomic.NewInt64(0),
+		misses:          atomic.NewInt64(0),
+		dropped:         atomic.NewInt64(0),
+		rejected:        atomic.NewInt64(0),
+		malformed:       atomic.NewInt64(0),
+		aggregations:    atomic.NewInt64(0),
+		ambiguousTuples: atomic.NewInt64(0),
 	}
 
 	return t, nil
@@ -84,11 +86,12 @@ func (t *telemetry) reset() telemetry {
 	delta.rejected.Store(t.rejected.Swap(0))
 	delta.malformed.Store(t.malformed.Swap(0))
 	delta.aggregations.Store(t.aggregations.Swap(0))
+	delta.ambiguousTuples.Store(t.ambiguousTuples.Swap(0))
 	delta.elapsed.Store(now - then)
 
 	totalRequests := delta.hits1XX.Load() + delta.hits2XX.Load() + delta.hits3XX.Load() + delta.hits4XX.Load() + delta.hits5XX.Load()
 	log.Debugf(
-		"http stats summary: requests_processed=%d(%.2f/s) requests_missed=%d(%.2f/s) requests_dropped=%d(%.2f/s) requests_rejected=%d(%.2f/s) requests_malformed=%d(%.2f/s) aggregations=%d",
+		"http stats summary: requests_processed=%d(%.2f/s) requests_missed=%d(%.2f/s) requests_dropped=%d(%.2f/s) requests_rejected=%d(%.2f/s) requests_malformed=%d(%.2f/s) aggregations=%d ambiguous_tuples=%d",
 		totalRequests,
 		float64(totalRequests)/float64(delta.elapsed.Load()),
 		delta.misses.Load(),
@@ -100,6 +103,7 @@ func (t *telemetry) reset() telemetry {
 		delta.malformed.Load(),
 		float64(delta.malformed.Load())/float64(delta.elapsed.Load()),
 		delta.aggregations.Load(),
+		delta.ambiguousTuples.Load(),
 	)
 
 	return *delta
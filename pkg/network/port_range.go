@@ -5,15 +5,11 @@
 
 package network
 
-const (
-	ephemeralRangeStart = 32768
-	ephemeralRangeEnd   = 60999
-)
+import "github.com/DataDog/datadog-agent/pkg/network/config"
 
-// IsEphemeralPort returns true if a port belongs to the ephemeral range
-// This is mostly a placeholder for now as we have work planned for a
-// platform-agnostic solution that will, among other things, source these values
-// from procfs for Linux hosts
+// IsEphemeralPort returns true if a port belongs to the ephemeral range of the host,
+// as used by the eBPF programs to normalize connection tuples (see `port_range.h`)
 func IsEphemeralPort(port int) bool {
-	return port >= ephemeralRangeStart && port <= ephemeralRangeEnd
+	start, end := config.EphemeralPortRange()
+	return port >= int(start) && port <= int(end)
 }
@@ -96,31 +96,31 @@ const minClosedCapacity = 1024
 type client struct {
 	lastFetch time.Time
 
-	// generated via `ByteKey` and used exclusively to roll up closed connections
-	closedConnectionsKeys map[string]int
+	// generated via `KeyNAT` and used exclusively to roll up closed connections
+	closedConnectionsKeys map[ConnectionKey]int
 
 	closedConnections []ConnectionStats
-	stats             map[string]StatCountersByCookie
+	stats             map[ConnectionKey]StatCountersByCookie
 	// maps by dns key the domain (string) to stats structure
 	dnsStats        dns.StatsByKeyByNameByType
 	httpStatsDelta  map[http.Key]*http.RequestStats
 	lastTelemetries map[ConnTelemetryType]int64
 }
 
-func (c *client) Reset(active map[string]*ConnectionStats) {
+func (c *client) Reset(active map[ConnectionKey]*ConnectionStats) {
 	half := cap(c.closedConnections) / 2
 	if closedLen := len(c.closedConnections); closedLen > minClosedCapacity && closedLen < half {
 		c.closedConnections = make([]ConnectionStats, half)
 	}
 
 	c.closedConnections = c.closedConnections[:0]
-	c.closedConnectionsKeys = make(map[string]int)
+	c.closedConnectionsKeys = make(map[ConnectionKey]int)
 	c.dnsStats = make(dns.StatsByKeyByNameByType)
 	c.httpStatsDelta = make(map[http.Key]*http.RequestStats)
 
 	// XXX: we should change the way we clean this map once
 	// https://github.com/golang/go/issues/20135 is solved
-	newStats := make(map[string]StatCountersByCookie, len(c.stats))
+	newStats := make(map[ConnectionKey]StatCountersByCookie, len(c.stats))
 	for key, st := range c.stats {
 		// Only keep active connections stats
 		if _, isActive := active[key]; isActive {
@@ -138,7 +138,6 @@ type networkState struct {
 	telemetry     telemetry // Monotonic state telemetry
 	lastTelemetry telemetry // Old telemetry state; used for logging
 
-	buf             []byte // Shared buffer
 	latestTimeEpoch uint64
 
 	// Network state configuration
@@ -159,7 +158,6 @@ func NewState(clientExpiry time.Duration, maxClosedConns, maxClientStats int, ma
 		maxClientStats: maxClientStats,
 		maxDNSStats:    maxDNSStats,
 		maxHTTPStats:   maxHTTPStats,
-		buf:            make([]byte, ConnectionByteKeyMaxLen),
 	}
 }
 
@@ -206,7 +204,7 @@ func (ns *networkState) GetDelta(
 
 	// Update the latest known time
 	ns.latestTimeEpoch = latestTime
-	connsByKey := getConnsByKey(active, ns.buf)
+	connsByKey := getConnsByKey(active)
 
 	clientBuffer := clientPool.Get(id)
 	client := ns.getClient(id)
@@ -321,18 +319,18 @@ func (ns *networkState) RegisterClient(id string) {
 	_ = ns.getClient(id)
 }
 
-// getConnsByKey returns a mapping of byte-key -> connection for easier access + manipulation
-func getConnsByKey(conns []ConnectionStats, buf []byte) map[string]*ConnectionStats {
-	connsByKey := make(map[string]*ConnectionStats, len(conns))
+// getConnsByKey returns a mapping of key -> connection for easier access + manipulation
+func getConnsByKey(conns []ConnectionStats) map[ConnectionKey]*ConnectionStats {
+	connsByKey := make(map[ConnectionKey]*ConnectionStats, len(conns))
 	for i := range conns {
-		key := string(conns[i].ByteKey(buf))
+		key := conns[i].Key()
 		var c *ConnectionStats
 		if c = connsByKey[key]; c == nil {
 			connsByKey[key] = &conns[i]
 			continue
 		}
 
-		log.Tracef("duplicate connection in collection: key: %s, c1: %+v, c2: %+v", BeautifyKey(key), *c, conns[i])
+		log.Tracef("duplicate connection in collection: key: %s, c1: %+v, c2: %+v", key, *c, conns[i])
 		mergeConnectionStats(c, &conns[i])
 	}
 
@@ -350,7 +348,7 @@ func (ns *networkState) StoreClosedConnections(closed []ConnectionStats) {
 func (ns *networkState) storeClosedConnections(conns []ConnectionStats) {
 	for _, client := range ns.clients {
 		for _, c := range conns {
-			key := string(c.ByteKeyNAT(ns.buf))
+			key := c.KeyNAT()
 
 			if i, ok := client.closedConnectionsKeys[key]; ok {
 				mergeConnectionStats(&client.closedConnections[i], &c)
@@ -472,9 +470,9 @@ func (ns *networkState) getClient(clientID string) *client {
 
 	c := &client{
 		lastFetch:             time.Now(),
-		stats:                 make(map[string]StatCountersByCookie),
+		stats:                 make(map[ConnectionKey]StatCountersByCookie),
 		closedConnections:     make([]ConnectionStats, 0, minClosedCapacity),
-		closedConnectionsKeys: make(map[string]int),
+		closedConnectionsKeys: make(map[ConnectionKey]int),
 		dnsStats:              dns.StatsByKeyByNameByType{},
 		httpStatsDelta:        map[http.Key]*http.RequestStats{},
 		lastTelemetries:       make(map[ConnTelemetryType]int64),
@@ -484,17 +482,17 @@ func (ns *networkState) getClient(clientID string) *client {
 }
 
 // mergeConnections return the connections and takes care of updating their last stat counters
-func (ns *networkState) mergeConnections(id string, active map[string]*ConnectionStats, buffer *clientBuffer) {
+func (ns *networkState) mergeConnections(id string, active map[ConnectionKey]*ConnectionStats, buffer *clientBuffer) {
 	now := time.Now()
 
 	client := ns.clients[id]
 	client.lastFetch = now
 
 	closed := client.closedConnections
-	closedKeys := make(map[string]struct{}, len(closed))
+	closedKeys := make(map[ConnectionKey]struct{}, len(closed))
 	for i := range closed {
 		closedConn := &closed[i]
-		key := string(closedConn.ByteKey(ns.buf))
+		key := closedConn.Key()
 		closedKeys[key] = struct{}{}
 
 		var activeConn *ConnectionStats
@@ -522,7 +520,7 @@ func (ns *networkState) mergeConnections(id string, active map[string]*Connectio
 	}
 }
 
-func (ns *networkState) updateConnWithStats(client *client, key string, c *ConnectionStats) {
+func (ns *networkState) updateConnWithStats(client *client, key ConnectionKey, c *ConnectionStats) {
 	c.Last = StatCounters{}
 	if sts, ok := client.stats[key]; ok {
 		for _, cm := range c.Monotonic {
@@ -541,7 +539,7 @@ func (ns *networkState) updateConnWithStats(client *client, key string, c *Conne
 			var underflow bool
 			if last, underflow = counters.Sub(st); underflow {
 				ns.telemetry.statsUnderflows++
-				log.Debugf("Stats underflow for key:%s, stats:%+v, connection:%+v", BeautifyKey(key), st, *c)
+				log.Debugf("Stats underflow for key:%s, stats:%+v, connection:%+v", key, st, *c)
 
 				counters = counters.Max(st)
 				last, _ = counters.Sub(st)
@@ -560,7 +558,7 @@ func (ns *networkState) updateConnWithStats(client *client, key string, c *Conne
 }
 
 // createStatsForKey will create a new stats object for a key if it doesn't already exist.
-func (ns *networkState) createStatsForKey(client *client, key string) {
+func (ns *networkState) createStatsForKey(client *client, key ConnectionKey) {
 	if _, ok := client.stats[key]; !ok {
 		if len(client.stats) >= ns.maxClientStats {
 			ns.telemetry.connDropped++
@@ -596,8 +594,7 @@ func (ns *networkState) RemoveConnections(conns []*ConnectionStats) {
 
 	for _, cl := range ns.clients {
 		for _, c := range conns {
-			key := c.ByteKey(ns.buf)
-			delete(cl.stats, string(key))
+			delete(cl.stats, c.Key())
 		}
 	}
 }
@@ -651,7 +648,7 @@ func (ns *networkState) DumpState(clientID string) map[string]interface{} {
 				}
 			}
 
-			data[BeautifyKey(connKey)] = byCookie
+			data[connKey.String()] = byCookie
 		}
 	}
 	return data
@@ -11,6 +11,8 @@ package tracer
 import (
 	"github.com/DataDog/datadog-agent/pkg/ebpf/bytecode/runtime"
 	"github.com/DataDog/datadog-agent/pkg/network/config"
+	"github.com/DataDog/datadog-agent/pkg/network/http"
+	"github.com/DataDog/datadog-agent/pkg/network/tracer/connection/kprobe"
 	"github.com/DataDog/datadog-agent/pkg/process/statsd"
 )
 
@@ -21,6 +23,20 @@ func getRuntimeCompiledConntracker(config *config.Config) (runtime.CompiledOutpu
 	return runtime.Conntrack.Compile(&config.Config, getCFlags(config), statsd.Client)
 }
 
+// precompileRuntimeAssets starts compiling the runtime versions of the programs used by the tracer in the
+// background, so that they are compiled concurrently and while offsets are being guessed
+func precompileRuntimeAssets(config *config.Config) {
+	if !config.EnableRuntimeCompiler {
+		return
+	}
+
+	kprobe.PrecompileRuntime(config)
+	if config.EnableConntrack {
+		runtime.Conntrack.Precompile(&config.Config, getCFlags(config))
+	}
+	http.PrecompileRuntime(config)
+}
+
 func getCFlags(config *config.Config) []string {
 	var cflags []string
 	if config.CollectIPv6Conns {
@@ -21,6 +21,11 @@ func getRuntimeCompiledTracer(config *config.Config) (runtime.CompiledOutput, er
 	return runtime.Tracer.Compile(&config.Config, getCFlags(config), statsd.Client)
 }
 
+// PrecompileRuntime starts compiling the runtime version of the network tracer in the background
+func PrecompileRuntime(config *config.Config) {
+	runtime.Tracer.Precompile(&config.Config, getCFlags(config))
+}
+
 func getCFlags(config *config.Config) []string {
 	var cflags []string
 	if config.CollectIPv6Conns {
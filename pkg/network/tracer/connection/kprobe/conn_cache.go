@@ -0,0 +1,192 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package kprobe
+
+import (
+	"fmt"
+	"unsafe"
+
+	"github.com/cilium/ebpf"
+
+	netebpf "github.com/DataDog/datadog-agent/pkg/network/ebpf"
+)
+
+// connCache mirrors the conn_stats and tcp_stats maps, so that polling the connections costs map
+// operations proportional to the number of connections that changed rather than to the number of
+// tracked connections.
+//
+// The eBPF programs log the connections they update in the change set of the current read generation
+// (conn_changes_even or conn_changes_odd). Each sync increments the generation, so that the programs
+// switch to the other set, then drains the set of the previous generation.
+type connCache struct {
+	conns          *ebpf.Map
+	tcpStats       *ebpf.Map
+	readGeneration *ebpf.Map
+	changes        [2]*ebpf.Map
+
+	generation uint32
+	// value of the conn_changes_max_entries_hit counter at the last sync
+	changesMissed uint64
+
+	connStats   map[netebpf.ConnTuple]netebpf.ConnStats
+	tcp         map[netebpf.ConnTuple]netebpf.TCPStats
+	changedKeys []netebpf.ConnTuple
+}
+
+func newConnCache(conns, tcpStats, readGeneration, changesEven, changesOdd *ebpf.Map) *connCache {
+	return &connCache{
+		conns:          conns,
+		tcpStats:       tcpStats,
+		readGeneration: readGeneration,
+		changes:        [2]*ebpf.Map{changesEven, changesOdd},
+		connStats:      make(map[netebpf.ConnTuple]netebpf.ConnStats),
+		tcp:            make(map[netebpf.ConnTuple]netebpf.TCPStats),
+	}
+}
+
+// nextReadGeneration returns the generation following the given one. 0 is skipped since it disables
+// the change sets, and the parity alternates across the wrap-around.
+func nextReadGeneration(generation uint32) uint32 {
+	generation++
+	if generation == 0 {
+		generation = 2
+	}
+	return generation
+}
+
+// sync updates the cache with the connections that changed since the previous sync. It falls back to
+// a full read of the maps the first time, or when the eBPF programs couldn't log some changes.
+func (c *connCache) sync(changesMissed uint64) error {
+	if c.generation == 0 || changesMissed != c.changesMissed {
+		c.changesMissed = changesMissed
+		return c.resync()
+	}
+
+	previous := c.generation
+	if err := c.incrementGeneration(); err != nil {
+		return err
+	}
+	return c.readChanges(c.changes[previous&1])
+}
+
+func (c *connCache) incrementGeneration() error {
+	next := nextReadGeneration(c.generation)
+	var zero uint32
+	if err := c.readGeneration.Put(unsafe.Pointer(&zero), unsafe.Pointer(&next)); err != nil {
+		return fmt.Errorf("error updating the read generation: %w", err)
+	}
+	c.generation = next
+	return nil
+}
+
+// resync reads all the connections. The generation is incremented first so that the updates made
+// during the read are logged and picked up by the next sync.
+func (c *connCache) resync() error {
+	previous := c.generation
+	if err := c.incrementGeneration(); err != nil {
+		return err
+	}
+	if previous != 0 {
+		if err := c.collectChanges(c.changes[previous&1]); err != nil {
+			return err
+		}
+		for i := range c.changedKeys {
+			_ = c.changes[previous&1].Delete(unsafe.Pointer(&c.changedKeys[i]))
+		}
+	}
+
+	connStats := make(map[netebpf.ConnTuple]netebpf.ConnStats, len(c.connStats))
+	key, stats := &netebpf.ConnTuple{}, &netebpf.ConnStats{}
+	entries := c.conns.Iterate()
+	for entries.Next(unsafe.Pointer(key), unsafe.Pointer(stats)) {
+		connStats[*key] = *stats
+	}
+	if err := entries.Err(); err != nil {
+		return fmt.Errorf("unable to iterate connection map: %s", err)
+	}
+
+	tcp := make(map[netebpf.ConnTuple]netebpf.TCPStats, len(c.tcp))
+	tcpStats := &netebpf.TCPStats{}
+	entries = c.tcpStats.Iterate()
+	for entries.Next(unsafe.Pointer(key), unsafe.Pointer(tcpStats)) {
+		tcp[*key] = *tcpStats
+	}
+	if err := entries.Err(); err != nil {
+		return fmt.Errorf("unable to iterate tcp stats map: %s", err)
+	}
+
+	c.connStats = connStats
+	c.tcp = tcp
+	return nil
+}
+
+func (c *connCache) collectChanges(changes *ebpf.Map) error {
+	c.changedKeys = c.changedKeys[:0]
+	key := netebpf.ConnTuple{}
+	var changed uint8
+	entries := changes.Iterate()
+	for entries.Next(unsafe.Pointer(&key), unsafe.Pointer(&changed)) {
+		c.changedKeys = append(c.changedKeys, key)
+	}
+	if err := entries.Err(); err != nil {
+		return fmt.Errorf("unable to iterate connection changes map: %s", err)
+	}
+	return nil
+}
+
+// readChanges refreshes the connections of a change set. Each key is deleted before its stats are read,
+// so that a concurrent update is either read now or logged again.
+func (c *connCache) readChanges(changes *ebpf.Map) error {
+	if err := c.collectChanges(changes); err != nil {
+		return err
+	}
+
+	stats, tcpStats := &netebpf.ConnStats{}, &netebpf.TCPStats{}
+	for i := range c.changedKeys {
+		key := &c.changedKeys[i]
+		_ = changes.Delete(unsafe.Pointer(key))
+
+		if err := c.conns.Lookup(unsafe.Pointer(key), unsafe.Pointer(stats)); err == nil {
+			c.connStats[*key] = *stats
+		} else {
+			delete(c.connStats, *key)
+		}
+
+		if key.Type() != netebpf.TCP {
+			continue
+		}
+
+		// The PID isn't used as a key in the stats map
+		tcpKey := *key
+		tcpKey.Pid = 0
+		if err := c.tcpStats.Lookup(unsafe.Pointer(&tcpKey), unsafe.Pointer(tcpStats)); err == nil {
+			c.tcp[tcpKey] = *tcpStats
+		} else {
+			delete(c.tcp, tcpKey)
+		}
+	}
+	return nil
+}
+
+// remove drops a connection removed from the maps by system-probe
+func (c *connCache) remove(tuple *netebpf.ConnTuple) {
+	delete(c.connStats, *tuple)
+	if tuple.Type() == netebpf.TCP {
+		tcpKey := *tuple
+		tcpKey.Pid = 0
+		delete(c.tcp, tcpKey)
+	}
+}
+
+// getTCPStats returns the cached tcp stats of a connection
+func (c *connCache) getTCPStats(tuple netebpf.ConnTuple) (netebpf.TCPStats, bool) {
+	tuple.Pid = 0
+	stats, ok := c.tcp[tuple]
+	return stats, ok
+}
@@ -0,0 +1,100 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package kprobe
+
+import (
+	"testing"
+	"unsafe"
+
+	"github.com/cilium/ebpf"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+
+	netebpf "github.com/DataDog/datadog-agent/pkg/network/ebpf"
+)
+
+func TestNextReadGeneration(t *testing.T) {
+	assert.Equal(t, uint32(1), nextReadGeneration(0))
+	assert.Equal(t, uint32(2), nextReadGeneration(1))
+	// 0 is skipped and the parity keeps alternating
+	assert.Equal(t, uint32(2), nextReadGeneration(^uint32(0)))
+}
+
+func TestConnCacheSync(t *testing.T) {
+	newHashMap := func(keySize, valueSize uint32) *ebpf.Map {
+		m, err := ebpf.NewMap(&ebpf.MapSpec{Type: ebpf.Hash, KeySize: keySize, ValueSize: valueSize, MaxEntries: 16})
+		require.NoError(t, err)
+		t.Cleanup(func() { _ = m.Close() })
+		return m
+	}
+	tupleSize := uint32(unsafe.Sizeof(netebpf.ConnTuple{}))
+	conns := newHashMap(tupleSize, uint32(unsafe.Sizeof(netebpf.ConnStats{})))
+	tcpStats := newHashMap(tupleSize, uint32(unsafe.Sizeof(netebpf.TCPStats{})))
+	changes := [2]*ebpf.Map{newHashMap(tupleSize, 1), newHashMap(tupleSize, 1)}
+	generation, err := ebpf.NewMap(&ebpf.MapSpec{Type: ebpf.Array, KeySize: 4, ValueSize: 4, MaxEntries: 1})
+	require.NoError(t, err)
+	t.Cleanup(func() { _ = generation.Close() })
+
+	cache := newConnCache(conns, tcpStats, generation, changes[0], changes[1])
+
+	tcpConn := netebpf.ConnTuple{Pid: 1, Sport: 1000, Dport: 80, Metadata: uint32(netebpf.TCP)}
+	udpConn := netebpf.ConnTuple{Pid: 2, Sport: 1001, Dport: 53, Metadata: uint32(netebpf.UDP)}
+	tcpKey := tcpConn
+	tcpKey.Pid = 0
+
+	put := func(m *ebpf.Map, key *netebpf.ConnTuple, value unsafe.Pointer) {
+		require.NoError(t, m.Put(unsafe.Pointer(key), value))
+	}
+	// logChange mimics log_conn_change in tracer-changes.h
+	logChange := func(key *netebpf.ConnTuple) {
+		var changed uint8 = 1
+		put(changes[cache.generation&1], key, unsafe.Pointer(&changed))
+	}
+
+	put(conns, &tcpConn, unsafe.Pointer(&netebpf.ConnStats{Sent_bytes: 10}))
+	put(tcpStats, &tcpKey, unsafe.Pointer(&netebpf.TCPStats{Retransmits: 1}))
+
+	// the first sync reads all the connections
+	require.NoError(t, cache.sync(0))
+	assert.Equal(t, uint32(1), cache.generation)
+	require.Len(t, cache.connStats, 1)
+	assert.Equal(t, uint64(10), cache.connStats[tcpConn].Sent_bytes)
+
+	// unlogged updates aren't read
+	put(conns, &udpConn, unsafe.Pointer(&netebpf.ConnStats{Recv_bytes: 5}))
+	put(conns, &tcpConn, unsafe.Pointer(&netebpf.ConnStats{Sent_bytes: 20}))
+	logChange(&tcpConn)
+	put(tcpStats, &tcpKey, unsafe.Pointer(&netebpf.TCPStats{Retransmits: 2}))
+
+	require.NoError(t, cache.sync(0))
+	assert.Equal(t, uint32(2), cache.generation)
+	require.Len(t, cache.connStats, 1)
+	assert.Equal(t, uint64(20), cache.connStats[tcpConn].Sent_bytes)
+	stats, ok := cache.getTCPStats(tcpConn)
+	require.True(t, ok)
+	assert.Equal(t, uint32(2), stats.Retransmits)
+
+	// deleted connections are dropped from the cache
+	require.NoError(t, conns.Delete(unsafe.Pointer(&tcpConn)))
+	require.NoError(t, tcpStats.Delete(unsafe.Pointer(&tcpKey)))
+	logChange(&tcpConn)
+	logChange(&udpConn)
+
+	require.NoError(t, cache.sync(0))
+	require.Len(t, cache.connStats, 1)
+	assert.Equal(t, uint64(5), cache.connStats[udpConn].Recv_bytes)
+	_, ok = cache.getTCPStats(tcpConn)
+	assert.False(t, ok)
+
+	// missed changes trigger a full read
+	put(conns, &tcpConn, unsafe.Pointer(&netebpf.ConnStats{Sent_bytes: 30}))
+	require.NoError(t, cache.sync(1))
+	require.Len(t, cache.connStats, 2)
+	assert.Equal(t, uint64(30), cache.connStats[tcpConn].Sent_bytes)
+}
@@ -107,6 +107,15 @@ func dumpMapsHandler(manager *manager.Manager, mapName string, currentMap *ebpf.
 			output.WriteString(spew.Sdump(key, value))
 		}
 
+	case string(probes.ConnChangesEvenMap), string(probes.ConnChangesOddMap): // maps/conn_changes_{even,odd} (BPF_MAP_TYPE_HASH), key ConnTuple, value C.__u8
+		output.WriteString("Map: '" + mapName + "', key: 'ConnTuple', value: 'C.__u8'\n")
+		iter := currentMap.Iterate()
+		var key ddebpf.ConnTuple
+		var value uint8
+		for iter.Next(unsafe.Pointer(&key), unsafe.Pointer(&value)) {
+			output.WriteString(spew.Sdump(key, value))
+		}
+
 	case string(probes.ConnCloseBatchMap): // maps/conn_close_batch (BPF_MAP_TYPE_HASH), key C.__u32, value batch
 		output.WriteString("Map: '" + mapName + "', key: 'C.__u32', value: 'batch'\n")
 		iter := currentMap.Iterate()
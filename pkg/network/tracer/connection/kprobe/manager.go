@@ -80,6 +80,9 @@ func newManager(closedHandler *ebpf.PerfHandler, runtimeTracer bool) *manager.Ma
 			{Name: string(probes.UdpPortBindingsMap)},
 			{Name: "pending_bind"},
 			{Name: string(probes.TelemetryMap)},
+			{Name: string(probes.ConnReadGenerationMap)},
+			{Name: string(probes.ConnChangesEvenMap)},
+			{Name: string(probes.ConnChangesOddMap)},
 			{Name: string(probes.SockByPidFDMap)},
 			{Name: string(probes.PidFDBySockMap)},
 			{Name: string(probes.SockFDLookupArgsMap)},
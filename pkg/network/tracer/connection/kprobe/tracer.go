@@ -45,6 +45,9 @@ type kprobeTracer struct {
 	tcpStats *ebpf.Map
 	config   *config.Config
 
+	// cache of the connection maps, updated with the connections that changed since the previous poll
+	cache *connCache
+
 	// tcp_close events
 	closeConsumer *tcpCloseConsumer
 
@@ -83,6 +86,8 @@ func New(config *config.Config, constants []manager.ConstantEditor) (connection.
 		MapSpecEditors: map[string]manager.MapSpecEditor{
 			string(probes.ConnMap):            {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
 			string(probes.TcpStatsMap):        {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
+			string(probes.ConnChangesEvenMap): {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
+			string(probes.ConnChangesOddMap):  {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
 			string(probes.PortBindingsMap):    {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
 			string(probes.UdpPortBindingsMap): {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
 			string(probes.SockByPidFDMap):     {Type: ebpf.Hash, MaxEntries: uint32(config.MaxTrackedConnections), EditorFlag: manager.EditMaxEntries},
@@ -177,6 +182,17 @@ func New(config *config.Config, constants []manager.ConstantEditor) (connection.
 		return nil, fmt.Errorf("error retrieving the bpf %s map: %s", probes.TcpStatsMap, err)
 	}
 
+	changeMaps := make([]*ebpf.Map, 0, 3)
+	for _, name := range []probes.BPFMapName{probes.ConnReadGenerationMap, probes.ConnChangesEvenMap, probes.ConnChangesOddMap} {
+		mp, _, err := m.GetMap(string(name))
+		if err != nil {
+			tr.Stop()
+			return nil, fmt.Errorf("error retrieving the bpf %s map: %s", name, err)
+		}
+		changeMaps = append(changeMaps, mp)
+	}
+	tr.cache = newConnCache(tr.conns, tr.tcpStats, changeMaps[0], changeMaps[1], changeMaps[2])
+
 	return tr, nil
 }
 
@@ -220,8 +236,11 @@ func (t *kprobeTracer) GetMap(name string) *ebpf.Map {
 }
 
 func (t *kprobeTracer) GetConnections(buffer *network.ConnectionBuffer, filter func(*network.ConnectionStats) bool) error {
-	// Iterate through all key-value pairs in map
-	key, stats := &netebpf.ConnTuple{}, &netebpf.ConnStats{}
+	// Only read the connections that changed since the previous call
+	if err := t.cache.sync(t.readKernelTelemetry().Conn_changes_max_entries_hit); err != nil {
+		return err
+	}
+
 	seen := make(map[netebpf.ConnTuple]struct{})
 
 	// Cached objects
@@ -229,25 +248,20 @@ func (t *kprobeTracer) GetConnections(buffer *network.ConnectionBuffer, filter f
 	tcp := new(netebpf.TCPStats)
 
 	tel := newTelemetry()
-	entries := t.conns.Iterate()
-	for entries.Next(unsafe.Pointer(key), unsafe.Pointer(stats)) {
-		populateConnStats(conn, key, stats)
+	for key, stats := range t.cache.connStats {
+		populateConnStats(conn, &key, &stats)
 
 		tel.addConnection(conn)
 
 		if filter != nil && !filter(conn) {
 			continue
 		}
-		if t.getTCPStats(tcp, key, seen) {
+		if t.getTCPStats(tcp, &key, seen) {
 			updateTCPStats(conn, stats.Cookie, tcp)
 		}
 		*buffer.Next() = *conn
 	}
 
-	if err := entries.Err(); err != nil {
-		return fmt.Errorf("unable to iterate connection map: %s", err)
-	}
-
 	t.telemetry.assign(tel)
 
 	return nil
@@ -330,6 +344,7 @@ func (t *kprobeTracer) Remove(conn *network.ConnectionStats) error {
 	}
 
 	t.telemetry.removeConnection(conn)
+	t.cache.remove(t.removeTuple)
 
 	// We have to remove the PID to remove the element from the TCP Map since we don't use the pid there
 	t.removeTuple.Pid = 0
@@ -339,20 +354,25 @@ func (t *kprobeTracer) Remove(conn *network.ConnectionStats) error {
 	return nil
 }
 
-func (t *kprobeTracer) GetTelemetry() map[string]int64 {
+func (t *kprobeTracer) readKernelTelemetry() *netebpf.Telemetry {
 	var zero uint64
+	telemetry := &netebpf.Telemetry{}
 	mp, _, err := t.m.GetMap(string(probes.TelemetryMap))
 	if err != nil {
 		log.Warnf("error retrieving telemetry map: %s", err)
-		return map[string]int64{}
+		return telemetry
 	}
 
-	telemetry := &netebpf.Telemetry{}
 	if err := mp.Lookup(unsafe.Pointer(&zero), unsafe.Pointer(telemetry)); err != nil {
 		// This can happen if we haven't initialized the telemetry object yet
 		// so let's just use a trace log
 		log.Tracef("error retrieving the telemetry struct: %s", err)
 	}
+	return telemetry
+}
+
+func (t *kprobeTracer) GetTelemetry() map[string]int64 {
+	telemetry := t.readKernelTelemetry()
 
 	closeStats := t.closeConsumer.GetStats()
 	pidCollisions := t.pidCollisions.Load()
@@ -362,12 +382,13 @@ func (t *kprobeTracer) GetTelemetry() map[string]int64 {
 		"closed_conn_polling_received": closeStats[perfReceivedStat],
 		"pid_collisions":               pidCollisions,
 
-		"tcp_sent_miscounts":         int64(telemetry.Tcp_sent_miscounts),
-		"missed_tcp_close":           int64(telemetry.Missed_tcp_close),
-		"missed_udp_close":           int64(telemetry.Missed_udp_close),
-		"udp_sends_processed":        int64(telemetry.Udp_sends_processed),
-		"udp_sends_missed":           int64(telemetry.Udp_sends_missed),
-		"conn_stats_max_entries_hit": int64(telemetry.Conn_stats_max_entries_hit),
+		"tcp_sent_miscounts":           int64(telemetry.Tcp_sent_miscounts),
+		"missed_tcp_close":             int64(telemetry.Missed_tcp_close),
+		"missed_udp_close":             int64(telemetry.Missed_udp_close),
+		"udp_sends_processed":          int64(telemetry.Udp_sends_processed),
+		"udp_sends_missed":             int64(telemetry.Udp_sends_missed),
+		"conn_stats_max_entries_hit":   int64(telemetry.Conn_stats_max_entries_hit),
+		"conn_changes_max_entries_hit": int64(telemetry.Conn_changes_max_entries_hit),
 	}
 
 	for k, v := range t.telemetry.get() {
@@ -444,9 +465,9 @@ func (t *kprobeTracer) getTCPStats(stats *netebpf.TCPStats, tuple *netebpf.ConnT
 	pid := tuple.Pid
 	tuple.Pid = 0
 
-	*stats = netebpf.TCPStats{}
-	err := t.tcpStats.Lookup(unsafe.Pointer(tuple), unsafe.Pointer(stats))
-	if err == nil {
+	var found bool
+	*stats, found = t.cache.getTCPStats(*tuple)
+	if found {
 		// This is required to avoid (over)reporting retransmits for connections sharing the same socket.
 		if _, reported := seen[*tuple]; reported {
 			t.pidCollisions.Inc()
@@ -283,6 +283,8 @@ func (e *ebpfConntracker) GetStats() map[string]int64 {
 		log.Tracef("error retrieving the telemetry struct: %s", err)
 	} else {
 		m["registers_total"] = int64(telemetry.Registers)
+		m["registers_dropped_total"] = int64(telemetry.Registers_dropped)
+		m["deletes_total"] = int64(telemetry.Deletes)
 	}
 
 	gets := e.stats.gets.Load()
@@ -365,6 +367,22 @@ func (e *ebpfConntracker) DumpCachedTable(ctx context.Context) (map[uint32][]net
 }
 
 func getManager(buf io.ReaderAt, maxStateSize int) (*manager.Manager, error) {
+	hashInsertProbe := manager.ProbeIdentificationPair{
+		EBPFSection:  string(probes.ConntrackHashInsert),
+		EBPFFuncName: "kprobe___nf_conntrack_hash_insert",
+		UID:          "conntracker",
+	}
+	deleteProbe := manager.ProbeIdentificationPair{
+		EBPFSection:  string(probes.ConntrackDelete),
+		EBPFFuncName: "kprobe_nf_ct_delete",
+		UID:          "conntracker",
+	}
+	fillInfoProbe := manager.ProbeIdentificationPair{
+		EBPFSection:  string(probes.ConntrackFillInfo),
+		EBPFFuncName: "kprobe_ctnetlink_fill_info",
+		UID:          "conntracker",
+	}
+
 	mgr := &manager.Manager{
 		Maps: []*manager.Map{
 			{Name: string(probes.ConntrackMap)},
@@ -372,20 +390,9 @@ func getManager(buf io.ReaderAt, maxStateSize int) (*manager.Manager, error) {
 		},
 		PerfMaps: []*manager.PerfMap{},
 		Probes: []*manager.Probe{
-			{
-				ProbeIdentificationPair: manager.ProbeIdentificationPair{
-					EBPFSection:  string(probes.ConntrackHashInsert),
-					EBPFFuncName: "kprobe___nf_conntrack_hash_insert",
-					UID:          "conntracker",
-				},
-			},
-			{
-				ProbeIdentificationPair: manager.ProbeIdentificationPair{
-					EBPFSection:  string(probes.ConntrackFillInfo),
-					EBPFFuncName: "kprobe_ctnetlink_fill_info",
-					UID:          "conntracker",
-				},
-			},
+			{ProbeIdentificationPair: hashInsertProbe},
+			{ProbeIdentificationPair: deleteProbe},
+			{ProbeIdentificationPair: fillInfoProbe},
 		},
 	}
 
@@ -403,6 +410,15 @@ func getManager(buf io.ReaderAt, maxStateSize int) (*manager.Manager, error) {
 		MapSpecEditors: map[string]manager.MapSpecEditor{
 			string(probes.ConntrackMap): {Type: ebpf.Hash, MaxEntries: uint32(maxStateSize), EditorFlag: manager.EditMaxEntries},
 		},
+		ActivatedProbes: []manager.ProbesSelector{
+			&manager.ProbeSelector{ProbeIdentificationPair: hashInsertProbe},
+			&manager.ProbeSelector{ProbeIdentificationPair: fillInfoProbe},
+			// nf_ct_delete can be inlined or not traceable on some kernels, DeleteTranslation then
+			// remains the only way translations are removed
+			&manager.BestEffort{Selectors: []manager.ProbesSelector{
+				&manager.ProbeSelector{ProbeIdentificationPair: deleteProbe},
+			}},
+		},
 	}
 
 	err := mgr.InitWithOptions(buf, opts)
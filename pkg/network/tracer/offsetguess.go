@@ -691,6 +691,87 @@ func guessOffsets(m *manager.Manager, cfg *config.Config) ([]manager.ConstantEdi
 	return getConstantEditors(status), nil
 }
 
+// validateOffsets checks a set of offsets guessed during a previous run with two events: the ports read
+// through the (struct socket)->sk pointer, which exercises offset_socket_sk, offset_sport and offset_dport,
+// and the network namespace, which exercises offset_netns and offset_ino
+func validateOffsets(m *manager.Manager, cfg *config.Config, editors []manager.ConstantEditor) error {
+	mp, _, err := m.GetMap(string(probes.TracerStatusMap))
+	if err != nil {
+		return fmt.Errorf("unable to find map %s: %s", string(probes.TracerStatusMap), err)
+	}
+
+	offsets := make(map[string]uint64, len(editors))
+	for _, editor := range editors {
+		if value, ok := editor.Value.(uint64); ok {
+			offsets[editor.Name] = value
+		}
+	}
+	status := &netebpf.TracerStatus{}
+	if err := setStatusOffsets(status, offsets); err != nil {
+		return err
+	}
+
+	// see guessOffsets
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	processName := filepath.Base(os.Args[0])
+	if len(processName) > netebpf.ProcCommMaxLen {
+		processName = processName[:netebpf.ProcCommMaxLen]
+	}
+	for i, ch := range processName {
+		status.Proc.Comm[i] = int8(ch)
+	}
+
+	eventGenerator, err := newEventGenerator(false)
+	if err != nil {
+		return err
+	}
+	defer eventGenerator.Close()
+
+	expected, err := expectedValues(eventGenerator.conn)
+	if err != nil {
+		return err
+	}
+
+	for _, what := range []netebpf.GuessWhat{netebpf.GuessSocketSK, netebpf.GuessNetNS} {
+		status.What = uint64(what)
+		status.State = uint64(netebpf.StateChecking)
+		if err := mp.Put(unsafe.Pointer(&zero), unsafe.Pointer(status)); err != nil {
+			return fmt.Errorf("error updating tracer_status: %v", err)
+		}
+
+		for retries := 10; ; retries-- {
+			if err := eventGenerator.Generate(status, expected); err != nil {
+				return err
+			}
+			if err := mp.Lookup(unsafe.Pointer(&zero), unsafe.Pointer(status)); err != nil {
+				return fmt.Errorf("error reading tracer_status: %v", err)
+			}
+			if netebpf.TracerState(status.State) == netebpf.StateChecked {
+				break
+			}
+			if retries == 0 {
+				return fmt.Errorf("no event received while validating %v", whatString[what])
+			}
+			time.Sleep(10 * time.Millisecond)
+		}
+
+		switch what {
+		case netebpf.GuessSocketSK:
+			if status.Sport_via_sk != htons(expected.sport) || status.Dport_via_sk != htons(expected.dport) {
+				return fmt.Errorf("invalid %v offset", whatString[what])
+			}
+		case netebpf.GuessNetNS:
+			if status.Err != 0 || status.Netns != expected.netns {
+				return fmt.Errorf("invalid %v offset", whatString[what])
+			}
+		}
+	}
+
+	return nil
+}
+
 func getConstantEditors(status *netebpf.TracerStatus) []manager.ConstantEditor {
 	return []manager.ConstantEditor{
 		{Name: "offset_saddr", Value: status.Offset_saddr},
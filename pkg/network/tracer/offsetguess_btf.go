@@ -0,0 +1,179 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package tracer
+
+import (
+	"fmt"
+
+	manager "github.com/DataDog/ebpf-manager"
+	"github.com/cilium/ebpf/btf"
+
+	"github.com/DataDog/datadog-agent/pkg/network/config"
+	netebpf "github.com/DataDog/datadog-agent/pkg/network/ebpf"
+)
+
+// btfField describes how to reach a field from the kernel struct that the guessed offset is relative to.
+// Anonymous structs and unions are traversed transparently.
+type btfField struct {
+	typeName string
+	path     []string
+}
+
+// btfOffsets derives the offsets of the tracer from the BTF of the running kernel, making offset guessing
+// unnecessary
+func btfOffsets(cfg *config.Config) ([]manager.ConstantEditor, error) {
+	spec, err := btf.LoadKernelSpec()
+	if err != nil {
+		return nil, err
+	}
+
+	status := &netebpf.TracerStatus{Ipv6_enabled: disabled}
+	if cfg.CollectIPv6Conns {
+		status.Ipv6_enabled = enabled
+	}
+
+	required := []struct {
+		offset *uint64
+		fields []btfField
+	}{
+		{&status.Offset_saddr, []btfField{{"sock", []string{"__sk_common", "skc_rcv_saddr"}}}},
+		{&status.Offset_daddr, []btfField{{"sock", []string{"__sk_common", "skc_daddr"}}}},
+		{&status.Offset_sport, []btfField{{"inet_sock", []string{"inet_sport"}}}},
+		{&status.Offset_dport, []btfField{{"sock", []string{"__sk_common", "skc_dport"}}}},
+		{&status.Offset_family, []btfField{{"sock", []string{"__sk_common", "skc_family"}}}},
+		{&status.Offset_netns, []btfField{{"sock", []string{"__sk_common", "skc_net"}}}},
+		{&status.Offset_ino, []btfField{{"net", []string{"ns", "inum"}}, {"net", []string{"proc_inum"}}}},
+		{&status.Offset_rtt, []btfField{{"tcp_sock", []string{"srtt_us"}}}},
+		{&status.Offset_rtt_var, []btfField{{"tcp_sock", []string{"mdev_us"}}}},
+		{&status.Offset_socket_sk, []btfField{{"socket", []string{"sk"}}}},
+	}
+	if cfg.CollectIPv6Conns {
+		required = append(required, struct {
+			offset *uint64
+			fields []btfField
+		}{&status.Offset_daddr_ipv6, []btfField{{"sock", []string{"__sk_common", "skc_v6_daddr"}}}})
+	}
+
+	for _, r := range required {
+		offset, err := btfFirstOffsetof(spec, r.fields)
+		if err != nil {
+			return nil, err
+		}
+		*r.offset = offset
+	}
+
+	// the flowi offsets are optional, the tracer falls back to the sock fields without them
+	status.Fl4_offsets = btfOptionalOffsets(spec, "flowi4",
+		&status.Offset_saddr_fl4, &status.Offset_daddr_fl4, &status.Offset_sport_fl4, &status.Offset_dport_fl4)
+	if cfg.CollectIPv6Conns {
+		status.Fl6_offsets = btfOptionalOffsets(spec, "flowi6",
+			&status.Offset_saddr_fl6, &status.Offset_daddr_fl6, &status.Offset_sport_fl6, &status.Offset_dport_fl6)
+	}
+
+	return getConstantEditors(status), nil
+}
+
+// btfOptionalOffsets resolves the source and destination addresses and ports of a flowi struct, and returns
+// whether all of them could be found
+func btfOptionalOffsets(spec *btf.Spec, typeName string, saddr, daddr, sport, dport *uint64) uint8 {
+	paths := [][]string{{"saddr"}, {"daddr"}, {"uli", "ports", "sport"}, {"uli", "ports", "dport"}}
+	offsets := []*uint64{saddr, daddr, sport, dport}
+	for i, path := range paths {
+		offset, err := btfOffsetof(spec, btfField{typeName, path})
+		if err != nil {
+			for _, o := range offsets {
+				*o = 0
+			}
+			return disabled
+		}
+		*offsets[i] = offset
+	}
+	return enabled
+}
+
+// btfFirstOffsetof returns the offset of the first field of the list that exists in the kernel
+func btfFirstOffsetof(spec *btf.Spec, fields []btfField) (uint64, error) {
+	var err error
+	for _, field := range fields {
+		var offset uint64
+		if offset, err = btfOffsetof(spec, field); err == nil {
+			return offset, nil
+		}
+	}
+	return 0, err
+}
+
+func btfOffsetof(spec *btf.Spec, field btfField) (uint64, error) {
+	types, err := spec.AnyTypesByName(field.typeName)
+	if err != nil {
+		return 0, err
+	}
+
+	for _, typ := range types {
+		if _, ok := typ.(*btf.Struct); !ok {
+			continue
+		}
+
+		offset, found := uint64(0), true
+		for _, name := range field.path {
+			var memberOffset uint64
+			if typ, memberOffset, found = btfMember(typ, name); !found {
+				break
+			}
+			offset += memberOffset
+		}
+		if found {
+			return offset, nil
+		}
+	}
+	return 0, fmt.Errorf("field %s.%v not found in kernel BTF", field.typeName, field.path)
+}
+
+// btfMember looks up a member of a struct or union, descending into anonymous members,
+// and returns its type and byte offset
+func btfMember(typ btf.Type, name string) (btf.Type, uint64, bool) {
+	var members []btf.Member
+	switch t := btfSkipQualifiers(typ).(type) {
+	case *btf.Struct:
+		members = t.Members
+	case *btf.Union:
+		members = t.Members
+	default:
+		return nil, 0, false
+	}
+
+	for _, m := range members {
+		if m.Name == name {
+			return m.Type, uint64(m.Offset.Bytes()), true
+		}
+		if m.Name == "" {
+			if memberType, offset, found := btfMember(m.Type, name); found {
+				return memberType, uint64(m.Offset.Bytes()) + offset, true
+			}
+		}
+	}
+	return nil, 0, false
+}
+
+func btfSkipQualifiers(typ btf.Type) btf.Type {
+	for {
+		switch t := typ.(type) {
+		case *btf.Typedef:
+			typ = t.Type
+		case *btf.Volatile:
+			typ = t.Type
+		case *btf.Const:
+			typ = t.Type
+		case *btf.Restrict:
+			typ = t.Type
+		default:
+			return typ
+		}
+	}
+}
@@ -0,0 +1,210 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package tracer
+
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+
+	manager "github.com/DataDog/ebpf-manager"
+	"golang.org/x/sys/unix"
+
+	"github.com/DataDog/datadog-agent/pkg/network/config"
+	netebpf "github.com/DataDog/datadog-agent/pkg/network/ebpf"
+	"github.com/DataDog/datadog-agent/pkg/util/log"
+	"github.com/DataDog/datadog-agent/pkg/util/native"
+)
+
+const (
+	offsetCacheFileName = "offsets.json"
+
+	// kernelNotesPath exposes the ELF notes of the running kernel, including its build ID
+	kernelNotesPath = "/sys/kernel/notes"
+	// ntGNUBuildID is the type of the ELF note holding the build ID
+	ntGNUBuildID = 3
+)
+
+// offsetCacheKey identifies the kernel and the offset guessing program that a set of offsets was guessed for
+type offsetCacheKey struct {
+	Release string `json:"release"`
+	Version string `json:"version"`
+	BuildID string `json:"build_id"`
+	// StatusLayout is a hash of the layout of tracer_status_t, which changes with offset-guess.h
+	StatusLayout string `json:"status_layout"`
+	IPv6         bool   `json:"ipv6"`
+}
+
+type offsetCacheEntry struct {
+	Key     offsetCacheKey    `json:"key"`
+	Offsets map[string]uint64 `json:"offsets"`
+}
+
+func newOffsetCacheKey(cfg *config.Config) (offsetCacheKey, error) {
+	var uname unix.Utsname
+	if err := unix.Uname(&uname); err != nil {
+		return offsetCacheKey{}, fmt.Errorf("unable to get kernel release: %w", err)
+	}
+
+	buildID, err := kernelBuildID(kernelNotesPath)
+	if err != nil {
+		// the release and version strings are enough on most distributions
+		log.Debugf("unable to read the kernel build ID: %s", err)
+	}
+
+	return offsetCacheKey{
+		Release:      unix.ByteSliceToString(uname.Release[:]),
+		Version:      unix.ByteSliceToString(uname.Version[:]),
+		BuildID:      buildID,
+		StatusLayout: tracerStatusLayout(),
+		IPv6:         cfg.CollectIPv6Conns,
+	}, nil
+}
+
+// tracerStatusLayout returns a hash of the name, offset and size of the fields of tracer_status_t
+func tracerStatusLayout() string {
+	h := sha256.New()
+	t := reflect.TypeOf(netebpf.TracerStatus{})
+	for i := 0; i < t.NumField(); i++ {
+		f := t.Field(i)
+		fmt.Fprintf(h, "%s:%d:%d;", f.Name, f.Offset, f.Type.Size())
+	}
+	return hex.EncodeToString(h.Sum(nil))
+}
+
+// kernelBuildID extracts the GNU build ID from the ELF notes of the kernel
+func kernelBuildID(notesPath string) (string, error) {
+	notes, err := ioutil.ReadFile(notesPath)
+	if err != nil {
+		return "", err
+	}
+
+	align4 := func(n uint32) uint32 { return (n + 3) &^ 3 }
+	for len(notes) >= 12 {
+		nameSize := native.Endian.Uint32(notes[0:4])
+		descSize := native.Endian.Uint32(notes[4:8])
+		noteType := native.Endian.Uint32(notes[8:12])
+		notes = notes[12:]
+
+		nameEnd, descEnd := align4(nameSize), align4(nameSize)+align4(descSize)
+		if uint32(len(notes)) < descEnd {
+			break
+		}
+
+		name := bytes.TrimRight(notes[:nameSize], "\x00")
+		if noteType == ntGNUBuildID && string(name) == "GNU" {
+			return hex.EncodeToString(notes[nameEnd : nameEnd+descSize]), nil
+		}
+		notes = notes[descEnd:]
+	}
+	return "", fmt.Errorf("no build ID note found in %s", notesPath)
+}
+
+// loadCachedOffsets returns the offsets persisted for the given key, if any
+func loadCachedOffsets(dir string, key offsetCacheKey) ([]manager.ConstantEditor, bool) {
+	if dir == "" {
+		return nil, false
+	}
+
+	content, err := ioutil.ReadFile(filepath.Join(dir, offsetCacheFileName))
+	if err != nil {
+		if !os.IsNotExist(err) {
+			log.Warnf("unable to read the offset cache: %s", err)
+		}
+		return nil, false
+	}
+
+	var entry offsetCacheEntry
+	if err := json.Unmarshal(content, &entry); err != nil {
+		log.Warnf("unable to parse the offset cache: %s", err)
+		return nil, false
+	}
+
+	if entry.Key != key {
+		log.Debugf("offset cache is stale: cached for %+v, running %+v", entry.Key, key)
+		return nil, false
+	}
+
+	status := &netebpf.TracerStatus{}
+	if err := setStatusOffsets(status, entry.Offsets); err != nil {
+		log.Warnf("invalid offset cache: %s", err)
+		return nil, false
+	}
+	return getConstantEditors(status), true
+}
+
+// storeCachedOffsets persists the offsets for the given key. The file is replaced atomically so that a
+// crash during the write doesn't leave a truncated cache behind.
+func storeCachedOffsets(dir string, key offsetCacheKey, editors []manager.ConstantEditor) error {
+	if dir == "" {
+		return nil
+	}
+
+	entry := offsetCacheEntry{
+		Key:     key,
+		Offsets: make(map[string]uint64, len(editors)),
+	}
+	for _, editor := range editors {
+		value, ok := editor.Value.(uint64)
+		if !ok {
+			return fmt.Errorf("unexpected type %T for constant %s", editor.Value, editor.Name)
+		}
+		entry.Offsets[editor.Name] = value
+	}
+
+	content, err := json.Marshal(entry)
+	if err != nil {
+		return err
+	}
+
+	if err := os.MkdirAll(dir, 0755); err != nil {
+		return err
+	}
+
+	tmpFile, err := ioutil.TempFile(dir, offsetCacheFileName+".*")
+	if err != nil {
+		return err
+	}
+	defer os.Remove(tmpFile.Name())
+
+	if _, err := tmpFile.Write(content); err != nil {
+		tmpFile.Close()
+		return err
+	}
+	if err := tmpFile.Close(); err != nil {
+		return err
+	}
+	return os.Rename(tmpFile.Name(), filepath.Join(dir, offsetCacheFileName))
+}
+
+// setStatusOffsets fills the fields of the status from the values of the constant editors returned by
+// getConstantEditors, whose names match the field names of tracer_status_t
+func setStatusOffsets(status *netebpf.TracerStatus, offsets map[string]uint64) error {
+	v := reflect.ValueOf(status).Elem()
+	for _, editor := range getConstantEditors(status) {
+		value, ok := offsets[editor.Name]
+		if !ok {
+			return fmt.Errorf("missing constant %s", editor.Name)
+		}
+
+		field := v.FieldByName(strings.ToUpper(editor.Name[:1]) + editor.Name[1:])
+		if !field.IsValid() {
+			return fmt.Errorf("unknown constant %s", editor.Name)
+		}
+		field.SetUint(value)
+	}
+	return nil
+}
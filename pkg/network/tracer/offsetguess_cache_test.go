@@ -0,0 +1,96 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux_bpf
+// +build linux_bpf
+
+package tracer
+
+import (
+	"encoding/binary"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+
+	netebpf "github.com/DataDog/datadog-agent/pkg/network/ebpf"
+	"github.com/DataDog/datadog-agent/pkg/util/native"
+)
+
+func TestOffsetCacheRoundTrip(t *testing.T) {
+	dir := t.TempDir()
+	key := offsetCacheKey{
+		Release:      "5.15.0-1019-aws",
+		Version:      "#23~20.04.1-Ubuntu SMP",
+		BuildID:      "0123456789abcdef",
+		StatusLayout: tracerStatusLayout(),
+		IPv6:         true,
+	}
+
+	status := &netebpf.TracerStatus{
+		Offset_saddr:     4,
+		Offset_daddr:     0,
+		Offset_sport:     782,
+		Offset_dport:     12,
+		Offset_netns:     48,
+		Offset_ino:       136,
+		Offset_socket_sk: 24,
+		Ipv6_enabled:     enabled,
+		Fl4_offsets:      enabled,
+		Offset_dport_fl4: 40,
+	}
+	editors := getConstantEditors(status)
+	require.NoError(t, storeCachedOffsets(dir, key, editors))
+
+	cached, ok := loadCachedOffsets(dir, key)
+	require.True(t, ok)
+	assert.Equal(t, editors, cached)
+
+	// a different kernel must not reuse the offsets
+	otherKey := key
+	otherKey.BuildID = "fedcba9876543210"
+	_, ok = loadCachedOffsets(dir, otherKey)
+	assert.False(t, ok)
+
+	// neither must a corrupted cache
+	require.NoError(t, os.WriteFile(filepath.Join(dir, offsetCacheFileName), []byte("{"), 0644))
+	_, ok = loadCachedOffsets(dir, key)
+	assert.False(t, ok)
+}
+
+func TestKernelBuildID(t *testing.T) {
+	note := func(name string, noteType uint32, desc []byte) []byte {
+		nameBytes := append([]byte(name), 0)
+		buf := make([]byte, 12)
+		native.Endian.PutUint32(buf[0:4], uint32(len(nameBytes)))
+		native.Endian.PutUint32(buf[4:8], uint32(len(desc)))
+		native.Endian.PutUint32(buf[8:12], noteType)
+		buf = append(buf, nameBytes...)
+		for len(buf)%4 != 0 {
+			buf = append(buf, 0)
+		}
+		buf = append(buf, desc...)
+		for len(buf)%4 != 0 {
+			buf = append(buf, 0)
+		}
+		return buf
+	}
+
+	xenNote := note("Xen", 6, make([]byte, binary.Size(uint64(0))))
+	buildIDNote := note("GNU", ntGNUBuildID, []byte{0xde, 0xad, 0xbe, 0xef, 0x42})
+
+	notesPath := filepath.Join(t.TempDir(), "notes")
+	require.NoError(t, os.WriteFile(notesPath, append(xenNote, buildIDNote...), 0644))
+
+	buildID, err := kernelBuildID(notesPath)
+	require.NoError(t, err)
+	assert.Equal(t, "deadbeef42", buildID)
+
+	require.NoError(t, os.WriteFile(notesPath, xenNote, 0644))
+	_, err = kernelBuildID(notesPath)
+	assert.Error(t, err)
+}
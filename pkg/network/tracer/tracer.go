@@ -118,6 +118,8 @@ func NewTracer(config *config.Config) (*Tracer, error) {
 		config.EnableHTTPSMonitoring = false
 	}
 
+	precompileRuntimeAssets(config)
+
 	offsetBuf, err := netebpf.ReadOffsetBPFModule(config.BPFDir, config.BPFDebug)
 	if err != nil {
 		return nil, fmt.Errorf("could not read offset bpf module: %s", err)
@@ -253,6 +255,32 @@ func newReverseDNS(c *config.Config) dns.ReverseDNS {
 }
 
 func runOffsetGuessing(config *config.Config, buf bytecode.AssetReader) ([]manager.ConstantEditor, error) {
+	start := time.Now()
+
+	// Offsets derived from the kernel BTF, or guessed by a previous run on the same kernel, only need
+	// to be validated, which is much faster than guessing them
+	type offsetCandidate struct {
+		source  string
+		editors []manager.ConstantEditor
+	}
+	var candidates []offsetCandidate
+
+	if editors, err := btfOffsets(config); err == nil {
+		candidates = append(candidates, offsetCandidate{"BTF", editors})
+	} else {
+		log.Debugf("unable to resolve socket struct offsets from BTF: %s", err)
+	}
+
+	cacheDir := config.OffsetGuessCacheDir
+	cacheKey, err := newOffsetCacheKey(config)
+	if err != nil {
+		log.Warnf("offset cache disabled: %s", err)
+		cacheDir = ""
+	}
+	if editors, ok := loadCachedOffsets(cacheDir, cacheKey); ok {
+		candidates = append(candidates, offsetCandidate{"cache", editors})
+	}
+
 	// Enable kernel probes used for offset guessing.
 	offsetMgr := newOffsetManager()
 	offsetOptions := manager.Options{
@@ -295,12 +323,25 @@ func runOffsetGuessing(config *config.Config, buf bytecode.AssetReader) ([]manag
 			log.Warnf("error stopping offset ebpf manager: %s", err)
 		}
 	}()
-	start := time.Now()
+	for _, candidate := range candidates {
+		err := validateOffsets(offsetMgr, config, candidate.editors)
+		if err == nil {
+			log.Infof("socket struct offsets loaded from %s (took %v)", candidate.source, time.Since(start))
+			return candidate.editors, nil
+		}
+		log.Infof("socket struct offsets loaded from %s are invalid: %s", candidate.source, err)
+	}
+
+	start = time.Now()
 	editors, err := guessOffsets(offsetMgr, config)
 	if err != nil {
 		return nil, err
 	}
 	log.Infof("socket struct offset guessing complete (took %v)", time.Since(start))
+
+	if err := storeCachedOffsets(cacheDir, cacheKey, editors); err != nil {
+		log.Warnf("unable to persist the guessed offsets: %s", err)
+	}
 	return editors, nil
 }
 
@@ -65,6 +65,16 @@ type Config struct {
 	// LoadControllerControlPeriod defines the period at which the load controller will empty the user space counter used
 	// to evaluate the amount of events brought back to user space
 	LoadControllerControlPeriod time.Duration
+	// EventRateLimiterEnabled defines if the in-kernel event rate limiter should be enabled
+	EventRateLimiterEnabled bool
+	// EventRateLimiterRate defines the amount of events per second a process is allowed to send for each rate limited
+	// event type. It must be positive when the rate limiter is enabled
+	EventRateLimiterRate int
+	// EventRateLimiterBurst defines the maximum burst of events a process can send for each rate limited event type. It
+	// must be at least 1 when the rate limiter is enabled
+	EventRateLimiterBurst int
+	// EventRateLimiterEventTypes defines the list of event types that are subject to the in-kernel event rate limiter
+	EventRateLimiterEventTypes []model.EventType
 	// StatsPollingInterval determines how often metrics should be polled
 	StatsPollingInterval time.Duration
 	// StatsTagsCardinality determines the cardinality level of the tags added to the exported metrics
@@ -146,6 +156,13 @@ type Config struct {
 	// ActivityDumpSyscallMonitorPeriod defines the minimum amount of time to wait between 2 syscalls event for the same
 	// process.
 	ActivityDumpSyscallMonitorPeriod time.Duration
+	// ActivityDumpStreamEnabled defines if active dumps should be incrementally written to disk and released from
+	// memory, instead of being kept in memory until they are persisted.
+	ActivityDumpStreamEnabled bool
+	// ActivityDumpStreamFlushPeriod defines the period at which the new nodes of active dumps are written to disk
+	ActivityDumpStreamFlushPeriod time.Duration
+	// ActivityDumpStreamDirectory defines the directory in which the streams of active dumps are written
+	ActivityDumpStreamDirectory string
 
 	// RuntimeMonitor defines if the runtime monitor should be enabled
 	RuntimeMonitor bool
@@ -208,6 +225,10 @@ func NewConfig(cfg *config.Config) (*Config, error) {
 		LoadControllerEventsCountThreshold: int64(coreconfig.Datadog.GetInt("runtime_security_config.load_controller.events_count_threshold")),
 		LoadControllerDiscarderTimeout:     time.Duration(coreconfig.Datadog.GetInt("runtime_security_config.load_controller.discarder_timeout")) * time.Second,
 		LoadControllerControlPeriod:        time.Duration(coreconfig.Datadog.GetInt("runtime_security_config.load_controller.control_period")) * time.Second,
+		EventRateLimiterEnabled:            coreconfig.Datadog.GetBool("runtime_security_config.event_rate_limiter.enabled"),
+		EventRateLimiterRate:               coreconfig.Datadog.GetInt("runtime_security_config.event_rate_limiter.rate"),
+		EventRateLimiterBurst:              coreconfig.Datadog.GetInt("runtime_security_config.event_rate_limiter.burst"),
+		EventRateLimiterEventTypes:         model.ParseEventTypeStringSlice(coreconfig.Datadog.GetStringSlice("runtime_security_config.event_rate_limiter.event_types")),
 		StatsPollingInterval:               time.Duration(coreconfig.Datadog.GetInt("runtime_security_config.events_stats.polling_interval")) * time.Second,
 		StatsTagsCardinality:               coreconfig.Datadog.GetString("runtime_security_config.events_stats.tags_cardinality"),
 		StatsdAddr:                         fmt.Sprintf("%s:%d", cfg.StatsdHost, cfg.StatsdPort),
@@ -252,6 +273,9 @@ func NewConfig(cfg *config.Config) (*Config, error) {
 		ActivityDumpRemoteStorageCompression:  coreconfig.Datadog.GetBool("runtime_security_config.activity_dump.remote_storage.compression"),
 		ActivityDumpSyscallMonitor:            coreconfig.Datadog.GetBool("runtime_security_config.activity_dump.syscall_monitor.enabled"),
 		ActivityDumpSyscallMonitorPeriod:      time.Duration(coreconfig.Datadog.GetInt("runtime_security_config.activity_dump.syscall_monitor.period")) * time.Second,
+		ActivityDumpStreamEnabled:             coreconfig.Datadog.GetBool("runtime_security_config.activity_dump.stream.enabled"),
+		ActivityDumpStreamFlushPeriod:         time.Duration(coreconfig.Datadog.GetInt("runtime_security_config.activity_dump.stream.flush_period")) * time.Second,
+		ActivityDumpStreamDirectory:           coreconfig.Datadog.GetString("runtime_security_config.activity_dump.stream.output_directory"),
 	}
 
 	// if runtime is enabled then we force fim
@@ -322,6 +346,10 @@ func NewConfig(cfg *config.Config) (*Config, error) {
 		c.ActivityDumpCgroupWaitListSize = c.ActivityDumpTracedCgroupsCount
 	}
 
+	if c.ActivityDumpStreamEnabled && (c.ActivityDumpStreamFlushPeriod <= 0 || len(c.ActivityDumpStreamDirectory) == 0) {
+		return nil, fmt.Errorf("invalid activity dump stream configuration: runtime_security_config.activity_dump.stream.flush_period and runtime_security_config.activity_dump.stream.output_directory are required")
+	}
+
 	lazyInterfaces := make(map[string]bool)
 	for _, name := range c.NetworkLazyInterfacePrefixes {
 		lazyInterfaces[name] = true
@@ -338,6 +366,17 @@ func NewConfig(cfg *config.Config) (*Config, error) {
 		return nil, fmt.Errorf("runtime_security_config.event_stream.buffer_size must be a power of 2 and a multiple of %d", os.Getpagesize())
 	}
 
+	if c.EventRateLimiterEnabled {
+		// the rate and the burst are handed to the kernel as unsigned constants
+		if c.EventRateLimiterRate <= 0 {
+			return nil, fmt.Errorf("runtime_security_config.event_rate_limiter.rate must be positive when the event rate limiter is enabled")
+		}
+		// a token bucket smaller than one event would drop every event of the rate limited event types
+		if c.EventRateLimiterBurst < 1 {
+			return nil, fmt.Errorf("runtime_security_config.event_rate_limiter.burst must be at least 1 when the event rate limiter is enabled")
+		}
+	}
+
 	setEnv()
 	return c, nil
 }
@@ -101,7 +101,7 @@ __attribute__((always_inline)) u64 update_traced_pid_timeout(u32 pid, u64 new_ti
 
 struct cgroup_tracing_event_t {
     struct kevent_t event;
-    struct container_context_t container;
+    char container_id[CONTAINER_ID_LEN];
     u64 timeout;
 };
 
@@ -120,7 +120,7 @@ __attribute__((always_inline)) struct cgroup_tracing_event_t *get_cgroup_tracing
     if (evt == NULL) {
         return 0;
     }
-    evt->container.container_id[0] = 0;
+    evt->container_id[0] = 0;
     return evt;
 }
 
@@ -209,7 +209,7 @@ __attribute__((always_inline)) u64 trace_new_cgroup(void *ctx, char cgroup[CONTA
         // should never happen, ignore
         return 0;
     }
-    copy_container_id(cgroup, evt->container.container_id);
+    copy_container_id(cgroup, evt->container_id);
     evt->timeout = timeout;
     send_event_ptr(ctx, EVENT_CGROUP_TRACING, evt);
 
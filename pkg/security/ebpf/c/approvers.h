@@ -23,6 +23,7 @@ struct bpf_map_def SEC("maps/basename_approvers") basename_approvers = {
 };
 
 void get_dentry_name(struct dentry *dentry, void *buffer, size_t n);
+struct dentry *get_vfsmount_dentry(struct vfsmount *mnt);
 
 int __attribute__((always_inline)) approve_by_basename(struct dentry *dentry, u64 event_type) {
     struct basename_t basename = {};
@@ -35,6 +36,76 @@ int __attribute__((always_inline)) approve_by_basename(struct dentry *dentry, u6
     return 0;
 }
 
+#define PARENT_NAME_FILTER_SIZE 64
+#define PARENT_NAME_APPROVER_MAX_DEPTH 4
+
+// parent name approvers match the directory components of a path prefix, starting from the parent of the file. A
+// prefix such as /etc/ssh/ is stored as {depth: 1, "ssh"} with the event set in event_mask, and {depth: 2, "etc"} with
+// the event set in last_mask. Entries of different prefixes can combine, which can only approve more events than
+// required, never less.
+struct parent_name_t {
+    u32 depth;
+    char value[PARENT_NAME_FILTER_SIZE];
+};
+
+struct parent_name_filter_t {
+    u64 event_mask;
+    u64 last_mask;
+};
+
+struct bpf_map_def SEC("maps/parent_name_approvers") parent_name_approvers = {
+    .type = BPF_MAP_TYPE_HASH,
+    .key_size = sizeof(struct parent_name_t),
+    .value_size = sizeof(struct parent_name_filter_t),
+    .max_entries = 1024,
+    .pinning = 0,
+    .namespace = "",
+};
+
+int __attribute__((always_inline)) approve_by_parent_name(struct dentry *dentry, struct path *path, u64 event_type) {
+    if (path == NULL) {
+        return 1;
+    }
+
+    struct vfsmount *mnt;
+    bpf_probe_read(&mnt, sizeof(mnt), &path->mnt);
+    struct dentry *mnt_root = get_vfsmount_dentry(mnt);
+    struct dentry *d_parent;
+    u64 event_mask = 1 << (event_type-1);
+
+#pragma unroll
+    for (int i = 1; i <= PARENT_NAME_APPROVER_MAX_DEPTH; i++) {
+        // the path prefix can't be checked across mount points, let user space decide
+        if (dentry == mnt_root) {
+            return 1;
+        }
+
+        bpf_probe_read(&d_parent, sizeof(d_parent), &dentry->d_parent);
+        if (d_parent == dentry) {
+            return 1;
+        }
+        dentry = d_parent;
+
+        struct parent_name_t key = {
+            .depth = i,
+        };
+        get_dentry_name(dentry, &key.value, sizeof(key.value));
+
+        struct parent_name_filter_t *filter = bpf_map_lookup_elem(&parent_name_approvers, &key);
+        if (filter == NULL) {
+            return 0;
+        }
+        if (filter->last_mask & event_mask) {
+            return 1;
+        }
+        if ((filter->event_mask & event_mask) == 0) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
 int __attribute__((always_inline)) basename_approver(struct syscall_cache_t *syscall, struct dentry *dentry, u64 event_type) {
     if ((syscall->policy.flags & BASENAME) > 0) {
         return approve_by_basename(dentry, event_type);
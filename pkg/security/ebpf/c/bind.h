@@ -24,15 +24,15 @@ SYSCALL_KPROBE3(bind, int, socket, struct sockaddr*, addr, unsigned int, addr_le
     }
 
     /* cache the bind and wait to grab the retval to send it */
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_BIND,
     };
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
 int __attribute__((always_inline)) sys_bind_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_BIND);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_BIND);
     if (!syscall) {
         return 0;
     }
@@ -87,7 +87,7 @@ int kprobe_security_socket_bind(struct pt_regs *ctx) {
     }
 
     // fill syscall_cache if necessary
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_BIND);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_BIND);
     if (syscall) {
         syscall->bind.addr[0] = key.addr[0];
         syscall->bind.addr[1] = key.addr[1];
@@ -136,7 +136,7 @@ struct bpf_map_def SEC("maps/tgid_fd_prog_id") tgid_fd_prog_id = {
     .namespace = "",
 };
 
-__attribute__((always_inline)) void save_obj_fd(struct syscall_cache_t *syscall) {
+__attribute__((always_inline)) void save_obj_fd(struct compact_syscall_cache_t *syscall) {
     struct bpf_tgid_fd_t key = {
         .tgid = bpf_get_current_pid_tgid() >> 32,
         .fd = syscall->bpf.retval,
@@ -184,7 +184,7 @@ __attribute__((always_inline)) u32 fetch_prog_id(int fd) {
     return *map_id;
 }
 
-__attribute__((always_inline)) void populate_map_id_and_prog_id(struct syscall_cache_t *syscall) {
+__attribute__((always_inline)) void populate_map_id_and_prog_id(struct compact_syscall_cache_t *syscall) {
     int fd = 0;
 
     switch (syscall->bpf.cmd) {
@@ -261,7 +261,7 @@ __attribute__((always_inline)) void populate_map_id_and_prog_id(struct syscall_c
     }
 }
 
-__attribute__((always_inline)) void fill_from_syscall_args(struct syscall_cache_t *syscall, struct bpf_event_t *event) {
+__attribute__((always_inline)) void fill_from_syscall_args(struct compact_syscall_cache_t *syscall, struct bpf_event_t *event) {
     switch (event->cmd) {
     case BPF_MAP_CREATE:
         bpf_probe_read(&event->map.map_type, sizeof(event->map.map_type), &syscall->bpf.attr->map_type);
@@ -275,7 +275,7 @@ __attribute__((always_inline)) void fill_from_syscall_args(struct syscall_cache_
     }
 }
 
-__attribute__((always_inline)) void send_bpf_event(void *ctx, struct syscall_cache_t *syscall) {
+__attribute__((always_inline)) void send_bpf_event(void *ctx, struct compact_syscall_cache_t *syscall) {
     struct bpf_event_t event = {
         .syscall.retval = syscall->bpf.retval,
         .event.async = 0,
@@ -321,7 +321,7 @@ SYSCALL_KPROBE3(bpf, int, cmd, union bpf_attr __user *, uattr, unsigned int, siz
         return 0;
     }
 
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_BPF,
         .bpf = {
             .cmd = cmd,
@@ -329,13 +329,13 @@ SYSCALL_KPROBE3(bpf, int, cmd, union bpf_attr __user *, uattr, unsigned int, siz
     };
     bpf_probe_read(&syscall.bpf.attr, sizeof(syscall.bpf.attr), &uattr);
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
 
     return 0;
 }
 
 __attribute__((always_inline)) int sys_bpf_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_BPF);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_BPF);
     if (!syscall) {
         return 0;
     }
@@ -366,7 +366,7 @@ int tracepoint_syscalls_sys_exit_bpf(struct tracepoint_syscalls_sys_exit_t *args
 
 SEC("kprobe/security_bpf_map")
 int kprobe_security_bpf_map(struct pt_regs *ctx) {
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_BPF);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_BPF);
     if (!syscall) {
         return 0;
     }
@@ -389,7 +389,7 @@ int kprobe_security_bpf_map(struct pt_regs *ctx) {
 
 SEC("kprobe/security_bpf_prog")
 int kprobe_security_bpf_prog(struct pt_regs *ctx) {
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_BPF);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_BPF);
     if (!syscall) {
         return 0;
     }
@@ -424,7 +424,7 @@ int kprobe_security_bpf_prog(struct pt_regs *ctx) {
 SEC("kprobe/check_helper_call")
 int kprobe_check_helper_call(struct pt_regs *ctx) {
     int func_id = 0;
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_BPF);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_BPF);
     if (!syscall) {
         return 0;
     }
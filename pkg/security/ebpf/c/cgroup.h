@@ -122,6 +122,10 @@ static __attribute__((always_inline)) int trace__cgroup_write(struct pt_regs *ct
         return 0;
     }
 
+    // events only carry the cookie of the container, push its ID to user space once
+    new_entry.container.cookie = hash_container_id(new_entry.container.container_id);
+    bpf_map_update_elem(&container_ids, &new_entry.container.cookie, new_entry.container.container_id, BPF_ANY);
+
     bpf_map_update_elem(&proc_cache, &cookie, &new_entry, BPF_ANY);
 
     if (new_cookie) {
@@ -31,11 +31,11 @@ struct capset_event_t {
 };
 
 int __attribute__((always_inline)) credentials_update(u64 type) {
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = type,
     };
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
@@ -43,8 +43,8 @@ int __attribute__((always_inline)) credentials_predicate(u64 type) {
     return type == EVENT_SETUID || type == EVENT_SETGID || type == EVENT_CAPSET;
 }
 
-int __attribute__((always_inline)) credentials_update_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall_with(credentials_predicate);
+int __attribute__((always_inline)) credentials_update_ret(void *ctx, int retval, u64 type) {
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall_with(credentials_predicate, type);
     if (!syscall) {
         return 0;
     }
@@ -100,9 +100,9 @@ int __attribute__((always_inline)) credentials_update_ret(void *ctx, int retval)
     return 0;
 }
 
-int __attribute__((always_inline)) kprobe_credentials_update_ret(struct pt_regs *ctx) {
+int __attribute__((always_inline)) kprobe_credentials_update_ret(struct pt_regs *ctx, u64 type) {
     int retval = PT_REGS_RC(ctx);
-    return credentials_update_ret(ctx, retval);
+    return credentials_update_ret(ctx, retval, type);
 }
 
 SYSCALL_KPROBE0(setuid) {
@@ -110,12 +110,12 @@ SYSCALL_KPROBE0(setuid) {
 }
 
 SYSCALL_KRETPROBE(setuid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setuid")
 int tracepoint_syscalls_sys_exit_setuid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(seteuid) {
@@ -123,12 +123,12 @@ SYSCALL_KPROBE0(seteuid) {
 }
 
 SYSCALL_KRETPROBE(seteuid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_seteuid")
 int tracepoint_syscalls_sys_exit_seteuid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setfsuid) {
@@ -136,12 +136,12 @@ SYSCALL_KPROBE0(setfsuid) {
 }
 
 SYSCALL_KRETPROBE(setfsuid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setfsuid")
 int tracepoint_syscalls_sys_exit_setfsuid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setreuid) {
@@ -149,12 +149,12 @@ SYSCALL_KPROBE0(setreuid) {
 }
 
 SYSCALL_KRETPROBE(setreuid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setreuid")
 int tracepoint_syscalls_sys_exit_setreuid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setresuid) {
@@ -162,12 +162,12 @@ SYSCALL_KPROBE0(setresuid) {
 }
 
 SYSCALL_KRETPROBE(setresuid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setresuid")
 int tracepoint_syscalls_sys_exit_setresuid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setuid16) {
@@ -175,12 +175,12 @@ SYSCALL_KPROBE0(setuid16) {
 }
 
 SYSCALL_KRETPROBE(setuid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setuid16")
 int tracepoint_syscalls_sys_exit_setuid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(seteuid16) {
@@ -188,12 +188,12 @@ SYSCALL_KPROBE0(seteuid16) {
 }
 
 SYSCALL_KRETPROBE(seteuid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_seteuid16")
 int tracepoint_syscalls_sys_exit_seteuid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setfsuid16) {
@@ -201,12 +201,12 @@ SYSCALL_KPROBE0(setfsuid16) {
 }
 
 SYSCALL_KRETPROBE(setfsuid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setfsuid16")
 int tracepoint_syscalls_sys_exit_setfsuid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setreuid16) {
@@ -214,12 +214,12 @@ SYSCALL_KPROBE0(setreuid16) {
 }
 
 SYSCALL_KRETPROBE(setreuid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setreuid16")
 int tracepoint_syscalls_sys_exit_setreuid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setresuid16) {
@@ -227,12 +227,12 @@ SYSCALL_KPROBE0(setresuid16) {
 }
 
 SYSCALL_KRETPROBE(setresuid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETUID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setresuid16")
 int tracepoint_syscalls_sys_exit_setresuid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETUID);
 }
 
 SYSCALL_KPROBE0(setgid) {
@@ -240,12 +240,12 @@ SYSCALL_KPROBE0(setgid) {
 }
 
 SYSCALL_KRETPROBE(setgid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setgid")
 int tracepoint_syscalls_sys_exit_setgid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setegid) {
@@ -253,12 +253,12 @@ SYSCALL_KPROBE0(setegid) {
 }
 
 SYSCALL_KRETPROBE(setegid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setegid")
 int tracepoint_syscalls_sys_exit_setegid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setfsgid) {
@@ -266,12 +266,12 @@ SYSCALL_KPROBE0(setfsgid) {
 }
 
 SYSCALL_KRETPROBE(setfsgid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setfsgid")
 int tracepoint_syscalls_sys_exit_setfsgid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setregid) {
@@ -279,12 +279,12 @@ SYSCALL_KPROBE0(setregid) {
 }
 
 SYSCALL_KRETPROBE(setregid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setregid")
 int tracepoint_syscalls_sys_exit_setregid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setresgid) {
@@ -292,12 +292,12 @@ SYSCALL_KPROBE0(setresgid) {
 }
 
 SYSCALL_KRETPROBE(setresgid) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setresgid")
 int tracepoint_syscalls_sys_exit_setresgid(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setgid16) {
@@ -305,12 +305,12 @@ SYSCALL_KPROBE0(setgid16) {
 }
 
 SYSCALL_KRETPROBE(setgid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setgid16")
 int tracepoint_syscalls_sys_exit_setgid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setegid16) {
@@ -318,12 +318,12 @@ SYSCALL_KPROBE0(setegid16) {
 }
 
 SYSCALL_KRETPROBE(setegid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setegid16")
 int tracepoint_syscalls_sys_exit_setegid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setfsgid16) {
@@ -331,12 +331,12 @@ SYSCALL_KPROBE0(setfsgid16) {
 }
 
 SYSCALL_KRETPROBE(setfsgid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setfsgid16")
 int tracepoint_syscalls_sys_exit_setfsgid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setregid16) {
@@ -344,12 +344,12 @@ SYSCALL_KPROBE0(setregid16) {
 }
 
 SYSCALL_KRETPROBE(setregid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setregid16")
 int tracepoint_syscalls_sys_exit_setregid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(setresgid16) {
@@ -357,12 +357,12 @@ SYSCALL_KPROBE0(setresgid16) {
 }
 
 SYSCALL_KRETPROBE(setresgid16) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_SETGID);
 }
 
 SEC("tracepoint/syscalls/sys_exit_setresgid16")
 int tracepoint_syscalls_sys_exit_setresgid16(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_SETGID);
 }
 
 SYSCALL_KPROBE0(capset) {
@@ -370,17 +370,18 @@ SYSCALL_KPROBE0(capset) {
 }
 
 SYSCALL_KRETPROBE(capset) {
-    return kprobe_credentials_update_ret(ctx);
+    return kprobe_credentials_update_ret(ctx, EVENT_CAPSET);
 }
 
 SEC("tracepoint/syscalls/sys_exit_capset")
 int tracepoint_syscalls_sys_exit_capset(struct tracepoint_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    return credentials_update_ret(args, args->ret, EVENT_CAPSET);
 }
 
 SEC("tracepoint/handle_sys_commit_creds_exit")
 int tracepoint_handle_sys_commit_creds_exit(struct tracepoint_raw_syscalls_sys_exit_t *args) {
-    return credentials_update_ret(args, args->ret);
+    // shared by the credentials syscalls, the tail call was made for the newest cached type
+    return credentials_update_ret(args, args->ret, peek_syscall_type());
 }
 
 struct cred_ids {
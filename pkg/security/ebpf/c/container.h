@@ -1,10 +1,40 @@
 #ifndef _CONTAINER_H_
 #define _CONTAINER_H_
 
+// container_ids resolves the container cookies carried by the events to their container ID. An entry is only pushed
+// when a process is moved into a container cgroup (trace__cgroup_write): forked and executed processes inherit the
+// cookie of their parent, and user space registers the cookies of the processes found during the snapshot itself.
+// User space looks it up the first time it sees a cookie.
+struct bpf_map_def SEC("maps/container_ids") container_ids = {
+    .type = BPF_MAP_TYPE_LRU_HASH,
+    .key_size = sizeof(u64),
+    .value_size = CONTAINER_ID_LEN,
+    .max_entries = 4096,
+    .pinning = 0,
+    .namespace = "",
+};
+
 static __attribute__((always_inline)) void copy_container_id(const char src[CONTAINER_ID_LEN], char dst[CONTAINER_ID_LEN]) {
     bpf_probe_read(dst, CONTAINER_ID_LEN, (void*)src);
 }
 
 #define copy_container_id_no_tracing(src, dst) __builtin_memmove(dst, src, CONTAINER_ID_LEN)
 
+static __attribute__((always_inline)) void copy_container_entry(struct container_entry_t *src, struct container_entry_t *dst) {
+    dst->cookie = src->cookie;
+    copy_container_id(src->container_id, dst->container_id);
+}
+
+// hash_container_id returns the FNV-1a hash of a container ID, user space computes the same cookie for the
+// containers found during the snapshot
+static __attribute__((always_inline)) u64 hash_container_id(const char id[CONTAINER_ID_LEN]) {
+    u64 hash = 0xcbf29ce484222325;
+#pragma unroll
+    for (int i = 0; i < CONTAINER_ID_LEN; i++) {
+        hash ^= (u8)id[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
 #endif
@@ -259,6 +259,11 @@ struct process_context_t {
 };
 
 struct container_context_t {
+    u64 cookie;
+};
+
+struct container_entry_t {
+    u64 cookie;
     char container_id[CONTAINER_ID_LEN];
 };
 
@@ -360,10 +365,16 @@ static __attribute__((always_inline)) u32 is_flushing_discarders(void) {
     return prev_id != NULL && *prev_id;
 }
 
+#define EVENT_STATS_HISTOGRAM_BUCKETS 16
+#define EVENT_STATS_LATENCY_SHIFT 8 // first latency bucket covers [0, 256ns)
+#define EVENT_STATS_SIZE_SHIFT 5 // first size bucket covers [0, 32 bytes)
+
 struct perf_map_stats_t {
     u64 bytes;
     u64 count;
     u64 lost;
+    u64 output_latency[EVENT_STATS_HISTOGRAM_BUCKETS];
+    u64 size[EVENT_STATS_HISTOGRAM_BUCKETS];
 };
 
 struct bpf_map_def SEC("maps/events") events = {
@@ -382,24 +393,147 @@ struct bpf_map_def SEC("maps/events_stats") events_stats = {
     .namespace = "",
 };
 
+static __attribute__((always_inline)) u32 log2_u64(u64 v) {
+    u32 r = 0, shift;
+
+    shift = (v > 0xFFFFFFFF) << 5; v >>= shift; r |= shift;
+    shift = (v > 0xFFFF) << 4; v >>= shift; r |= shift;
+    shift = (v > 0xFF) << 3; v >>= shift; r |= shift;
+    shift = (v > 0xF) << 2; v >>= shift; r |= shift;
+    shift = (v > 0x3) << 1; v >>= shift; r |= shift;
+    r |= (v >> 1);
+
+    return r;
+}
+
+static __attribute__((always_inline)) u32 histogram_bucket(u64 value, u32 shift) {
+    value >>= shift;
+    if (value == 0) {
+        return 0;
+    }
+
+    u32 bucket = log2_u64(value) + 1;
+    if (bucket >= EVENT_STATS_HISTOGRAM_BUCKETS) {
+        bucket = EVENT_STATS_HISTOGRAM_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+// events_stats is a per-CPU map and eBPF programs can't be preempted by another program on the same CPU for the same
+// hook type, so plain increments are enough, no need for locked instructions.
+static __attribute__((always_inline)) void update_events_stats(u32 event_type, u64 size, u64 timestamp, int perf_ret) {
+    if (event_type >= EVENT_MAX) {
+        return;
+    }
+
+    struct perf_map_stats_t *stats = bpf_map_lookup_elem(&events_stats, &event_type);
+    if (stats == NULL) {
+        return;
+    }
+
+    if (perf_ret) {
+        stats->lost += 1;
+        return;
+    }
+
+    stats->bytes += size + 4;
+    stats->count += 1;
+
+    u32 bucket = histogram_bucket(bpf_ktime_get_ns() - timestamp, EVENT_STATS_LATENCY_SHIFT);
+    stats->output_latency[bucket & (EVENT_STATS_HISTOGRAM_BUCKETS - 1)] += 1;
+
+    bucket = histogram_bucket(size, EVENT_STATS_SIZE_SHIFT);
+    stats->size[bucket & (EVENT_STATS_HISTOGRAM_BUCKETS - 1)] += 1;
+}
+
+#define EVENT_RATE_LIMITER_MAX_ELAPSED 60000000000 // 60s, caps the refill computation to avoid overflows
+
+struct event_rate_limiter_key_t {
+    u32 tgid;
+    u32 event_type;
+};
+
+struct event_rate_limiter_t {
+    u64 last_refill;
+    u64 tokens;
+    u64 suppressed;
+};
+
+struct bpf_map_def SEC("maps/event_rate_limiters") event_rate_limiters = {
+    .type = BPF_MAP_TYPE_LRU_HASH,
+    .key_size = sizeof(struct event_rate_limiter_key_t),
+    .value_size = sizeof(struct event_rate_limiter_t),
+    .max_entries = 4096,
+    .pinning = 0,
+    .namespace = "",
+};
+
+// is_event_rate_limited implements a per (tgid, event type) token bucket. It returns 1 when the event shouldn't be sent,
+// in which case the suppressed counter of the bucket is incremented so that user space can report a summary.
+static __attribute__((always_inline)) int is_event_rate_limited(u32 event_type) {
+    u64 rate;
+    LOAD_CONSTANT("event_rate_limiter_rate", rate);
+    if (rate == 0 || event_type >= EVENT_MAX) {
+        return 0;
+    }
+
+    u64 event_types;
+    LOAD_CONSTANT("event_rate_limiter_event_types", event_types);
+    if ((event_types & (1ULL << event_type)) == 0) {
+        return 0;
+    }
+
+    u64 burst;
+    LOAD_CONSTANT("event_rate_limiter_burst", burst);
+
+    u64 now = bpf_ktime_get_ns();
+    struct event_rate_limiter_key_t key = {
+        .tgid = bpf_get_current_pid_tgid() >> 32,
+        .event_type = event_type,
+    };
+
+    struct event_rate_limiter_t *limiter = bpf_map_lookup_elem(&event_rate_limiters, &key);
+    if (limiter == NULL) {
+        struct event_rate_limiter_t new_limiter = {
+            .last_refill = now,
+            .tokens = burst > 0 ? burst - 1 : 0,
+        };
+        bpf_map_update_elem(&event_rate_limiters, &key, &new_limiter, BPF_NOEXIST);
+        return 0;
+    }
+
+    // concurrent updates from other CPUs may lose a refill or a token, the bucket converges back on the next refill
+    u64 elapsed = now - limiter->last_refill;
+    if (elapsed > EVENT_RATE_LIMITER_MAX_ELAPSED) {
+        elapsed = EVENT_RATE_LIMITER_MAX_ELAPSED;
+    }
+
+    u64 refill = elapsed * rate / 1000000000;
+    if (refill > 0) {
+        u64 tokens = limiter->tokens + refill;
+        limiter->tokens = tokens > burst ? burst : tokens;
+        limiter->last_refill = now;
+    }
+
+    if (limiter->tokens == 0) {
+        __sync_fetch_and_add(&limiter->suppressed, 1);
+        return 1;
+    }
+
+    limiter->tokens -= 1;
+    return 0;
+}
+
 #define send_event_with_size_ptr_perf(ctx, event_type, kernel_event, kernel_event_size)                                \
     kernel_event->event.type = event_type;                                                                             \
     kernel_event->event.cpu = bpf_get_smp_processor_id();                                                              \
     kernel_event->event.timestamp = bpf_ktime_get_ns();                                                                \
                                                                                                                        \
-    perf_ret = bpf_perf_event_output(ctx, &events, kernel_event->event.cpu, kernel_event, kernel_event_size);      \
-                                                                                                                       \
-    if (kernel_event->event.type < EVENT_MAX) {                                                                        \
-        u64 lookup_type = event_type;                                                                                  \
-        struct perf_map_stats_t *stats = bpf_map_lookup_elem(&events_stats, &lookup_type);                             \
-        if (stats != NULL) {                                                                                           \
-            if (!perf_ret) {                                                                                           \
-                __sync_fetch_and_add(&stats->bytes, kernel_event_size + 4);                                            \
-                __sync_fetch_and_add(&stats->count, 1);                                                                \
-            } else {                                                                                                   \
-                __sync_fetch_and_add(&stats->lost, 1);                                                                 \
-            }                                                                                                          \
-        }                                                                                                              \
+    if (is_event_rate_limited(event_type)) {                                                                           \
+        perf_ret = 0;                                                                                                  \
+    } else {                                                                                                           \
+        perf_ret = bpf_perf_event_output(ctx, &events, kernel_event->event.cpu, kernel_event, kernel_event_size);      \
+        update_events_stats(event_type, kernel_event_size, kernel_event->event.timestamp, perf_ret);                   \
     }                                                                                                                  \
 
 #define send_event_with_size_ptr_ringbuf(ctx, event_type, kernel_event, kernel_event_size)                             \
@@ -407,19 +541,11 @@ struct bpf_map_def SEC("maps/events_stats") events_stats = {
     kernel_event->event.cpu = bpf_get_smp_processor_id();                                                              \
     kernel_event->event.timestamp = bpf_ktime_get_ns();                                                                \
                                                                                                                        \
-    perf_ret = bpf_ringbuf_output(&events, kernel_event, kernel_event_size, 0);                                    \
-                                                                                                                       \
-    if (kernel_event->event.type < EVENT_MAX) {                                                                        \
-        u64 lookup_type = event_type;                                                                                  \
-        struct perf_map_stats_t *stats = bpf_map_lookup_elem(&events_stats, &lookup_type);                             \
-        if (stats != NULL) {                                                                                           \
-            if (!perf_ret) {                                                                                           \
-                __sync_fetch_and_add(&stats->bytes, kernel_event_size + 4);                                            \
-                __sync_fetch_and_add(&stats->count, 1);                                                                \
-            } else {                                                                                                   \
-                __sync_fetch_and_add(&stats->lost, 1);                                                                 \
-            }                                                                                                          \
-        }                                                                                                              \
+    if (is_event_rate_limited(event_type)) {                                                                           \
+        perf_ret = 0;                                                                                                  \
+    } else {                                                                                                           \
+        perf_ret = bpf_ringbuf_output(&events, kernel_event, kernel_event_size, 0);                                    \
+        update_events_stats(event_type, kernel_event_size, kernel_event->event.timestamp, perf_ret);                   \
     }                                                                                                                  \
 
 #define send_event_with_size_perf(ctx, event_type, kernel_event, kernel_event_size)                                    \
@@ -427,18 +553,11 @@ struct bpf_map_def SEC("maps/events_stats") events_stats = {
     kernel_event.event.cpu = bpf_get_smp_processor_id();                                                               \
     kernel_event.event.timestamp = bpf_ktime_get_ns();                                                                 \
                                                                                                                        \
-    perf_ret = bpf_perf_event_output(ctx, &events, kernel_event.event.cpu, &kernel_event, kernel_event_size);      \
-                                                                                                                       \
-    if (kernel_event.event.type < EVENT_MAX) {                                                                         \
-        struct perf_map_stats_t *stats = bpf_map_lookup_elem(&events_stats, &kernel_event.event.type);                 \
-        if (stats != NULL) {                                                                                           \
-            if (!perf_ret) {                                                                                           \
-                __sync_fetch_and_add(&stats->bytes, kernel_event_size + 4);                                            \
-                __sync_fetch_and_add(&stats->count, 1);                                                                \
-            } else {                                                                                                   \
-                __sync_fetch_and_add(&stats->lost, 1);                                                                 \
-            }                                                                                                          \
-        }                                                                                                              \
+    if (is_event_rate_limited(event_type)) {                                                                           \
+        perf_ret = 0;                                                                                                  \
+    } else {                                                                                                           \
+        perf_ret = bpf_perf_event_output(ctx, &events, kernel_event.event.cpu, &kernel_event, kernel_event_size);      \
+        update_events_stats(event_type, kernel_event_size, kernel_event.event.timestamp, perf_ret);                    \
     }                                                                                                                  \
 
 #define send_event_with_size_ringbuf(ctx, event_type, kernel_event, kernel_event_size)                                 \
@@ -446,18 +565,11 @@ struct bpf_map_def SEC("maps/events_stats") events_stats = {
     kernel_event.event.cpu = bpf_get_smp_processor_id();                                                               \
     kernel_event.event.timestamp = bpf_ktime_get_ns();                                                                 \
                                                                                                                        \
-    perf_ret = bpf_ringbuf_output(&events, &kernel_event, kernel_event_size, 0);                                   \
-                                                                                                                       \
-    if (kernel_event.event.type < EVENT_MAX) {                                                                         \
-        struct perf_map_stats_t *stats = bpf_map_lookup_elem(&events_stats, &kernel_event.event.type);                 \
-        if (stats != NULL) {                                                                                           \
-            if (!perf_ret) {                                                                                           \
-                __sync_fetch_and_add(&stats->bytes, kernel_event_size + 4);                                            \
-                __sync_fetch_and_add(&stats->count, 1);                                                                \
-            } else {                                                                                                   \
-                __sync_fetch_and_add(&stats->lost, 1);                                                                 \
-            }                                                                                                          \
-        }                                                                                                              \
+    if (is_event_rate_limited(event_type)) {                                                                           \
+        perf_ret = 0;                                                                                                  \
+    } else {                                                                                                           \
+        perf_ret = bpf_ringbuf_output(&events, &kernel_event, kernel_event_size, 0);                                   \
+        update_events_stats(event_type, kernel_event_size, kernel_event.event.timestamp, perf_ret);                    \
     }                                                                                                                  \
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 8, 0)
@@ -139,12 +139,8 @@ u64* __attribute__((always_inline)) get_discarder_timestamp_from_map(struct disc
     return NULL;
 }
 
-void * __attribute__((always_inline)) is_discarded(struct bpf_map_def *discarder_map, void *key, u64 event_type, u64 now) {
-    void *entry = bpf_map_lookup_elem(discarder_map, key);
-    if (entry == NULL) {
-        return NULL;
-    }
-
+// is_discarder_entry_active checks an entry of a discarder map, returns it when it discards the given event type
+void * __attribute__((always_inline)) is_discarder_entry_active(struct bpf_map_def *discarder_map, void *key, void *entry, u64 event_type, u64 now) {
     struct discarder_params_t *params = (struct discarder_params_t *)entry;
 
     // this discarder has been marked as on hold by event such as unlink, rename, etc.
@@ -171,6 +167,15 @@ void * __attribute__((always_inline)) is_discarded(struct bpf_map_def *discarder
     return NULL;
 }
 
+void * __attribute__((always_inline)) is_discarded(struct bpf_map_def *discarder_map, void *key, u64 event_type, u64 now) {
+    void *entry = bpf_map_lookup_elem(discarder_map, key);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    return is_discarder_entry_active(discarder_map, key, entry, event_type, now);
+}
+
 struct inode_discarder_params_t {
     struct discarder_params_t params;
     u32 revision;
@@ -185,6 +190,87 @@ struct bpf_map_def SEC("maps/inode_discarders") inode_discarders = {
     .namespace = "",
 };
 
+// The inode discarders bloom filter is a blocked bloom filter consulted before the inode_discarders lookup: each
+// (mount_id, inode) pair sets 2 bits in a single 64 bits word, so that a check costs one array lookup. It is only
+// populated in kernel space, when a discarder is added. User space clears it when the discarders are flushed, and
+// rebuilds it from the live inode_discarders entries when enough discarders were added since the last rebuild for the
+// false positive rate to degrade. Bits aren't removed when discarders are evicted, a stale bit only leads to a regular
+// inode_discarders lookup until the next rebuild.
+#define INODE_DISCARDERS_BLOOM_WORDS 1024
+
+struct bpf_map_def SEC("maps/inode_discarders_bloom") inode_discarders_bloom = {
+    .type = BPF_MAP_TYPE_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(u64),
+    .max_entries = INODE_DISCARDERS_BLOOM_WORDS,
+    .pinning = 0,
+    .namespace = "",
+};
+
+struct inode_discarders_bloom_stats_t {
+    u64 checked;
+    u64 skipped;
+    u64 false_positives;
+    u64 inserts;
+};
+
+struct bpf_map_def SEC("maps/inode_discarders_bloom_stats") inode_discarders_bloom_stats = {
+    .type = BPF_MAP_TYPE_PERCPU_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(struct inode_discarders_bloom_stats_t),
+    .max_entries = 1,
+    .pinning = 0,
+    .namespace = "",
+};
+
+static __attribute__((always_inline)) u64 inode_discarder_hash(u32 mount_id, u64 inode) {
+    u64 h = inode * 0x9E3779B97F4A7C15ULL;
+    h ^= (u64)mount_id * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 31;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 29;
+    return h;
+}
+
+static __attribute__((always_inline)) u64 inode_discarder_bloom_bits(u64 hash) {
+    return (1ULL << ((hash >> 32) & 63)) | (1ULL << ((hash >> 40) & 63));
+}
+
+void __attribute__((always_inline)) add_inode_discarder_to_bloom(u32 mount_id, u64 inode) {
+    u64 hash = inode_discarder_hash(mount_id, inode);
+    u32 key = hash & (INODE_DISCARDERS_BLOOM_WORDS - 1);
+
+    u64 *word = bpf_map_lookup_elem(&inode_discarders_bloom, &key);
+    if (word == NULL) {
+        return;
+    }
+
+    // not atomic on purpose (atomic or requires 5.12+), a lost bit only means that the discarder will be ignored until
+    // user space pushes it again
+    *word |= inode_discarder_bloom_bits(hash);
+
+    // user space rebuilds the filter based on the number of inserts
+    u32 zero = 0;
+    struct inode_discarders_bloom_stats_t *bloom_stats = bpf_map_lookup_elem(&inode_discarders_bloom_stats, &zero);
+    if (bloom_stats != NULL) {
+        bloom_stats->inserts += 1;
+    }
+}
+
+int __attribute__((always_inline)) is_maybe_discarded_by_inode(u32 mount_id, u64 inode) {
+    u64 hash = inode_discarder_hash(mount_id, inode);
+    u32 key = hash & (INODE_DISCARDERS_BLOOM_WORDS - 1);
+
+    u64 *word = bpf_map_lookup_elem(&inode_discarders_bloom, &key);
+    if (word == NULL) {
+        // fallback to the regular discarder check
+        return 1;
+    }
+
+    u64 bits = inode_discarder_bloom_bits(hash);
+    return (*word & bits) == bits;
+}
+
 int __attribute__((always_inline)) discard_inode(u64 event_type, u32 mount_id, u64 inode, u64 timeout, u32 is_leaf) {
     if (!mount_id || !inode) {
         return 0;
@@ -232,6 +318,8 @@ int __attribute__((always_inline)) discard_inode(u64 event_type, u32 mount_id, u
         bpf_map_update_elem(&inode_discarders, &key, &new_inode_params, BPF_NOEXIST);
     }
 
+    add_inode_discarder_to_bloom(mount_id, inode);
+
     monitor_discarder_added(event_type);
 
     return 0;
@@ -244,9 +332,32 @@ typedef enum discard_check_state {
 } discard_check_state;
 
 discard_check_state __attribute__((always_inline)) is_discarded_by_inode(struct is_discarded_by_inode_t *params) {
+    u32 zero = 0;
+    struct inode_discarders_bloom_stats_t *bloom_stats = bpf_map_lookup_elem(&inode_discarders_bloom_stats, &zero);
+    if (bloom_stats != NULL) {
+        bloom_stats->checked += 1;
+    }
+
+    // most of the checked inodes aren't discarded, skip the hash and revision lookups when possible
+    if (!is_maybe_discarded_by_inode(params->discarder.path_key.mount_id, params->discarder.path_key.ino)) {
+        if (bloom_stats != NULL) {
+            bloom_stats->skipped += 1;
+        }
+        return NOT_DISCARDED;
+    }
+
     // start with the "normal" discarder check
     struct inode_discarder_t key = params->discarder;
-    struct inode_discarder_params_t *inode_params = (struct inode_discarder_params_t *) is_discarded(&inode_discarders, &key, params->event_type, params->now);
+    void *entry = bpf_map_lookup_elem(&inode_discarders, &key);
+    if (entry == NULL) {
+        // the filter matched an inode without any discarder
+        if (bloom_stats != NULL) {
+            bloom_stats->false_positives += 1;
+        }
+        return NOT_DISCARDED;
+    }
+
+    struct inode_discarder_params_t *inode_params = (struct inode_discarder_params_t *) is_discarder_entry_active(&inode_discarders, &key, entry, params->event_type, params->now);
     if (!inode_params) {
         return NOT_DISCARDED;
     }
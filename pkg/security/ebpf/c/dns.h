@@ -77,9 +77,9 @@ __attribute__((always_inline)) struct dns_event_t *reset_dns_event(struct __sk_b
 
     struct proc_cache_t *entry = get_proc_cache(evt->process.pid);
     if (entry == NULL) {
-        evt->container.container_id[0] = 0;
+        evt->container.cookie = 0;
     } else {
-        copy_container_id_no_tracing(entry->container.container_id, &evt->container.container_id);
+        evt->container.cookie = entry->container.cookie;
     }
 
     return evt;
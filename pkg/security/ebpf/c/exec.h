@@ -308,7 +308,7 @@ int __attribute__((always_inline)) handle_exec_event(struct pt_regs *ctx, struct
         struct proc_cache_t *parent_pc = get_proc_from_cookie(parent_cookie);
         if (parent_pc) {
             // inherit the parent container context
-            fill_container_context(parent_pc, &pc.container);
+            copy_container_entry(&parent_pc->container, &pc.container);
         }
     }
 
@@ -369,11 +369,11 @@ int __attribute__((always_inline)) handle_interpreted_exec_event(struct pt_regs
 }
 
 int __attribute__((always_inline)) handle_sys_fork(struct pt_regs *ctx) {
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_FORK,
     };
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
 
     return 0;
 }
@@ -397,7 +397,7 @@ SYSCALL_KPROBE0(vfork) {
 #define DO_FORK_STRUCT_INPUT 1
 
 int __attribute__((always_inline)) handle_do_fork(struct pt_regs *ctx) {
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_FORK);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_FORK);
     if (!syscall) {
         return 0;
     }
@@ -441,7 +441,7 @@ int kprobe__do_fork(struct pt_regs *ctx) {
 
 SEC("kretprobe/alloc_pid")
 int kretprobe_alloc_pid(struct pt_regs *ctx) {
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_FORK);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_FORK);
     if (!syscall) {
         return 0;
     }
@@ -482,7 +482,7 @@ int sched_process_fork(struct _tracepoint_sched_process_fork *args) {
     bpf_probe_read(&pid, sizeof(pid), &args->child_pid);
 
     // ignore the rest if kworker
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_FORK);
+    struct compact_syscall_cache_t *syscall = peek_compact_syscall(EVENT_FORK);
     if (!syscall) {
         u32 value = 1;
         // mark as ignored fork not from syscall, ex: kworkers
@@ -490,6 +490,10 @@ int sched_process_fork(struct _tracepoint_sched_process_fork *args) {
         return 0;
     }
 
+    // sched_process_fork is the last hook of the fork syscalls to use the cached entry, pop it now instead of
+    // leaving it to the next syscall of the thread, which would count it as overwritten
+    pop_compact_syscall(EVENT_FORK);
+
     u32 parent_pid = 0;
     bpf_probe_read(&parent_pid, sizeof(parent_pid), &args->child_pid);
     u32 *netns = bpf_map_lookup_elem(&netns_cache, &parent_pid);
@@ -532,6 +536,7 @@ int sched_process_fork(struct _tracepoint_sched_process_fork *args) {
         return 0;
     }
 
+    char on_stack_cgroup[CONTAINER_ID_LEN] = {};
     struct pid_cache_t *parent_pid_entry = (struct pid_cache_t *) bpf_map_lookup_elem(&pid_cache, &ppid);
     if (parent_pid_entry) {
         // ensure pid and ppid point to the same cookie
@@ -545,6 +550,7 @@ int sched_process_fork(struct _tracepoint_sched_process_fork *args) {
         struct proc_cache_t *parent_pc = get_proc_from_cookie(on_stack_cookie);
         if (parent_pc) {
             fill_container_context(parent_pc, &event->container);
+            bpf_probe_read_str(on_stack_cgroup, sizeof(on_stack_cgroup), parent_pc->container.container_id);
             copy_proc_entry_except_comm(&parent_pc->entry, &event->proc_entry);
         }
     }
@@ -556,8 +562,6 @@ int sched_process_fork(struct _tracepoint_sched_process_fork *args) {
     // [activity_dump] inherit tracing state
     char on_stack_comm[TASK_COMM_LEN];
     bpf_probe_read_str(on_stack_comm, sizeof(on_stack_comm), event->proc_entry.comm);
-    char on_stack_cgroup[CONTAINER_ID_LEN];
-    bpf_probe_read_str(on_stack_cgroup, sizeof(on_stack_cgroup), event->container.container_id);
     inherit_traced_state(args, ppid, pid, on_stack_cgroup, on_stack_comm);
 
     // send the entry to maintain userspace cache
@@ -754,7 +758,7 @@ int __attribute__((always_inline)) send_exec_event(struct pt_regs *ctx, struct l
             char on_stack_comm[TASK_COMM_LEN];
             bpf_probe_read_str(on_stack_comm, sizeof(on_stack_comm), event->proc_entry.comm);
             char on_stack_cgroup[CONTAINER_ID_LEN];
-            bpf_probe_read_str(on_stack_cgroup, sizeof(on_stack_cgroup), event->container.container_id);
+            bpf_probe_read_str(on_stack_cgroup, sizeof(on_stack_cgroup), pc->container.container_id);
             should_trace_new_process(ctx, now, tgid, on_stack_cgroup, on_stack_comm);
 
             // add interpreter path info
@@ -153,19 +153,19 @@ SYSCALL_KPROBE1(delete_module, const char *, name_user) {
         return 0;
     }
 
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_DELETE_MODULE,
         .delete_module = {
             .name = name_user,
         },
     };
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
 int __attribute__((always_inline)) trace_delete_module_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_DELETE_MODULE);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_DELETE_MODULE);
     if (!syscall) {
         return 0;
     }
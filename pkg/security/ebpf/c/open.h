@@ -110,6 +110,10 @@ int __attribute__((always_inline)) open_approvers(struct syscall_cache_t *syscal
         pass_to_userspace = approve_by_basename(syscall->open.dentry, EVENT_OPEN);
     }
 
+    if (!pass_to_userspace && (syscall->policy.flags & PARENT_NAME) > 0) {
+        pass_to_userspace = approve_by_parent_name(syscall->open.dentry, syscall->open.path, EVENT_OPEN);
+    }
+
     if (!pass_to_userspace && (syscall->policy.flags & FLAGS) > 0) {
         pass_to_userspace = approve_by_flags(syscall);
     }
@@ -125,6 +129,7 @@ int __attribute__((always_inline)) handle_open_event(struct syscall_cache_t *sys
     struct dentry *dentry = get_path_dentry(path);
 
     syscall->open.dentry = dentry;
+    syscall->open.path = path;
     syscall->open.file.path_key = get_inode_key_path(inode, path);
 
     set_file_inode(dentry, &syscall->open.file, 0);
@@ -151,6 +156,7 @@ int kprobe_vfs_truncate(struct pt_regs *ctx) {
     struct dentry *dentry = get_path_dentry(path);
 
     syscall->open.dentry = dentry;
+    syscall->open.path = path;
     syscall->open.file.path_key = get_dentry_key_path(syscall->open.dentry, path);
 
     set_file_inode(dentry, &syscall->open.file, 0);
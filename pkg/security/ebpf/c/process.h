@@ -16,7 +16,7 @@ struct process_entry_t {
 };
 
 struct proc_cache_t {
-    struct container_context_t container;
+    struct container_entry_t container;
     struct process_entry_t entry;
 };
 
@@ -36,7 +36,7 @@ void __attribute__((always_inline)) copy_proc_entry_except_comm(struct process_e
 }
 
 void __attribute__((always_inline)) copy_proc_cache(struct proc_cache_t *src, struct proc_cache_t *dst) {
-    copy_container_id(src->container.container_id, dst->container.container_id);
+    copy_container_entry(&src->container, &dst->container);
     copy_proc_entry_except_comm(&src->entry, &dst->entry);
     bpf_probe_read(dst->entry.comm, TASK_COMM_LEN, src->entry.comm);
 }
@@ -52,7 +52,7 @@ struct bpf_map_def SEC("maps/proc_cache") proc_cache = {
 
 static void __attribute__((always_inline)) fill_container_context(struct proc_cache_t *entry, struct container_context_t *context) {
     if (entry) {
-        copy_container_id(entry->container.container_id, context->container_id);
+        context->cookie = entry->container.cookie;
     }
 }
 
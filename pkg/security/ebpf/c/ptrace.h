@@ -19,7 +19,7 @@ SYSCALL_KPROBE3(ptrace, u32, request, pid_t, pid, void *, addr) {
         return 0;
     }
 
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_PTRACE,
         .ptrace = {
             .request = request,
@@ -28,12 +28,12 @@ SYSCALL_KPROBE3(ptrace, u32, request, pid_t, pid, void *, addr) {
         }
     };
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
 int __attribute__((always_inline)) sys_ptrace_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_PTRACE);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_PTRACE);
     if (!syscall) {
         return 0;
     }
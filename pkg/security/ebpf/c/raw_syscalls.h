@@ -167,12 +167,11 @@ shoud_send_event:
 // used as a fallback, because tracepoints are not enable when using a ia32 userspace application with a x64 kernel
 // cf. https://elixir.bootlin.com/linux/latest/source/arch/x86/include/asm/ftrace.h#L106
 int __attribute__((always_inline)) handle_sys_exit(struct tracepoint_raw_syscalls_sys_exit_t *args) {
-    struct syscall_cache_t *syscall = peek_syscall(EVENT_ANY);
-    if (!syscall) {
-        return 0;
+    // the newest cached syscall wins, whichever slab it lives in
+    u64 type = peek_syscall_type();
+    if (type != EVENT_ANY) {
+        bpf_tail_call_compat(args, &sys_exit_progs, type);
     }
-
-    bpf_tail_call_compat(args, &sys_exit_progs, syscall->type);
     return 0;
 }
 
@@ -133,7 +133,7 @@ int __attribute__((always_inline)) kprobe_dr_security_inode_rmdir_callback(struc
 }
 
 int __attribute__((always_inline)) sys_rmdir_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall_with(rmdir_predicate);
+    struct syscall_cache_t *syscall = pop_syscall_with(rmdir_predicate, EVENT_RMDIR);
     if (!syscall) {
         return 0;
     }
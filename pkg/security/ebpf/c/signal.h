@@ -31,14 +31,14 @@ SYSCALL_KPROBE2(kill, int, pid, int, type) {
     }
 
     /* cache the signal and wait to grab the retval to send it */
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_SIGNAL,
         .signal = {
             .pid = root_nr,
             .type = type,
         },
     };
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
@@ -47,7 +47,7 @@ SEC("kretprobe/check_kill_permission")
 int kretprobe_check_kill_permission(struct pt_regs* ctx) {
     int retval = (int)PT_REGS_RC(ctx);
 
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_SIGNAL);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_SIGNAL);
     if (!syscall) {
         return 0;
     }
@@ -57,6 +57,7 @@ struct syscall_cache_t {
             int flags;
             umode_t mode;
             struct dentry *dentry;
+            struct path *path;
             struct file_t file;
             u64 pid_tgid;
         } open;
@@ -113,10 +114,6 @@ struct syscall_cache_t {
             const char *fstype;
         } mount;
 
-        struct {
-            struct vfsmount *vfs;
-        } umount;
-
         struct {
             struct file_t src_file;
             struct path *target_path;
@@ -142,11 +139,6 @@ struct syscall_cache_t {
             u8 is_parsed;
         } exec;
 
-        struct {
-            u32 is_thread;
-            struct pid *pid;
-        } fork;
-
         struct {
             struct dentry *dentry;
             struct file_t file;
@@ -154,21 +146,6 @@ struct syscall_cache_t {
             union selinux_write_payload_t payload;
         } selinux;
 
-        struct {
-            int cmd;
-            u32 map_id;
-            u32 prog_id;
-            int retval;
-            u64 helpers[3];
-            union bpf_attr_def *attr;
-        } bpf;
-
-        struct {
-            u32 request;
-            u32 pid;
-            u64 addr;
-        } ptrace;
-
         struct {
             u64 offset;
             u32 len;
@@ -192,15 +169,6 @@ struct syscall_cache_t {
             u32 loaded_from_memory;
         } init_module;
 
-        struct {
-            const char *name;
-        } delete_module;
-
-        struct {
-            u32 pid;
-            u32 type;
-        } signal;
-
         struct {
             struct file_t file;
             struct dentry *dentry;
@@ -209,6 +177,56 @@ struct syscall_cache_t {
             u32 pipe_entry_flag;
             u32 pipe_exit_flag;
         } splice;
+    };
+};
+
+struct bpf_map_def SEC("maps/syscalls") syscalls = {
+    .type = BPF_MAP_TYPE_LRU_HASH,
+    .key_size = sizeof(u64),
+    .value_size = sizeof(struct syscall_cache_t),
+    .max_entries = 1024,
+    .pinning = 0,
+    .namespace = "",
+};
+
+// compact_syscall_cache_t is used by the syscalls that neither resolve a path nor go through approvers. It only holds
+// the fields those syscalls need, so that their entries don't pay for the largest member of syscall_cache_t.
+struct compact_syscall_cache_t {
+    u64 type;
+
+    union {
+        struct {
+            u32 is_thread;
+            struct pid *pid;
+        } fork;
+
+        struct {
+            struct vfsmount *vfs;
+        } umount;
+
+        struct {
+            int cmd;
+            u32 map_id;
+            u32 prog_id;
+            int retval;
+            u64 helpers[3];
+            union bpf_attr_def *attr;
+        } bpf;
+
+        struct {
+            u32 request;
+            u32 pid;
+            u64 addr;
+        } ptrace;
+
+        struct {
+            const char *name;
+        } delete_module;
+
+        struct {
+            u32 pid;
+            u32 type;
+        } signal;
 
         struct {
             u64 addr[2];
@@ -218,15 +236,105 @@ struct syscall_cache_t {
     };
 };
 
-struct bpf_map_def SEC("maps/syscalls") syscalls = {
+struct bpf_map_def SEC("maps/compact_syscalls") compact_syscalls = {
     .type = BPF_MAP_TYPE_LRU_HASH,
     .key_size = sizeof(u64),
-    .value_size = sizeof(struct syscall_cache_t),
+    .value_size = sizeof(struct compact_syscall_cache_t),
     .max_entries = 1024,
     .pinning = 0,
     .namespace = "",
 };
 
+// syscall_types holds the type of the newest syscall cached by each thread, whichever slab it was cached in. It is only
+// maintained when the raw sys_exit fallback is used, so that the fallback finds the exit program of the newest entry
+// with a single lookup.
+struct bpf_map_def SEC("maps/syscall_types") syscall_types = {
+    .type = BPF_MAP_TYPE_LRU_HASH,
+    .key_size = sizeof(u64),
+    .value_size = sizeof(u64),
+    .max_entries = 2048,
+    .pinning = 0,
+    .namespace = "",
+};
+
+int __attribute__((always_inline)) is_raw_syscall_fallback() {
+    u64 fallback;
+    LOAD_CONSTANT("tracepoint_raw_syscall_fallback", fallback);
+    return fallback;
+}
+
+// peek_syscall_type returns the type of the newest syscall cached by the current thread, EVENT_ANY if there is none
+u64 __attribute__((always_inline)) peek_syscall_type() {
+    u64 key = bpf_get_current_pid_tgid();
+    u64 *type = bpf_map_lookup_elem(&syscall_types, &key);
+    if (!type) {
+        return EVENT_ANY;
+    }
+    return *type;
+}
+
+void __attribute__((always_inline)) release_syscall_type(u64 key) {
+    if (is_raw_syscall_fallback()) {
+        bpf_map_delete_elem(&syscall_types, &key);
+    }
+}
+
+struct syscall_cache_stats_t {
+    u64 cached;
+    u64 overwritten;
+    u64 hits;
+    u64 misses;
+};
+
+struct bpf_map_def SEC("maps/syscall_cache_stats") syscall_cache_stats = {
+    .type = BPF_MAP_TYPE_PERCPU_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(struct syscall_cache_stats_t),
+    .max_entries = EVENT_MAX,
+    .pinning = 0,
+    .namespace = "",
+};
+
+struct syscall_cache_stats_t *__attribute__((always_inline)) get_syscall_cache_stats(u64 type) {
+    u32 key = type;
+    return bpf_map_lookup_elem(&syscall_cache_stats, &key);
+}
+
+// cache_syscall_in inserts an entry in the provided syscall cache, an existing entry for the same thread means that
+// the exit of a previous syscall was never seen
+void __attribute__((always_inline)) cache_syscall_in(void *cache, u64 type, void *syscall) {
+    u64 key = bpf_get_current_pid_tgid();
+    struct syscall_cache_stats_t *stats = get_syscall_cache_stats(type);
+
+    if (bpf_map_update_elem(cache, &key, syscall, BPF_NOEXIST) < 0) {
+        bpf_map_update_elem(cache, &key, syscall, BPF_ANY);
+        if (stats) {
+            stats->overwritten++;
+        }
+    }
+    if (stats) {
+        stats->cached++;
+    }
+
+    if (is_raw_syscall_fallback()) {
+        bpf_map_update_elem(&syscall_types, &key, &type, BPF_ANY);
+    }
+}
+
+// count_syscall_cache_pop counts the exit side lookups, a miss is either a syscall that wasn't cached at entry or an
+// entry that was evicted
+void __attribute__((always_inline)) count_syscall_cache_pop(u64 type, int hit) {
+    struct syscall_cache_stats_t *stats = get_syscall_cache_stats(type);
+    if (!stats) {
+        return;
+    }
+    if (hit) {
+        stats->hits++;
+    } else {
+        stats->misses++;
+    }
+}
+
 struct policy_t __attribute__((always_inline)) fetch_policy(u64 event_type) {
     struct policy_t *policy = bpf_map_lookup_elem(&filter_policy, &event_type);
     if (policy) {
@@ -238,8 +346,11 @@ struct policy_t __attribute__((always_inline)) fetch_policy(u64 event_type) {
 
 // cache_syscall checks the event policy in order to see if the syscall struct can be cached
 void __attribute__((always_inline)) cache_syscall(struct syscall_cache_t *syscall) {
-    u64 key = bpf_get_current_pid_tgid();
-    bpf_map_update_elem(&syscalls, &key, syscall, BPF_ANY);
+    cache_syscall_in(&syscalls, syscall->type, syscall);
+}
+
+void __attribute__((always_inline)) cache_compact_syscall(struct compact_syscall_cache_t *syscall) {
+    cache_syscall_in(&compact_syscalls, syscall->type, syscall);
 }
 
 struct syscall_cache_t *__attribute__((always_inline)) peek_syscall(u64 type) {
@@ -266,35 +377,76 @@ struct syscall_cache_t *__attribute__((always_inline)) peek_syscall_with(int (*p
     return NULL;
 }
 
-struct syscall_cache_t *__attribute__((always_inline)) pop_syscall_with(int (*predicate)(u64 type)) {
+// pop_syscall_with pops the cached syscall if it matches the predicate, a miss is counted for the requested type
+struct syscall_cache_t *__attribute__((always_inline)) pop_syscall_with(int (*predicate)(u64 type), u64 requested_type) {
     u64 key = bpf_get_current_pid_tgid();
     struct syscall_cache_t *syscall = (struct syscall_cache_t *)bpf_map_lookup_elem(&syscalls, &key);
-    if (!syscall) {
+    if (!syscall || !predicate(syscall->type)) {
+        count_syscall_cache_pop(requested_type, 0);
         return NULL;
     }
-    if (predicate(syscall->type)) {
-        bpf_map_delete_elem(&syscalls, &key);
-        return syscall;
-    }
-    return NULL;
+    count_syscall_cache_pop(syscall->type, 1);
+    bpf_map_delete_elem(&syscalls, &key);
+    release_syscall_type(key);
+    return syscall;
 }
 
 struct syscall_cache_t *__attribute__((always_inline)) pop_syscall(u64 type) {
     u64 key = bpf_get_current_pid_tgid();
     struct syscall_cache_t *syscall = (struct syscall_cache_t *)bpf_map_lookup_elem(&syscalls, &key);
+    if (!syscall || (type && syscall->type != type)) {
+        count_syscall_cache_pop(type, 0);
+        return NULL;
+    }
+    count_syscall_cache_pop(syscall->type, 1);
+    bpf_map_delete_elem(&syscalls, &key);
+    release_syscall_type(key);
+    return syscall;
+}
+
+struct compact_syscall_cache_t *__attribute__((always_inline)) peek_compact_syscall(u64 type) {
+    u64 key = bpf_get_current_pid_tgid();
+    struct compact_syscall_cache_t *syscall = (struct compact_syscall_cache_t *)bpf_map_lookup_elem(&compact_syscalls, &key);
     if (!syscall) {
         return NULL;
     }
     if (!type || syscall->type == type) {
-        bpf_map_delete_elem(&syscalls, &key);
         return syscall;
     }
     return NULL;
 }
 
+// pop_compact_syscall_with pops the cached syscall if it matches the predicate, a miss is counted for the requested type
+struct compact_syscall_cache_t *__attribute__((always_inline)) pop_compact_syscall_with(int (*predicate)(u64 type), u64 requested_type) {
+    u64 key = bpf_get_current_pid_tgid();
+    struct compact_syscall_cache_t *syscall = (struct compact_syscall_cache_t *)bpf_map_lookup_elem(&compact_syscalls, &key);
+    if (!syscall || !predicate(syscall->type)) {
+        count_syscall_cache_pop(requested_type, 0);
+        return NULL;
+    }
+    count_syscall_cache_pop(syscall->type, 1);
+    bpf_map_delete_elem(&compact_syscalls, &key);
+    release_syscall_type(key);
+    return syscall;
+}
+
+struct compact_syscall_cache_t *__attribute__((always_inline)) pop_compact_syscall(u64 type) {
+    u64 key = bpf_get_current_pid_tgid();
+    struct compact_syscall_cache_t *syscall = (struct compact_syscall_cache_t *)bpf_map_lookup_elem(&compact_syscalls, &key);
+    if (!syscall || (type && syscall->type != type)) {
+        count_syscall_cache_pop(type, 0);
+        return NULL;
+    }
+    count_syscall_cache_pop(syscall->type, 1);
+    bpf_map_delete_elem(&compact_syscalls, &key);
+    release_syscall_type(key);
+    return syscall;
+}
+
 int __attribute__((always_inline)) discard_syscall(struct syscall_cache_t *syscall) {
     u64 key = bpf_get_current_pid_tgid();
     bpf_map_delete_elem(&syscalls, &key);
+    release_syscall_type(key);
     return 0;
 }
 
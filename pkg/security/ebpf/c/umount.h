@@ -18,19 +18,19 @@ SYSCALL_KPROBE0(umount) {
 
 SEC("kprobe/security_sb_umount")
 int kprobe_security_sb_umount(struct pt_regs *ctx) {
-    struct syscall_cache_t syscall = {
+    struct compact_syscall_cache_t syscall = {
         .type = EVENT_UMOUNT,
         .umount = {
             .vfs = (struct vfsmount *)PT_REGS_PARM1(ctx),
         }
     };
 
-    cache_syscall(&syscall);
+    cache_compact_syscall(&syscall);
     return 0;
 }
 
 int __attribute__((always_inline)) sys_umount_ret(void *ctx, int retval) {
-    struct syscall_cache_t *syscall = pop_syscall(EVENT_UMOUNT);
+    struct compact_syscall_cache_t *syscall = pop_compact_syscall(EVENT_UMOUNT);
     if (!syscall) {
         return 0;
     }
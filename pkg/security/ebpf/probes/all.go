@@ -117,7 +117,10 @@ func AllMaps() []*manager.Map {
 		{Name: "inode_discarders"},
 		{Name: "pid_discarders"},
 		{Name: "discarder_revisions"},
+		{Name: "inode_discarders_bloom"},
+		{Name: "event_rate_limiters"},
 		{Name: "basename_approvers"},
+		{Name: "parent_name_approvers"},
 		// Dentry resolver table
 		{Name: "pathnames"},
 		// Snapshot table
@@ -35,6 +35,17 @@ var (
 	// Tags: -
 	MetricLoadControllerPidDiscarder = newRuntimeMetric(".load_controller.pids_discarder")
 
+	// Event rate limiter metrics
+
+	// MetricEventRateLimiterSuppressed is the name of the metric used to count the number of events suppressed by the
+	// in-kernel event rate limiter
+	// Tags: event_type
+	MetricEventRateLimiterSuppressed = newRuntimeMetric(".event_rate_limiter.suppressed")
+	// MetricEventRateLimiterProcesses is the name of the metric used to report the number of processes that had events
+	// suppressed by the in-kernel event rate limiter since the last report
+	// Tags: -
+	MetricEventRateLimiterProcesses = newRuntimeMetric(".event_rate_limiter.processes")
+
 	// Rate limiter metrics
 
 	// MetricRateLimiterDrop is the name of the metric used to count the amount of events dropped by the rate limiter
@@ -55,6 +66,18 @@ var (
 	// MetricConcurrentSyscall is the name of the metric used to count concurrent syscalls
 	// Tags: -
 	MetricConcurrentSyscall = newRuntimeMetric(".concurrent_syscalls")
+	// MetricSyscallCacheCached is the number of syscalls inserted in the kernel syscall caches
+	// Tags: event_type
+	MetricSyscallCacheCached = newRuntimeMetric(".syscall_cache.cached")
+	// MetricSyscallCacheOverwritten is the number of syscall cache entries overwritten before the syscall exit was seen
+	// Tags: event_type
+	MetricSyscallCacheOverwritten = newRuntimeMetric(".syscall_cache.overwritten")
+	// MetricSyscallCacheHits is the number of syscall exits that found their syscall cache entry
+	// Tags: event_type
+	MetricSyscallCacheHits = newRuntimeMetric(".syscall_cache.hits")
+	// MetricSyscallCacheMiss is the number of syscall exits that didn't find their syscall cache entry
+	// Tags: event_type
+	MetricSyscallCacheMiss = newRuntimeMetric(".syscall_cache.miss")
 
 	// Dentry Resolver metrics
 
@@ -76,6 +99,23 @@ var (
 	// MetricEventDiscarded is the number of event discarded
 	// Tags: discarder_type, event_type
 	MetricEventDiscarded = newRuntimeMetric(".discarders.event_discarded")
+	// MetricInodeDiscarderBloomChecked is the number of inode discarder checks that went through the bloom filter
+	// Tags: -
+	MetricInodeDiscarderBloomChecked = newRuntimeMetric(".discarders.inode_bloom.checked")
+	// MetricInodeDiscarderBloomSkipped is the number of inode discarder checks skipped thanks to the bloom filter
+	// Tags: -
+	MetricInodeDiscarderBloomSkipped = newRuntimeMetric(".discarders.inode_bloom.skipped")
+	// MetricInodeDiscarderBloomFalsePositive is the number of inode discarder checks that passed the bloom filter
+	// without being discarded
+	// Tags: -
+	MetricInodeDiscarderBloomFalsePositive = newRuntimeMetric(".discarders.inode_bloom.false_positive")
+	// MetricInodeDiscarderBloomFalsePositiveRate is the false positive rate of the inode discarders bloom filter
+	// Tags: -
+	MetricInodeDiscarderBloomFalsePositiveRate = newRuntimeMetric(".discarders.inode_bloom.false_positive_rate")
+	// MetricInodeDiscarderBloomRebuilt is the number of times the inode discarders bloom filter was rebuilt from the
+	// live discarders because it was too full
+	// Tags: -
+	MetricInodeDiscarderBloomRebuilt = newRuntimeMetric(".discarders.inode_bloom.rebuilt")
 
 	// Perf buffer metrics
 
@@ -101,6 +141,15 @@ var (
 	// MetricPerfBufferBytesRead is the name of the metric used to count the number of bytes read from a perf buffer
 	// Tags: map
 	MetricPerfBufferBytesRead = newRuntimeMetric(".perf_buffer.bytes.read")
+	// MetricPerfBufferOutputLatency is the name of the metric used to report the histogram of the time elapsed between
+	// the timestamp of an event and the return of the perf or ring buffer output helper, which covers the event rate
+	// limiter check and the output itself, but not the time spent building the event
+	// Tags: map, event_type, le
+	MetricPerfBufferOutputLatency = newRuntimeMetric(".perf_buffer.output_latency")
+	// MetricPerfBufferEventSize is the name of the metric used to report the histogram of the size of the events
+	// written to a perf buffer, as measured in kernel space
+	// Tags: map, event_type, le
+	MetricPerfBufferEventSize = newRuntimeMetric(".perf_buffer.event_size")
 	// MetricPerfBufferSortingError is the name of the metric used to report events reordering issues.
 	// Tags: map, event_type
 	MetricPerfBufferSortingError = newRuntimeMetric(".perf_buffer.sorting_error")
@@ -136,6 +185,10 @@ var (
 	// MetricProcessResolverFlushed is the name of the metric used to report the number cache flush
 	// Tags: -
 	MetricProcessResolverFlushed = newRuntimeMetric(".process_resolver.flushed")
+	// MetricProcessResolverKernelReleased is the name of the metric used to report the number of kernel pid cache
+	// and proc cache entries of exited processes released by the process resolver
+	// Tags: map
+	MetricProcessResolverKernelReleased = newRuntimeMetric(".process_resolver.kernel_released")
 	// MetricProcessResolverArgsTruncated is the name of the metric used to report the number of args truncated
 	// Tags: -
 	MetricProcessResolverArgsTruncated = newRuntimeMetric(".process_resolver.args.truncated")
@@ -180,6 +233,13 @@ var (
 	// Tags: format, compression
 	MetricActivityDumpEntityTooLarge = newAgentMetric(".activity_dump.entity_too_large")
 
+	// Container resolver metrics
+
+	// MetricContainerResolverUnresolvedCookies is the name of the metric used to report the number of container
+	// cookies that couldn't be resolved to a container ID
+	// Tags: -
+	MetricContainerResolverUnresolvedCookies = newRuntimeMetric(".container_resolver.unresolved_cookies")
+
 	// Namespace resolver metrics
 
 	// MetricNamespaceResolverNetNSHandle is the name of the metric used to report the count of netns handles
@@ -99,6 +99,8 @@ type ActivityDump struct {
 	shouldMergePaths bool
 	pathMergedCount  *atomic.Uint64
 	nodeStats        ActivityDumpNodeStats
+	stream           *activityDumpStreamWriter
+	streamFilePath   string
 
 	// standard attributes used by the intake
 	Host    string   `json:"host,omitempty"`
@@ -348,6 +350,11 @@ func (ad *ActivityDump) Stop() {
 
 	// scrub processes and retain args envs now
 	ad.scrubAndRetainProcessArgsEnvs()
+
+	// write the last nodes of the stream, if the dump was streamed
+	if err := ad.finalizeStream(); err != nil {
+		seclog.Errorf("couldn't finalize the stream of [%s]: %v", ad.getSelectorStr(), err)
+	}
 }
 
 func (ad *ActivityDump) scrubAndRetainProcessArgsEnvs() {
@@ -697,6 +704,8 @@ func (ad *ActivityDump) Encode(format dump.StorageFormat) (*bytes.Buffer, error)
 		return ad.EncodeDOT()
 	case dump.Profile:
 		return ad.EncodeProfile()
+	case dump.Stream:
+		return ad.EncodeStream()
 	default:
 		return nil, fmt.Errorf("couldn't encode activity dump [%s] as [%s]: unknown format", ad.GetSelectorStr(), format)
 	}
@@ -798,6 +807,8 @@ func (ad *ActivityDump) DecodeFromReader(reader io.Reader, format dump.StorageFo
 	switch format {
 	case dump.PROTOBUF:
 		return ad.DecodeProtobuf(reader)
+	case dump.Stream:
+		return ad.DecodeStream(reader)
 	default:
 		return fmt.Errorf("unsupported input format: %s", format)
 	}
@@ -65,6 +65,14 @@ func (adm *ActivityDumpManager) Start(ctx context.Context, wg *sync.WaitGroup) {
 	loadControlTicker := time.NewTicker(adm.probe.config.ActivityDumpLoadControlPeriod)
 	defer loadControlTicker.Stop()
 
+	// a nil channel blocks forever, which disables the stream flush when streaming isn't enabled
+	var streamFlushChan <-chan time.Time
+	if adm.probe.config.ActivityDumpStreamEnabled {
+		streamFlushTicker := time.NewTicker(adm.probe.config.ActivityDumpStreamFlushPeriod)
+		defer streamFlushTicker.Stop()
+		streamFlushChan = streamFlushTicker.C
+	}
+
 	for {
 		select {
 		case <-ctx.Done():
@@ -75,6 +83,8 @@ func (adm *ActivityDumpManager) Start(ctx context.Context, wg *sync.WaitGroup) {
 			adm.resolveTags()
 		case <-loadControlTicker.C:
 			adm.triggerLoadController()
+		case <-streamFlushChan:
+			adm.flushStreams()
 		case ad := <-adm.snapshotQueue:
 			if err := ad.Snapshot(); err != nil {
 				seclog.Errorf("couldn't snapshot [%s]: %v", ad.GetSelectorStr(), err)
@@ -110,6 +120,18 @@ func (adm *ActivityDumpManager) cleanup() {
 	}
 }
 
+// flushStreams writes the new nodes of the active dumps to their stream and releases them from memory
+func (adm *ActivityDumpManager) flushStreams() {
+	adm.Lock()
+	defer adm.Unlock()
+
+	for _, ad := range adm.activeDumps {
+		if err := ad.FlushStream(); err != nil {
+			seclog.Errorf("couldn't flush the stream of [%s]: %v", ad.GetSelectorStr(), err)
+		}
+	}
+}
+
 // resolveTags resolves activity dump container tags when they are missing
 func (adm *ActivityDumpManager) resolveTags() {
 	adm.Lock()
@@ -476,7 +498,7 @@ func (adm *ActivityDumpManager) snapshotTracedCgroups() {
 	iterator := adm.tracedCgroupsMap.Iterate()
 
 	for iterator.Next(&containerIDB, &event.TimeoutRaw) {
-		if _, err = event.ContainerContext.UnmarshalBinary(containerIDB[:]); err != nil {
+		if event.ContainerContext.ID, err = model.UnmarshalString(containerIDB, model.ContainerIDLen); err != nil {
 			continue
 		}
 
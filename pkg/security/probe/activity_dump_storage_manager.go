@@ -99,6 +99,9 @@ func (manager *ActivityDumpStorageManager) Persist(ad *ActivityDump) error {
 		}
 
 	}
+
+	// the stream file of a streamed dump isn't needed anymore
+	ad.removeStreamFile()
 	return nil
 }
 
@@ -0,0 +1,1208 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package probe
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path"
+	"time"
+
+	"github.com/DataDog/datadog-agent/pkg/security/probe/dump"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+	"github.com/DataDog/datadog-agent/pkg/security/seclog"
+)
+
+// The stream format is an append-only sequence of records preceded by a magic header. Every string is interned: it is
+// written once in a string record, and then referenced by its index. The table of interned strings is bounded: once it
+// is full, a reset record clears it on both ends and the following strings are written again. Node identifiers are assigned in order of
+// appearance, and each record references its parent node by identifier so that the tree can be rebuilt without
+// holding it in memory while it is written. Pids and timestamps are delta encoded against the parent node and the
+// dump start time respectively.
+//
+// Since the in memory children of a process are released once they have been written, the same file node may be
+// written more than once during the lifetime of a dump. Duplicates are merged back when the stream is decoded, which
+// also makes it possible to merge several streams offline by decoding them in the same ActivityDump.
+
+var streamMagic = [4]byte{'A', 'D', 'S', '1'}
+
+const (
+	streamRecordString byte = iota + 1
+	streamRecordMetadata
+	streamRecordProcess
+	streamRecordFile
+	streamRecordDNS
+	streamRecordSocket
+	streamRecordSyscalls
+	streamRecordStringReset
+)
+
+// maxStreamStringLength is the maximum length of an interned string, and maxStreamListLength the maximum number of
+// elements of a list, accepted by the decoder
+const (
+	maxStreamStringLength = 1 << 20
+	maxStreamListLength   = 1 << 16
+)
+
+// maxStreamStrings is the number of interned strings after which the string table of a stream is reset. A record may
+// exceed it by the number of strings it references, since the table is only reset between records.
+const maxStreamStrings = 1 << 16
+
+// ErrInvalidStreamHeader is returned when the input doesn't start with the activity dump stream magic
+var ErrInvalidStreamHeader = errors.New("invalid activity dump stream header")
+
+// activityDumpStreamWriter incrementally encodes an activity dump
+type activityDumpStreamWriter struct {
+	file *os.File
+	w    *bufio.Writer
+	buf  [binary.MaxVarintLen64]byte
+	err  error
+
+	start      time.Time
+	strings    map[string]uint64
+	nextNodeID uint64
+	processes  map[*ProcessActivityNode]uint64
+	pids       map[uint64]uint32
+}
+
+func newActivityDumpStreamWriter(w io.Writer, start time.Time) *activityDumpStreamWriter {
+	sw := &activityDumpStreamWriter{
+		w:          bufio.NewWriter(w),
+		start:      start,
+		strings:    make(map[string]uint64),
+		nextNodeID: 1,
+		processes:  make(map[*ProcessActivityNode]uint64),
+		pids:       make(map[uint64]uint32),
+	}
+	sw.write(streamMagic[:])
+	return sw
+}
+
+func newActivityDumpStreamFileWriter(filePath string, start time.Time) (*activityDumpStreamWriter, error) {
+	if err := os.MkdirAll(path.Dir(filePath), 0700); err != nil {
+		return nil, fmt.Errorf("couldn't create activity dump stream directory: %w", err)
+	}
+
+	f, err := os.OpenFile(filePath, os.O_CREATE|os.O_TRUNC|os.O_WRONLY, 0600)
+	if err != nil {
+		return nil, fmt.Errorf("couldn't create activity dump stream file: %w", err)
+	}
+
+	sw := newActivityDumpStreamWriter(f, start)
+	sw.file = f
+	return sw, nil
+}
+
+func (sw *activityDumpStreamWriter) write(data []byte) {
+	if sw.err != nil {
+		return
+	}
+	_, sw.err = sw.w.Write(data)
+}
+
+func (sw *activityDumpStreamWriter) writeByte(b byte) {
+	if sw.err != nil {
+		return
+	}
+	sw.err = sw.w.WriteByte(b)
+}
+
+func (sw *activityDumpStreamWriter) writeUvarint(v uint64) {
+	n := binary.PutUvarint(sw.buf[:], v)
+	sw.write(sw.buf[:n])
+}
+
+func (sw *activityDumpStreamWriter) writeVarint(v int64) {
+	n := binary.PutVarint(sw.buf[:], v)
+	sw.write(sw.buf[:n])
+}
+
+func (sw *activityDumpStreamWriter) writeBool(v bool) {
+	if v {
+		sw.writeByte(1)
+	} else {
+		sw.writeByte(0)
+	}
+}
+
+// internString returns the index of the provided string, the string is written in a new string record the first
+// time it is seen. The empty string always has the index 0.
+func (sw *activityDumpStreamWriter) internString(s string) uint64 {
+	if len(s) == 0 {
+		return 0
+	}
+	if id, ok := sw.strings[s]; ok {
+		return id
+	}
+
+	id := uint64(len(sw.strings) + 1)
+	sw.strings[s] = id
+
+	sw.writeByte(streamRecordString)
+	sw.writeUvarint(uint64(len(s)))
+	sw.write([]byte(s))
+	return id
+}
+
+// resetStringsIfFull clears the interned strings once the table is full. It must only be called before the strings of
+// a record are interned, so that the indexes of a record all refer to the same table.
+func (sw *activityDumpStreamWriter) resetStringsIfFull() {
+	if len(sw.strings) < maxStreamStrings {
+		return
+	}
+	sw.strings = make(map[string]uint64)
+	sw.writeByte(streamRecordStringReset)
+}
+
+// internStrings interns the provided strings before a record is started, so that string records are never interleaved
+// with the fields of another record
+func (sw *activityDumpStreamWriter) internStrings(values ...string) []uint64 {
+	ids := make([]uint64, len(values))
+	for i, value := range values {
+		ids[i] = sw.internString(value)
+	}
+	return ids
+}
+
+func (sw *activityDumpStreamWriter) writeStringIDs(ids []uint64) {
+	sw.writeUvarint(uint64(len(ids)))
+	for _, id := range ids {
+		sw.writeUvarint(id)
+	}
+}
+
+func (sw *activityDumpStreamWriter) writeTime(t time.Time) {
+	if t.IsZero() {
+		sw.writeUvarint(0)
+		return
+	}
+	// shift zigzag encoded deltas by one so that 0 can be used for the zero time
+	delta := t.UnixNano() - sw.start.UnixNano()
+	sw.writeUvarint((uint64(delta)<<1 ^ uint64(delta>>63)) + 1)
+}
+
+func (sw *activityDumpStreamWriter) newNodeID() uint64 {
+	id := sw.nextNodeID
+	sw.nextNodeID++
+	return id
+}
+
+func (sw *activityDumpStreamWriter) writeMetadata(ad *ActivityDump) {
+	sw.resetStringsIfFull()
+	strs := sw.internStrings(ad.Host, ad.Service, ad.Source, ad.DumpMetadata.AgentVersion, ad.DumpMetadata.AgentCommit,
+		ad.DumpMetadata.KernelVersion, ad.DumpMetadata.LinuxDistribution, ad.DumpMetadata.Arch, ad.DumpMetadata.Name,
+		ad.DumpMetadata.ProtobufVersion, ad.DumpMetadata.Comm, ad.DumpMetadata.ContainerID)
+	tags := sw.internStrings(ad.Tags...)
+
+	sw.writeByte(streamRecordMetadata)
+	for _, id := range strs {
+		sw.writeUvarint(id)
+	}
+	sw.writeBool(ad.DumpMetadata.DifferentiateArgs)
+	sw.writeVarint(ad.DumpMetadata.Start.UnixNano())
+	sw.writeVarint(int64(ad.DumpMetadata.Timeout))
+	sw.writeTime(ad.DumpMetadata.End)
+	sw.writeStringIDs(tags)
+}
+
+func (sw *activityDumpStreamWriter) internFileStrings(fe *model.FileEvent) []uint64 {
+	if fe == nil {
+		return nil
+	}
+	return sw.internStrings(fe.User, fe.Group, fe.PathnameStr, fe.BasenameStr, fe.Filesystem)
+}
+
+func (sw *activityDumpStreamWriter) writeFile(fe *model.FileEvent, strs []uint64) {
+	if fe == nil {
+		sw.writeBool(false)
+		return
+	}
+	sw.writeBool(true)
+	sw.writeUvarint(uint64(fe.UID))
+	sw.writeUvarint(uint64(fe.GID))
+	sw.writeUvarint(uint64(fe.Mode))
+	sw.writeUvarint(fe.CTime)
+	sw.writeUvarint(fe.MTime)
+	sw.writeUvarint(uint64(fe.MountID))
+	sw.writeUvarint(fe.Inode)
+	sw.writeBool(fe.InUpperLayer)
+	for _, id := range strs {
+		sw.writeUvarint(id)
+	}
+}
+
+func (sw *activityDumpStreamWriter) writeProcess(pan *ProcessActivityNode, parentID uint64, resolver *ProcessResolver) uint64 {
+	p := &pan.Process
+
+	args, envs, argv0 := p.ScrubbedArgv, p.Envs, p.Argv0
+	argsTruncated, envsTruncated := p.ArgsTruncated, p.EnvsTruncated
+	if resolver != nil && p.ArgsEntry != nil {
+		args, argsTruncated = resolver.GetProcessScrubbedArgv(p)
+		argv0, _ = resolver.GetProcessArgv0(p)
+	}
+	if resolver != nil && p.EnvsEntry != nil {
+		envs, envsTruncated = resolver.GetProcessEnvs(p)
+	}
+
+	sw.resetStringsIfFull()
+	strs := sw.internStrings(p.ContainerID, p.TTYName, p.Comm, argv0, p.Credentials.User, p.Credentials.Group,
+		p.Credentials.EUser, p.Credentials.EGroup, p.Credentials.FSUser, p.Credentials.FSGroup)
+	fileStrs := sw.internFileStrings(&p.FileEvent)
+	argsIDs := sw.internStrings(args...)
+	envsIDs := sw.internStrings(envs...)
+
+	id := sw.newNodeID()
+	sw.processes[pan] = id
+	sw.pids[id] = p.Pid
+
+	sw.writeByte(streamRecordProcess)
+	sw.writeUvarint(id)
+	sw.writeUvarint(parentID)
+	sw.writeByte(byte(pan.GenerationType))
+	sw.writeVarint(int64(p.Pid) - int64(sw.pids[parentID]))
+	sw.writeVarint(int64(p.Tid) - int64(p.Pid))
+	sw.writeVarint(int64(p.PPid) - int64(p.Pid))
+	sw.writeUvarint(uint64(p.Cookie))
+	sw.writeBool(p.IsThread)
+	sw.writeUvarint(p.SpanID)
+	sw.writeUvarint(p.TraceID)
+	sw.writeTime(p.ForkTime)
+	sw.writeTime(p.ExitTime)
+	sw.writeTime(p.ExecTime)
+	sw.writeUvarint(uint64(p.Credentials.UID))
+	sw.writeUvarint(uint64(p.Credentials.GID))
+	sw.writeUvarint(uint64(p.Credentials.EUID))
+	sw.writeUvarint(uint64(p.Credentials.EGID))
+	sw.writeUvarint(uint64(p.Credentials.FSUID))
+	sw.writeUvarint(uint64(p.Credentials.FSGID))
+	sw.writeUvarint(p.Credentials.CapEffective)
+	sw.writeUvarint(p.Credentials.CapPermitted)
+	for _, strID := range strs {
+		sw.writeUvarint(strID)
+	}
+	sw.writeFile(&p.FileEvent, fileStrs)
+	sw.writeStringIDs(argsIDs)
+	sw.writeBool(argsTruncated)
+	sw.writeStringIDs(envsIDs)
+	sw.writeBool(envsTruncated)
+	return id
+}
+
+func (sw *activityDumpStreamWriter) writeFileNode(fan *FileActivityNode, parentID uint64) uint64 {
+	sw.resetStringsIfFull()
+	nameID := sw.internString(fan.Name)
+	fileStrs := sw.internFileStrings(fan.File)
+
+	id := sw.newNodeID()
+	sw.writeByte(streamRecordFile)
+	sw.writeUvarint(id)
+	sw.writeUvarint(parentID)
+	sw.writeUvarint(nameID)
+	sw.writeBool(fan.IsPattern)
+	sw.writeByte(byte(fan.GenerationType))
+	sw.writeTime(fan.FirstSeen)
+	sw.writeFile(fan.File, fileStrs)
+	if fan.Open != nil {
+		sw.writeBool(true)
+		sw.writeVarint(fan.Open.Retval)
+		sw.writeUvarint(uint64(fan.Open.Flags))
+		sw.writeUvarint(uint64(fan.Open.Mode))
+	} else {
+		sw.writeBool(false)
+	}
+
+	for _, child := range fan.Children {
+		sw.writeFileNode(child, id)
+	}
+	return id
+}
+
+func (sw *activityDumpStreamWriter) writeDNSNode(name string, node *DNSNode, parentID uint64) {
+	sw.resetStringsIfFull()
+	nameID := sw.internString(name)
+	names := make([]string, 0, len(node.Requests))
+	for _, req := range node.Requests {
+		names = append(names, req.Name)
+	}
+	namesIDs := sw.internStrings(names...)
+
+	sw.writeByte(streamRecordDNS)
+	sw.writeUvarint(parentID)
+	sw.writeUvarint(nameID)
+	sw.writeUvarint(uint64(len(node.Requests)))
+	for i, req := range node.Requests {
+		sw.writeUvarint(namesIDs[i])
+		sw.writeUvarint(uint64(req.Type))
+		sw.writeUvarint(uint64(req.Class))
+		sw.writeUvarint(uint64(req.Size))
+		sw.writeUvarint(uint64(req.Count))
+	}
+}
+
+func (sw *activityDumpStreamWriter) writeSocketNode(node *SocketNode, parentID uint64) {
+	sw.resetStringsIfFull()
+	familyID := sw.internString(node.Family)
+	ips := make([]string, 0, len(node.Bind))
+	for _, bind := range node.Bind {
+		ips = append(ips, bind.IP)
+	}
+	ipsIDs := sw.internStrings(ips...)
+
+	sw.writeByte(streamRecordSocket)
+	sw.writeUvarint(parentID)
+	sw.writeUvarint(familyID)
+	sw.writeUvarint(uint64(len(node.Bind)))
+	for i, bind := range node.Bind {
+		sw.writeUvarint(uint64(bind.Port))
+		sw.writeUvarint(ipsIDs[i])
+	}
+}
+
+func (sw *activityDumpStreamWriter) writeSyscalls(syscalls []int, parentID uint64) {
+	sw.writeByte(streamRecordSyscalls)
+	sw.writeUvarint(parentID)
+	sw.writeUvarint(uint64(len(syscalls)))
+	for _, syscall := range syscalls {
+		sw.writeUvarint(uint64(syscall))
+	}
+}
+
+// writeProcessTree writes the nodes of the provided process tree that weren't written yet. When release is set, the
+// files, DNS, sockets and syscalls of each process are dropped from memory once they have been written, and the
+// counts of released nodes are subtracted from the provided node stats.
+func (sw *activityDumpStreamWriter) writeProcessTree(pan *ProcessActivityNode, parentID uint64, resolver *ProcessResolver, release bool, stats *ActivityDumpNodeStats) {
+	id, ok := sw.processes[pan]
+	if !ok {
+		id = sw.writeProcess(pan, parentID, resolver)
+	}
+
+	for _, fan := range pan.Files {
+		sw.writeFileNode(fan, id)
+	}
+	for name, node := range pan.DNSNames {
+		sw.writeDNSNode(name, node, id)
+	}
+	for _, node := range pan.Sockets {
+		sw.writeSocketNode(node, id)
+	}
+	if len(pan.Syscalls) > 0 {
+		sw.writeSyscalls(pan.Syscalls, id)
+	}
+
+	if release {
+		var fileNodes uint64
+		for _, fan := range pan.Files {
+			fileNodes += countFileNodes(fan)
+		}
+		stats.fileNodes -= minUint64(fileNodes, stats.fileNodes)
+		stats.dnsNodes -= minUint64(uint64(len(pan.DNSNames)), stats.dnsNodes)
+		stats.socketNodes -= minUint64(uint64(len(pan.Sockets)), stats.socketNodes)
+
+		pan.Files = make(map[string]*FileActivityNode)
+		pan.DNSNames = make(map[string]*DNSNode)
+		pan.Sockets = nil
+		pan.Syscalls = nil
+	}
+
+	for _, child := range pan.Children {
+		sw.writeProcessTree(child, id, resolver, release, stats)
+	}
+}
+
+// countFileNodes returns the number of nodes of the provided file tree
+func countFileNodes(fan *FileActivityNode) uint64 {
+	count := uint64(1)
+	for _, child := range fan.Children {
+		count += countFileNodes(child)
+	}
+	return count
+}
+
+func minUint64(a, b uint64) uint64 {
+	if a < b {
+		return a
+	}
+	return b
+}
+
+// Flush flushes the buffered records to the underlying writer
+func (sw *activityDumpStreamWriter) Flush() error {
+	if sw.err != nil {
+		return sw.err
+	}
+	return sw.w.Flush()
+}
+
+// Close flushes the buffered records and closes the underlying file, if any
+func (sw *activityDumpStreamWriter) Close() error {
+	err := sw.Flush()
+	if sw.file != nil {
+		if closeErr := sw.file.Close(); err == nil {
+			err = closeErr
+		}
+	}
+	return err
+}
+
+// activityDumpStreamReader decodes a stream in an ActivityDump, merging the nodes that were written more than once
+type activityDumpStreamReader struct {
+	r     *bufio.Reader
+	input *countingReader
+	// size is the size of the input, or -1 if it is unknown
+	size  int64
+	ad    *ActivityDump
+	start time.Time
+
+	strings   []string
+	processes map[uint64]*ProcessActivityNode
+	pids      map[uint64]uint32
+	files     map[uint64]*FileActivityNode
+}
+
+// countingReader counts the bytes read from its reader
+type countingReader struct {
+	r io.Reader
+	n int64
+}
+
+func (cr *countingReader) Read(p []byte) (int, error) {
+	n, err := cr.r.Read(p)
+	cr.n += int64(n)
+	return n, err
+}
+
+// inputSize returns the size of a stream input, or -1 if it can't be known without reading it
+func inputSize(reader io.Reader) int64 {
+	switch r := reader.(type) {
+	case interface{ Len() int }:
+		return int64(r.Len())
+	case *os.File:
+		if info, err := r.Stat(); err == nil && info.Mode().IsRegular() {
+			if offset, err := r.Seek(0, io.SeekCurrent); err == nil {
+				return info.Size() - offset
+			}
+		}
+	}
+	return -1
+}
+
+// fits returns false if the input is known to hold less than n bytes after the current position
+func (sr *activityDumpStreamReader) fits(n uint64) bool {
+	if sr.size < 0 {
+		return true
+	}
+	remaining := sr.size - (sr.input.n - int64(sr.r.Buffered()))
+	return remaining >= 0 && n <= uint64(remaining)
+}
+
+func (sr *activityDumpStreamReader) uvarint() (uint64, error) {
+	return binary.ReadUvarint(sr.r)
+}
+
+func (sr *activityDumpStreamReader) varint() (int64, error) {
+	return binary.ReadVarint(sr.r)
+}
+
+func (sr *activityDumpStreamReader) boolean() (bool, error) {
+	b, err := sr.r.ReadByte()
+	return b != 0, err
+}
+
+func (sr *activityDumpStreamReader) stringRef() (string, error) {
+	id, err := sr.uvarint()
+	if err != nil {
+		return "", err
+	}
+	if id >= uint64(len(sr.strings)) {
+		return "", fmt.Errorf("unknown string index %d", id)
+	}
+	return sr.strings[id], nil
+}
+
+func (sr *activityDumpStreamReader) stringList() ([]string, error) {
+	count, err := sr.uvarint()
+	if err != nil {
+		return nil, err
+	}
+	if count == 0 {
+		return nil, nil
+	}
+	// each element takes at least one byte
+	if count > maxStreamListLength || !sr.fits(count) {
+		return nil, fmt.Errorf("invalid string list length %d", count)
+	}
+	values := make([]string, 0, count)
+	for i := uint64(0); i < count; i++ {
+		value, err := sr.stringRef()
+		if err != nil {
+			return nil, err
+		}
+		values = append(values, value)
+	}
+	return values, nil
+}
+
+func (sr *activityDumpStreamReader) timestamp() (time.Time, error) {
+	v, err := sr.uvarint()
+	if err != nil || v == 0 {
+		return time.Time{}, err
+	}
+	v--
+	delta := int64(v>>1) ^ -int64(v&1)
+	return time.Unix(0, sr.start.UnixNano()+delta), nil
+}
+
+// fields reads a list of unsigned varints, and a list of strings
+func (sr *activityDumpStreamReader) fields(uints []*uint64, strs ...*string) error {
+	var err error
+	for _, u := range uints {
+		if *u, err = sr.uvarint(); err != nil {
+			return err
+		}
+	}
+	for _, s := range strs {
+		if *s, err = sr.stringRef(); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readString() error {
+	length, err := sr.uvarint()
+	if err != nil {
+		return err
+	}
+	if length > maxStreamStringLength || !sr.fits(length) {
+		return fmt.Errorf("invalid string length %d", length)
+	}
+	data := make([]byte, length)
+	if _, err = io.ReadFull(sr.r, data); err != nil {
+		return err
+	}
+	sr.strings = append(sr.strings, string(data))
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readMetadata() error {
+	ad := sr.ad
+	var differentiateArgs bool
+	var start, timeout int64
+	var err error
+
+	if err = sr.fields(nil, &ad.Host, &ad.Service, &ad.Source, &ad.DumpMetadata.AgentVersion, &ad.DumpMetadata.AgentCommit,
+		&ad.DumpMetadata.KernelVersion, &ad.DumpMetadata.LinuxDistribution, &ad.DumpMetadata.Arch, &ad.DumpMetadata.Name,
+		&ad.DumpMetadata.ProtobufVersion, &ad.DumpMetadata.Comm, &ad.DumpMetadata.ContainerID); err != nil {
+		return err
+	}
+	if differentiateArgs, err = sr.boolean(); err != nil {
+		return err
+	}
+	if start, err = sr.varint(); err != nil {
+		return err
+	}
+	if timeout, err = sr.varint(); err != nil {
+		return err
+	}
+
+	sr.start = time.Unix(0, start)
+	ad.DumpMetadata.DifferentiateArgs = differentiateArgs
+	ad.DumpMetadata.Timeout = time.Duration(timeout)
+	// when merging several streams, keep the earliest start
+	if ad.DumpMetadata.Start.IsZero() || sr.start.Before(ad.DumpMetadata.Start) {
+		ad.DumpMetadata.Start = sr.start
+	}
+
+	end, err := sr.timestamp()
+	if err != nil {
+		return err
+	}
+	if end.After(ad.DumpMetadata.End) {
+		ad.DumpMetadata.End = end
+	}
+
+	tags, err := sr.stringList()
+	if err != nil {
+		return err
+	}
+	if len(tags) > 0 {
+		ad.Tags = tags
+	}
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readFile() (*model.FileEvent, error) {
+	present, err := sr.boolean()
+	if err != nil || !present {
+		return nil, err
+	}
+
+	var uid, gid, mode, mountID uint64
+	fe := &model.FileEvent{}
+	if err = sr.fields([]*uint64{&uid, &gid, &mode, &fe.CTime, &fe.MTime, &mountID, &fe.Inode}); err != nil {
+		return nil, err
+	}
+	if fe.InUpperLayer, err = sr.boolean(); err != nil {
+		return nil, err
+	}
+	if err = sr.fields(nil, &fe.User, &fe.Group, &fe.PathnameStr, &fe.BasenameStr, &fe.Filesystem); err != nil {
+		return nil, err
+	}
+	fe.UID = uint32(uid)
+	fe.GID = uint32(gid)
+	fe.Mode = uint16(mode)
+	fe.MountID = uint32(mountID)
+	return fe, nil
+}
+
+func (sr *activityDumpStreamReader) readProcess() error {
+	var id, parentID uint64
+	if err := sr.fields([]*uint64{&id, &parentID}); err != nil {
+		return err
+	}
+	genType, err := sr.r.ReadByte()
+	if err != nil {
+		return err
+	}
+
+	pan := &ProcessActivityNode{
+		GenerationType: NodeGenerationType(genType),
+		Files:          make(map[string]*FileActivityNode),
+		DNSNames:       make(map[string]*DNSNode),
+	}
+	p := &pan.Process
+
+	parent, ok := sr.processes[parentID]
+	if parentID != 0 && !ok {
+		return fmt.Errorf("unknown parent process node %d", parentID)
+	}
+
+	var pidDelta, tidDelta, ppidDelta int64
+	if pidDelta, err = sr.varint(); err != nil {
+		return err
+	}
+	if tidDelta, err = sr.varint(); err != nil {
+		return err
+	}
+	if ppidDelta, err = sr.varint(); err != nil {
+		return err
+	}
+	// pids are delta encoded against the pid written for the parent, which may differ from the pid of the node it
+	// was merged with
+	p.Pid = uint32(int64(sr.pids[parentID]) + pidDelta)
+	sr.pids[id] = p.Pid
+	p.Tid = uint32(int64(p.Pid) + tidDelta)
+	p.PPid = uint32(int64(p.Pid) + ppidDelta)
+
+	var cookie, uid, gid, euid, egid, fsuid, fsgid uint64
+	if cookie, err = sr.uvarint(); err != nil {
+		return err
+	}
+	p.Cookie = uint32(cookie)
+	if p.IsThread, err = sr.boolean(); err != nil {
+		return err
+	}
+	if err = sr.fields([]*uint64{&p.SpanID, &p.TraceID}); err != nil {
+		return err
+	}
+	if p.ForkTime, err = sr.timestamp(); err != nil {
+		return err
+	}
+	if p.ExitTime, err = sr.timestamp(); err != nil {
+		return err
+	}
+	if p.ExecTime, err = sr.timestamp(); err != nil {
+		return err
+	}
+
+	creds := &p.Credentials
+	if err = sr.fields([]*uint64{&uid, &gid, &euid, &egid, &fsuid, &fsgid, &creds.CapEffective, &creds.CapPermitted},
+		&p.ContainerID, &p.TTYName, &p.Comm, &p.Argv0, &creds.User, &creds.Group, &creds.EUser, &creds.EGroup,
+		&creds.FSUser, &creds.FSGroup); err != nil {
+		return err
+	}
+	creds.UID, creds.GID, creds.EUID, creds.EGID = uint32(uid), uint32(gid), uint32(euid), uint32(egid)
+	creds.FSUID, creds.FSGID = uint32(fsuid), uint32(fsgid)
+
+	fe, err := sr.readFile()
+	if err != nil {
+		return err
+	}
+	if fe != nil {
+		p.FileEvent = *fe
+	}
+
+	if p.ScrubbedArgv, err = sr.stringList(); err != nil {
+		return err
+	}
+	p.ScrubbedArgvResolved = true
+	if p.ArgsTruncated, err = sr.boolean(); err != nil {
+		return err
+	}
+	p.ScrubbedArgsTruncated = p.ArgsTruncated
+	if p.Envs, err = sr.stringList(); err != nil {
+		return err
+	}
+	if p.EnvsTruncated, err = sr.boolean(); err != nil {
+		return err
+	}
+
+	// look for an existing node, which can happen when several streams are merged
+	siblings := &sr.ad.ProcessActivityTree
+	if parent != nil {
+		siblings = &parent.Children
+	}
+	for _, sibling := range *siblings {
+		if sibling.matchesDecodedNode(pan, sr.ad.DumpMetadata.DifferentiateArgs) {
+			sr.processes[id] = sibling
+			return nil
+		}
+	}
+
+	*siblings = append(*siblings, pan)
+	sr.processes[id] = pan
+	sr.ad.nodeStats.processNodes++
+	return nil
+}
+
+// matchesDecodedNode returns true if the provided decoded node describes the same process as the current node
+func (pan *ProcessActivityNode) matchesDecodedNode(other *ProcessActivityNode, matchArgs bool) bool {
+	if pan.Process.Comm != other.Process.Comm || pan.Process.FileEvent.PathnameStr != other.Process.FileEvent.PathnameStr ||
+		pan.Process.Credentials != other.Process.Credentials {
+		return false
+	}
+	if !matchArgs {
+		return true
+	}
+	if len(pan.Process.ScrubbedArgv) != len(other.Process.ScrubbedArgv) {
+		return false
+	}
+	for i, arg := range pan.Process.ScrubbedArgv {
+		if other.Process.ScrubbedArgv[i] != arg {
+			return false
+		}
+	}
+	return true
+}
+
+func (sr *activityDumpStreamReader) readFileNode() error {
+	var id, parentID uint64
+	if err := sr.fields([]*uint64{&id, &parentID}); err != nil {
+		return err
+	}
+	name, err := sr.stringRef()
+	if err != nil {
+		return err
+	}
+
+	fan := &FileActivityNode{
+		Name:     name,
+		Children: make(map[string]*FileActivityNode),
+	}
+	if fan.IsPattern, err = sr.boolean(); err != nil {
+		return err
+	}
+	genType, err := sr.r.ReadByte()
+	if err != nil {
+		return err
+	}
+	fan.GenerationType = NodeGenerationType(genType)
+	if fan.FirstSeen, err = sr.timestamp(); err != nil {
+		return err
+	}
+	if fan.File, err = sr.readFile(); err != nil {
+		return err
+	}
+
+	hasOpen, err := sr.boolean()
+	if err != nil {
+		return err
+	}
+	if hasOpen {
+		var flags, mode uint64
+		fan.Open = &OpenNode{}
+		if fan.Open.Retval, err = sr.varint(); err != nil {
+			return err
+		}
+		if err = sr.fields([]*uint64{&flags, &mode}); err != nil {
+			return err
+		}
+		fan.Open.Flags = uint32(flags)
+		fan.Open.Mode = uint32(mode)
+	}
+
+	var siblings map[string]*FileActivityNode
+	if pan, ok := sr.processes[parentID]; ok {
+		siblings = pan.Files
+	} else if parent, ok := sr.files[parentID]; ok {
+		siblings = parent.Children
+	} else {
+		return fmt.Errorf("unknown parent node %d", parentID)
+	}
+
+	existing, ok := siblings[name]
+	if !ok {
+		siblings[name] = fan
+		sr.files[id] = fan
+		sr.ad.nodeStats.fileNodes++
+		return nil
+	}
+
+	// merge with the node that was written earlier
+	if existing.File == nil {
+		existing.File = fan.File
+	}
+	if existing.Open == nil {
+		existing.Open = fan.Open
+	}
+	if existing.FirstSeen.IsZero() || (!fan.FirstSeen.IsZero() && fan.FirstSeen.Before(existing.FirstSeen)) {
+		existing.FirstSeen = fan.FirstSeen
+	}
+	sr.files[id] = existing
+	return nil
+}
+
+func (sr *activityDumpStreamReader) parentProcess() (*ProcessActivityNode, error) {
+	parentID, err := sr.uvarint()
+	if err != nil {
+		return nil, err
+	}
+	pan, ok := sr.processes[parentID]
+	if !ok {
+		return nil, fmt.Errorf("unknown parent process node %d", parentID)
+	}
+	return pan, nil
+}
+
+func (sr *activityDumpStreamReader) readDNSNode() error {
+	pan, err := sr.parentProcess()
+	if err != nil {
+		return err
+	}
+	name, err := sr.stringRef()
+	if err != nil {
+		return err
+	}
+	count, err := sr.uvarint()
+	if err != nil {
+		return err
+	}
+
+	node, ok := pan.DNSNames[name]
+	if !ok {
+		node = &DNSNode{}
+		pan.DNSNames[name] = node
+		sr.ad.nodeStats.dnsNodes++
+	}
+
+	for i := uint64(0); i < count; i++ {
+		var reqType, class, size, reqCount uint64
+		var req model.DNSEvent
+		if err = sr.fields(nil, &req.Name); err != nil {
+			return err
+		}
+		if err = sr.fields([]*uint64{&reqType, &class, &size, &reqCount}); err != nil {
+			return err
+		}
+		req.Type, req.Class, req.Size, req.Count = uint16(reqType), uint16(class), uint16(size), uint16(reqCount)
+
+		var found bool
+		for _, existing := range node.Requests {
+			if existing.Type == req.Type {
+				found = true
+				break
+			}
+		}
+		if !found {
+			node.Requests = append(node.Requests, req)
+		}
+	}
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readSocketNode() error {
+	pan, err := sr.parentProcess()
+	if err != nil {
+		return err
+	}
+	family, err := sr.stringRef()
+	if err != nil {
+		return err
+	}
+	count, err := sr.uvarint()
+	if err != nil {
+		return err
+	}
+
+	var node *SocketNode
+	for _, sock := range pan.Sockets {
+		if sock.Family == family {
+			node = sock
+		}
+	}
+	if node == nil {
+		node = &SocketNode{Family: family}
+		pan.Sockets = append(pan.Sockets, node)
+		sr.ad.nodeStats.socketNodes++
+	}
+
+bindLoop:
+	for i := uint64(0); i < count; i++ {
+		var port uint64
+		bind := &BindNode{}
+		if err = sr.fields([]*uint64{&port}, &bind.IP); err != nil {
+			return err
+		}
+		bind.Port = uint16(port)
+
+		for _, existing := range node.Bind {
+			if existing.Port == bind.Port && existing.IP == bind.IP {
+				continue bindLoop
+			}
+		}
+		node.Bind = append(node.Bind, bind)
+	}
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readSyscalls() error {
+	pan, err := sr.parentProcess()
+	if err != nil {
+		return err
+	}
+	count, err := sr.uvarint()
+	if err != nil {
+		return err
+	}
+
+syscallLoop:
+	for i := uint64(0); i < count; i++ {
+		syscall, err := sr.uvarint()
+		if err != nil {
+			return err
+		}
+		for _, existing := range pan.Syscalls {
+			if existing == int(syscall) {
+				continue syscallLoop
+			}
+		}
+		pan.Syscalls = append(pan.Syscalls, int(syscall))
+	}
+	return nil
+}
+
+func (sr *activityDumpStreamReader) readRecords() error {
+	var magic [4]byte
+	if _, err := io.ReadFull(sr.r, magic[:]); err != nil || magic != streamMagic {
+		return ErrInvalidStreamHeader
+	}
+
+	for {
+		recordType, err := sr.r.ReadByte()
+		if err == io.EOF {
+			return nil
+		} else if err != nil {
+			return err
+		}
+
+		switch recordType {
+		case streamRecordString:
+			err = sr.readString()
+		case streamRecordStringReset:
+			sr.strings = sr.strings[:1]
+		case streamRecordMetadata:
+			err = sr.readMetadata()
+		case streamRecordProcess:
+			err = sr.readProcess()
+		case streamRecordFile:
+			err = sr.readFileNode()
+		case streamRecordDNS:
+			err = sr.readDNSNode()
+		case streamRecordSocket:
+			err = sr.readSocketNode()
+		case streamRecordSyscalls:
+			err = sr.readSyscalls()
+		default:
+			err = fmt.Errorf("unknown record type %d", recordType)
+		}
+
+		if err == io.EOF {
+			// the last record was truncated, which happens when the stream of a running dump is decoded
+			return nil
+		} else if err != nil {
+			return err
+		}
+	}
+}
+
+// EncodeStream encodes an activity dump in the stream format
+func (ad *ActivityDump) EncodeStream() (*bytes.Buffer, error) {
+	ad.Lock()
+	defer ad.Unlock()
+
+	if ad.streamFilePath != "" {
+		return ad.encodeStreamFile()
+	}
+
+	var buf bytes.Buffer
+	sw := newActivityDumpStreamWriter(&buf, ad.DumpMetadata.Start)
+	sw.writeMetadata(ad)
+	for _, pan := range ad.ProcessActivityTree {
+		sw.writeProcessTree(pan, 0, nil, false, nil)
+	}
+	if err := sw.Flush(); err != nil {
+		return nil, fmt.Errorf("couldn't encode in %s: %v", dump.Stream, err)
+	}
+	return &buf, nil
+}
+
+// DecodeStream decodes an activity dump stream. Decoding multiple streams in the same dump merges them.
+func (ad *ActivityDump) DecodeStream(reader io.Reader) error {
+	ad.Lock()
+	defer ad.Unlock()
+
+	return ad.decodeStream(reader)
+}
+
+func (ad *ActivityDump) decodeStream(reader io.Reader) error {
+	if ad.CookiesNode == nil {
+		ad.CookiesNode = make(map[uint32]*ProcessActivityNode)
+	}
+
+	input := &countingReader{r: reader}
+	sr := &activityDumpStreamReader{
+		r:         bufio.NewReader(input),
+		input:     input,
+		size:      inputSize(reader),
+		ad:        ad,
+		start:     ad.DumpMetadata.Start,
+		strings:   []string{""},
+		processes: make(map[uint64]*ProcessActivityNode),
+		pids:      make(map[uint64]uint32),
+		files:     make(map[uint64]*FileActivityNode),
+	}
+	if err := sr.readRecords(); err != nil {
+		return fmt.Errorf("couldn't decode activity dump stream: %w", err)
+	}
+	return nil
+}
+
+// getStreamFilePath returns the path of the file used to stream the current dump
+func (ad *ActivityDump) getStreamFilePath() string {
+	return path.Join(ad.adm.probe.config.ActivityDumpStreamDirectory, ad.DumpMetadata.Name+"."+dump.Stream.String())
+}
+
+// flushStream appends the new nodes of the activity dump to its stream file and releases them from memory. Only the
+// process nodes are kept so that new events can still be attached to the right process.
+func (ad *ActivityDump) flushStream() error {
+	if ad.stream == nil {
+		stream, err := newActivityDumpStreamFileWriter(ad.getStreamFilePath(), ad.DumpMetadata.Start)
+		if err != nil {
+			return err
+		}
+		ad.stream = stream
+		ad.stream.writeMetadata(ad)
+	}
+
+	for _, pan := range ad.ProcessActivityTree {
+		ad.stream.writeProcessTree(pan, 0, ad.adm.probe.resolvers.ProcessResolver, true, &ad.nodeStats)
+	}
+	return ad.stream.Flush()
+}
+
+// FlushStream is the thread safe version of flushStream
+func (ad *ActivityDump) FlushStream() error {
+	ad.Lock()
+	defer ad.Unlock()
+
+	if ad.state != Running {
+		return nil
+	}
+	return ad.flushStream()
+}
+
+// finalizeStream writes the remaining nodes of a stopped dump and closes its stream. The local requests of the stream
+// format are served from the stream file as is. The full activity tree is only rebuilt from the stream when another
+// format, or a remote storage, was requested.
+func (ad *ActivityDump) finalizeStream() error {
+	if ad.stream == nil {
+		return nil
+	}
+
+	if err := ad.flushStream(); err != nil {
+		return err
+	}
+	ad.stream.writeMetadata(ad)
+	if err := ad.stream.Close(); err != nil {
+		return err
+	}
+	ad.stream = nil
+	ad.streamFilePath = ad.getStreamFilePath()
+
+	if !ad.needsActivityTree() {
+		return nil
+	}
+
+	f, err := os.Open(ad.streamFilePath)
+	if err != nil {
+		return fmt.Errorf("couldn't open activity dump stream: %w", err)
+	}
+	defer f.Close()
+
+	ad.ProcessActivityTree = nil
+	ad.CookiesNode = make(map[uint32]*ProcessActivityNode)
+	ad.nodeStats = ActivityDumpNodeStats{}
+	return ad.decodeStream(f)
+}
+
+// needsActivityTree returns true if a storage request can't be served from the stream file
+func (ad *ActivityDump) needsActivityTree() bool {
+	for format, requests := range ad.StorageRequests {
+		for _, request := range requests {
+			if format != dump.Stream || request.Type != dump.LocalStorage {
+				return true
+			}
+		}
+	}
+	return false
+}
+
+// encodeStreamFile returns the content of the stream file of a finalized dump
+func (ad *ActivityDump) encodeStreamFile() (*bytes.Buffer, error) {
+	f, err := os.Open(ad.streamFilePath)
+	if err != nil {
+		return nil, fmt.Errorf("couldn't open activity dump stream: %w", err)
+	}
+	defer f.Close()
+
+	var buf bytes.Buffer
+	if _, err = buf.ReadFrom(f); err != nil {
+		return nil, fmt.Errorf("couldn't read activity dump stream: %w", err)
+	}
+	return &buf, nil
+}
+
+// removeStreamFile removes the stream file of a finalized dump, once it has been persisted
+func (ad *ActivityDump) removeStreamFile() {
+	ad.Lock()
+	defer ad.Unlock()
+
+	if ad.streamFilePath == "" {
+		return
+	}
+	if err := os.Remove(ad.streamFilePath); err != nil {
+		seclog.Warnf("couldn't remove the stream of [%s]: %v", ad.getSelectorStr(), err)
+	}
+	ad.streamFilePath = ""
+}
@@ -0,0 +1,249 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package probe
+
+import (
+	"bytes"
+	"fmt"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/DataDog/datadog-agent/pkg/security/probe/dump"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+)
+
+func newTestStreamDump(start time.Time) *ActivityDump {
+	return &ActivityDump{
+		Mutex: &sync.Mutex{},
+		Host:  "host",
+		Tags:  []string{"image_name:test"},
+		DumpMetadata: DumpMetadata{
+			Name:              "test-dump",
+			ContainerID:       "0123456789abcdef",
+			DifferentiateArgs: true,
+			Start:             start,
+			Timeout:           time.Minute,
+		},
+	}
+}
+
+func newTestStreamProcess(pid uint32, comm string, path string, args ...string) *ProcessActivityNode {
+	pan := &ProcessActivityNode{
+		GenerationType: Runtime,
+		Files:          make(map[string]*FileActivityNode),
+		DNSNames:       make(map[string]*DNSNode),
+	}
+	pan.Process.Pid = pid
+	pan.Process.Tid = pid
+	pan.Process.PPid = pid - 1
+	pan.Process.Comm = comm
+	pan.Process.FileEvent.PathnameStr = path
+	pan.Process.Credentials.User = "root"
+	pan.Process.ScrubbedArgv = args
+	return pan
+}
+
+func newTestStreamFile(name string, openFlags uint32, children ...*FileActivityNode) *FileActivityNode {
+	fan := &FileActivityNode{
+		Name:           name,
+		GenerationType: Runtime,
+		Children:       make(map[string]*FileActivityNode),
+	}
+	if openFlags != 0 {
+		fan.Open = &OpenNode{Flags: openFlags}
+	}
+	for _, child := range children {
+		fan.Children[child.Name] = child
+	}
+	return fan
+}
+
+func TestActivityDumpStreamRoundTrip(t *testing.T) {
+	start := time.Unix(1000, 0)
+	ad := newTestStreamDump(start)
+
+	root := newTestStreamProcess(100, "bash", "/usr/bin/bash")
+	root.Process.ExecTime = start.Add(-time.Second)
+	child := newTestStreamProcess(142, "curl", "/usr/bin/curl", "curl", "example.com")
+	child.Files["etc"] = newTestStreamFile("etc", 0, newTestStreamFile("hosts", 1))
+	child.DNSNames["example.com"] = &DNSNode{Requests: []model.DNSEvent{{Name: "example.com", Type: 1, Class: 1}}}
+	child.Sockets = []*SocketNode{{Family: "AF_INET", Bind: []*BindNode{{Port: 8080, IP: "0.0.0.0"}}}}
+	child.Syscalls = []int{0, 1, 59}
+	root.Children = []*ProcessActivityNode{child}
+	ad.ProcessActivityTree = []*ProcessActivityNode{root}
+
+	buf, err := ad.EncodeStream()
+	assert.NoError(t, err)
+
+	decoded := newTestStreamDump(time.Time{})
+	decoded.Tags = nil
+	assert.NoError(t, decoded.DecodeStream(buf))
+
+	assert.Equal(t, start, decoded.DumpMetadata.Start)
+	assert.Equal(t, []string{"image_name:test"}, decoded.Tags)
+	if !assert.Len(t, decoded.ProcessActivityTree, 1) {
+		return
+	}
+	decodedRoot := decoded.ProcessActivityTree[0]
+	assert.Equal(t, uint32(100), decodedRoot.Process.Pid)
+	assert.Equal(t, root.Process.ExecTime.UnixNano(), decodedRoot.Process.ExecTime.UnixNano())
+	assert.True(t, decodedRoot.Process.ForkTime.IsZero())
+
+	if !assert.Len(t, decodedRoot.Children, 1) {
+		return
+	}
+	decodedChild := decodedRoot.Children[0]
+	assert.Equal(t, uint32(142), decodedChild.Process.Pid)
+	assert.Equal(t, uint32(141), decodedChild.Process.PPid)
+	assert.Equal(t, "curl", decodedChild.Process.Comm)
+	assert.Equal(t, "root", decodedChild.Process.Credentials.User)
+	assert.Equal(t, []string{"curl", "example.com"}, decodedChild.Process.ScrubbedArgv)
+	assert.Equal(t, uint32(1), decodedChild.Files["etc"].Children["hosts"].Open.Flags)
+	assert.Nil(t, decodedChild.Files["etc"].Open)
+	assert.Len(t, decodedChild.DNSNames["example.com"].Requests, 1)
+	assert.Equal(t, uint16(8080), decodedChild.Sockets[0].Bind[0].Port)
+	assert.Equal(t, []int{0, 1, 59}, decodedChild.Syscalls)
+}
+
+func TestActivityDumpStreamIncremental(t *testing.T) {
+	ad := newTestStreamDump(time.Unix(1000, 0))
+	pan := newTestStreamProcess(100, "nginx", "/usr/sbin/nginx")
+	pan.Files["etc"] = newTestStreamFile("etc", 0, newTestStreamFile("nginx.conf", 1))
+	pan.Syscalls = []int{0, 1}
+	ad.ProcessActivityTree = []*ProcessActivityNode{pan}
+	ad.nodeStats = ActivityDumpNodeStats{processNodes: 1, fileNodes: 2}
+
+	var buf bytes.Buffer
+	sw := newActivityDumpStreamWriter(&buf, ad.DumpMetadata.Start)
+	sw.writeMetadata(ad)
+	sw.writeProcessTree(pan, 0, nil, true, &ad.nodeStats)
+
+	// the children of the process are released, the process itself is kept
+	assert.Empty(t, pan.Files)
+	assert.Empty(t, pan.Syscalls)
+	assert.Equal(t, ActivityDumpNodeStats{processNodes: 1}, ad.nodeStats)
+
+	// new activity on an already written directory, and an already written syscall
+	pan.Files["etc"] = newTestStreamFile("etc", 0, newTestStreamFile("mime.types", 1))
+	pan.Syscalls = []int{1, 2}
+	sw.writeProcessTree(pan, 0, nil, true, &ad.nodeStats)
+	assert.NoError(t, sw.Flush())
+
+	decoded := newTestStreamDump(time.Time{})
+	assert.NoError(t, decoded.DecodeStream(&buf))
+
+	if !assert.Len(t, decoded.ProcessActivityTree, 1) {
+		return
+	}
+	etc := decoded.ProcessActivityTree[0].Files["etc"]
+	assert.Len(t, etc.Children, 2)
+	assert.Contains(t, etc.Children, "nginx.conf")
+	assert.Contains(t, etc.Children, "mime.types")
+	assert.ElementsMatch(t, []int{0, 1, 2}, decoded.ProcessActivityTree[0].Syscalls)
+	assert.Equal(t, uint64(3), decoded.nodeStats.fileNodes)
+}
+
+func TestActivityDumpStreamStringReset(t *testing.T) {
+	ad := newTestStreamDump(time.Unix(1000, 0))
+	root := newTestStreamProcess(100, "bash", "/usr/bin/bash")
+	// enough file names to fill the string table, the child process is written after the reset
+	for i := 0; i < maxStreamStrings+10; i++ {
+		name := fmt.Sprintf("file-%d", i)
+		root.Files[name] = newTestStreamFile(name, 1)
+	}
+	child := newTestStreamProcess(142, "curl", "/usr/bin/curl", "curl", "example.com")
+	child.Files["etc"] = newTestStreamFile("etc", 0, newTestStreamFile("hosts", 1))
+	root.Children = []*ProcessActivityNode{child}
+	ad.ProcessActivityTree = []*ProcessActivityNode{root}
+
+	var buf bytes.Buffer
+	sw := newActivityDumpStreamWriter(&buf, ad.DumpMetadata.Start)
+	sw.writeMetadata(ad)
+	sw.writeProcessTree(root, 0, nil, false, nil)
+	assert.NoError(t, sw.Flush())
+	assert.Less(t, len(sw.strings), maxStreamStrings)
+
+	decoded := newTestStreamDump(time.Time{})
+	assert.NoError(t, decoded.DecodeStream(&buf))
+
+	if !assert.Len(t, decoded.ProcessActivityTree, 1) {
+		return
+	}
+	decodedRoot := decoded.ProcessActivityTree[0]
+	assert.Len(t, decodedRoot.Files, maxStreamStrings+10)
+	assert.Contains(t, decodedRoot.Files, fmt.Sprintf("file-%d", maxStreamStrings+9))
+	if !assert.Len(t, decodedRoot.Children, 1) {
+		return
+	}
+	decodedChild := decodedRoot.Children[0]
+	assert.Equal(t, "curl", decodedChild.Process.Comm)
+	assert.Equal(t, "/usr/bin/curl", decodedChild.Process.FileEvent.PathnameStr)
+	assert.Equal(t, []string{"curl", "example.com"}, decodedChild.Process.ScrubbedArgv)
+	assert.Contains(t, decodedChild.Files["etc"].Children, "hosts")
+}
+
+func TestActivityDumpStreamMerge(t *testing.T) {
+	first := newTestStreamDump(time.Unix(1000, 0))
+	pan := newTestStreamProcess(100, "nginx", "/usr/sbin/nginx")
+	pan.Files["etc"] = newTestStreamFile("etc", 1)
+	first.ProcessActivityTree = []*ProcessActivityNode{pan}
+
+	second := newTestStreamDump(time.Unix(2000, 0))
+	other := newTestStreamProcess(200, "nginx", "/usr/sbin/nginx")
+	other.Files["var"] = newTestStreamFile("var", 1)
+	second.ProcessActivityTree = []*ProcessActivityNode{other, newTestStreamProcess(300, "sh", "/bin/sh")}
+
+	merged := newTestStreamDump(time.Time{})
+	for _, ad := range []*ActivityDump{first, second} {
+		buf, err := ad.EncodeStream()
+		assert.NoError(t, err)
+		assert.NoError(t, merged.DecodeStream(buf))
+	}
+
+	assert.Equal(t, time.Unix(1000, 0), merged.DumpMetadata.Start)
+	if !assert.Len(t, merged.ProcessActivityTree, 2) {
+		return
+	}
+	assert.Contains(t, merged.ProcessActivityTree[0].Files, "etc")
+	assert.Contains(t, merged.ProcessActivityTree[0].Files, "var")
+	assert.Equal(t, "sh", merged.ProcessActivityTree[1].Process.Comm)
+}
+
+func TestActivityDumpStreamInvalidHeader(t *testing.T) {
+	ad := newTestStreamDump(time.Time{})
+	assert.ErrorIs(t, ad.DecodeStream(bytes.NewBufferString("not a stream")), ErrInvalidStreamHeader)
+}
+
+func TestActivityDumpStreamInvalidLengths(t *testing.T) {
+	for _, record := range [][]byte{
+		// a string longer than the remaining input
+		{streamRecordString, 0xff, 0xff, 0x03, 'a', 'b'},
+		// a string longer than the maximum length
+		{streamRecordString, 0xff, 0xff, 0xff, 0xff, 0x0f},
+	} {
+		input := append(append([]byte{}, streamMagic[:]...), record...)
+		ad := newTestStreamDump(time.Time{})
+		assert.Error(t, ad.DecodeStream(bytes.NewReader(input)))
+	}
+}
+
+func TestActivityDumpStreamNeedsActivityTree(t *testing.T) {
+	ad := newTestStreamDump(time.Time{})
+	ad.StorageRequests = map[dump.StorageFormat][]dump.StorageRequest{
+		dump.Stream: {dump.NewStorageRequest(dump.LocalStorage, dump.Stream, false, "/tmp")},
+	}
+	assert.False(t, ad.needsActivityTree())
+
+	// the remote requests keep their format, and are encoded from the rebuilt tree
+	ad.StorageRequests[dump.PROTOBUF] = []dump.StorageRequest{dump.NewStorageRequest(dump.RemoteStorage, dump.PROTOBUF, true, "")}
+	assert.True(t, ad.needsActivityTree())
+}
@@ -87,7 +87,7 @@ func (rsa *RuleSetApplier) setupFilters(rs *rules.RuleSet, eventType eval.EventT
 		return rsa.applyFilterPolicy(eventType, PolicyModeAccept, math.MaxUint8)
 	}
 
-	return rsa.applyFilterPolicy(eventType, PolicyModeDeny, capabilities.GetFlags())
+	return rsa.applyFilterPolicy(eventType, PolicyModeDeny, capabilities.GetApproverFlags(approvers))
 }
 
 // Apply setup the filters for the provided set of rules and returns the policy report.
@@ -10,6 +10,7 @@ package probe
 
 import (
 	"path"
+	"strings"
 
 	"github.com/DataDog/datadog-agent/pkg/security/ebpf"
 	"github.com/DataDog/datadog-agent/pkg/security/secl/compiler/eval"
@@ -93,6 +94,10 @@ func onNewBasenameApprovers(probe *Probe, eventType model.EventType, field strin
 		case prefix + model.PathSuffix:
 			for _, value := range stringValues(values) {
 				basename := path.Base(value)
+				if strings.Contains(basename, "*") {
+					// handled by the parent name approvers
+					continue
+				}
 				activeApprover, err := approveBasename("basename_approvers", eventType, basename)
 				if err != nil {
 					return nil, err
@@ -105,6 +110,45 @@ func onNewBasenameApprovers(probe *Probe, eventType model.EventType, field strin
 	return basenameApprovers, nil
 }
 
+// parentNameMapItem describes a key of the parent_name_approvers table
+type parentNameMapItem struct {
+	depth uint32
+	name  string
+}
+
+// MarshalBinary returns the binary representation of a parentNameMapItem
+func (i parentNameMapItem) MarshalBinary() ([]byte, error) {
+	data := make([]byte, 4+ParentNameFilterSize)
+	model.ByteOrder.PutUint32(data[0:4], i.depth)
+	// keep the trailing NUL byte, as bpf_probe_read_str does
+	copy(data[4:4+ParentNameFilterSize-1], i.name)
+	return data, nil
+}
+
+func approveParentNames(tableName string, eventType model.EventType, glob string) (approvers []activeApprover) {
+	components := parentNameComponents(glob)
+	for i, component := range components {
+		approvers = append(approvers, &mapParentNameMask{
+			tableName: tableName,
+			tableKey:  parentNameMapItem{depth: uint32(i + 1), name: component},
+			isLast:    i == len(components)-1,
+			eventMask: uint64(1 << (eventType - 1)),
+		})
+	}
+	return approvers
+}
+
+func onNewParentNameApprovers(probe *Probe, eventType model.EventType, field string, approvers rules.Approvers) ([]activeApprover, error) {
+	var parentNameApprovers []activeApprover
+	for _, value := range approvers[eventType.String()+"."+field+model.PathSuffix] {
+		if value.Type != eval.GlobValueType {
+			continue
+		}
+		parentNameApprovers = append(parentNameApprovers, approveParentNames("parent_name_approvers", eventType, value.Value.(string))...)
+	}
+	return parentNameApprovers, nil
+}
+
 func onNewBasenameApproversWrapper(event model.EventType) onApproverHandler {
 	return func(probe *Probe, approvers rules.Approvers) (activeApprovers, error) {
 		basenameApprovers, err := onNewBasenameApprovers(probe, event, "file", approvers)
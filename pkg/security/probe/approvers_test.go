@@ -106,3 +106,92 @@ func TestApproverAncestors3(t *testing.T) {
 		t.Fatalf("expected approver not found: %v", values)
 	}
 }
+
+func TestApproverParentName(t *testing.T) {
+	enabled := map[eval.EventType]bool{"*": true}
+
+	var evalOpts eval.Opts
+	evalOpts.
+		WithConstants(model.SECLConstants).
+		WithLegacyFields(model.SECLLegacyFields)
+
+	var opts rules.Opts
+	opts.
+		WithEventTypeEnabled(enabled).
+		WithLogger(seclog.DefaultLogger)
+
+	m := &model.Model{}
+	rs := rules.NewRuleSet(m, m.NewEvent, &opts, &evalOpts, &eval.MacroStore{})
+	addRuleExpr(t, rs, `open.file.path =~ "/etc/ssh/*"`, `open.file.path == "/etc/passwd"`)
+	capabilities, exists := allCapabilities["open"]
+	if !exists {
+		t.Fatal("no capabilities for open")
+	}
+	approvers, err := rs.GetEventApprovers("open", capabilities.GetFieldCapabilities())
+	if err != nil {
+		t.Fatal(err)
+	}
+	if values, exists := approvers["open.file.path"]; !exists || len(values) != 2 {
+		t.Fatalf("expected approver not found: %v", values)
+	}
+
+	parentNameApprovers, err := onNewParentNameApprovers(nil, model.FileOpenEventType, "file", approvers)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(parentNameApprovers) != 2 {
+		t.Fatalf("expected 2 parent name approvers, got: %v", parentNameApprovers)
+	}
+
+	last := parentNameApprovers[1].(*mapParentNameMask)
+	if last.tableKey.depth != 2 || last.tableKey.name != "etc" || !last.isLast {
+		t.Errorf("unexpected last parent name approver: %+v", last)
+	}
+
+	if flags := capabilities.GetApproverFlags(approvers); flags&PolicyFlagParentName == 0 {
+		t.Errorf("expected the parent name policy flag, got: %v", flags)
+	}
+}
+
+func TestApproverParentNameFlag(t *testing.T) {
+	capabilities, exists := allCapabilities["open"]
+	if !exists {
+		t.Fatal("no capabilities for open")
+	}
+
+	approvers := rules.Approvers{
+		"open.file.path": rules.FilterValues{
+			{Field: "open.file.path", Value: "/etc/passwd", Type: eval.ScalarValueType},
+		},
+	}
+	if flags := capabilities.GetApproverFlags(approvers); flags&PolicyFlagParentName != 0 || flags&PolicyFlagBasename == 0 {
+		t.Errorf("unexpected policy flags for basename approvers: %v", flags)
+	}
+}
+
+func TestParentNameComponents(t *testing.T) {
+	tests := map[string][]string{
+		"/etc/ssh/*":        {"ssh", "etc"},
+		"/etc/ssh/*.conf":   {"ssh", "etc"},
+		"/*":                nil,
+		"/etc/ssh/**":       nil,
+		"/etc/*/ssh/*":      nil,
+		"/etc/ssh/config":   nil,
+		"etc/ssh/*":         nil,
+		"/a/b/c/d/e/*":      nil,
+		"/var/run/../tmp/*": nil,
+	}
+
+	for glob, expected := range tests {
+		components := parentNameComponents(glob)
+		if len(components) != len(expected) {
+			t.Errorf("unexpected components for %s: %v", glob, components)
+			continue
+		}
+		for i := range expected {
+			if components[i] != expected[i] {
+				t.Errorf("unexpected components for %s: %v", glob, components)
+			}
+		}
+	}
+}
@@ -39,6 +39,29 @@ func (caps Capabilities) GetFlags() PolicyFlag {
 	return flags
 }
 
+// GetApproverFlags returns the policy flags for the set of capabilities and the approvers of an event type. The parent
+// name flag is only set when the approvers produce parent name entries, so that the kernel doesn't walk the parent
+// dentries of every event for nothing.
+func (caps Capabilities) GetApproverFlags(approvers rules.Approvers) PolicyFlag {
+	flags := caps.GetFlags()
+	if flags&PolicyFlagParentName == 0 {
+		return flags
+	}
+
+	for field, cap := range caps {
+		if cap.PolicyFlags&PolicyFlagParentName == 0 {
+			continue
+		}
+		for _, value := range approvers[field] {
+			if validateParentNameFilter(value) {
+				return flags
+			}
+		}
+	}
+
+	return flags &^ PolicyFlagParentName
+}
+
 // GetFields returns the fields associated with a set of capabilities
 func (caps Capabilities) GetFields() []eval.Field {
 	var fields []eval.Field
@@ -80,6 +103,44 @@ func validateBasenameFilter(value rules.FilterValue) bool {
 	return false
 }
 
+// parentNameComponents returns the directory components of a glob whose wildcards are restricted to the basename,
+// starting from the parent directory, or nil if the glob can't be approved by parent names
+func parentNameComponents(glob string) []string {
+	dir, basename := path.Split(glob)
+	if !path.IsAbs(glob) || !strings.Contains(basename, "*") || strings.Contains(basename, "**") || strings.Contains(dir, "*") {
+		return nil
+	}
+
+	dir = strings.Trim(dir, "/")
+	if dir == "" {
+		return nil
+	}
+
+	components := strings.Split(dir, "/")
+	if len(components) > ParentNameApproverMaxDepth {
+		return nil
+	}
+
+	for i, j := 0, len(components)-1; i < j; i, j = i+1, j-1 {
+		components[i], components[j] = components[j], components[i]
+	}
+	for _, component := range components {
+		if component == "" || component == "." || component == ".." {
+			return nil
+		}
+	}
+
+	return components
+}
+
+func validateParentNameFilter(value rules.FilterValue) bool {
+	return value.Type == eval.GlobValueType && parentNameComponents(value.Value.(string)) != nil
+}
+
+func validatePathFilter(value rules.FilterValue) bool {
+	return validateBasenameFilter(value) || validateParentNameFilter(value)
+}
+
 func oneBasenameCapabilities(event string) Capabilities {
 	return Capabilities{
 		event + ".file.path": {
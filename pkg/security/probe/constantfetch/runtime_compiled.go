@@ -18,8 +18,6 @@ import (
 	"strings"
 	"text/template"
 
-	"golang.org/x/sys/unix"
-
 	"github.com/DataDog/datadog-go/v5/statsd"
 
 	"github.com/DataDog/datadog-agent/pkg/ebpf"
@@ -181,18 +179,13 @@ func (p *constantFetcherRCProvider) GetInputReader(config *ebpf.Config, tm *runt
 	return strings.NewReader(p.cCode), nil
 }
 
-func (a *constantFetcherRCProvider) GetOutputFilePath(config *ebpf.Config, uname *unix.Utsname, flagHash string, tm *runtime.RuntimeCompilationTelemetry) (string, error) {
+func (a *constantFetcherRCProvider) GetOutputFilePath(config *ebpf.Config, kernelHash string, flagHash string, tm *runtime.RuntimeCompilationTelemetry) (string, error) {
 	cCodeHash, err := runtime.Sha256hex([]byte(a.cCode))
 	if err != nil {
 		return "", err
 	}
 
-	unameHash, err := runtime.UnameHash(uname)
-	if err != nil {
-		return "", err
-	}
-
-	return filepath.Join(config.RuntimeCompilerOutputDir, fmt.Sprintf("constant_fetcher-%s-%s-%s.o", unameHash, cCodeHash, flagHash)), nil
+	return filepath.Join(config.RuntimeCompilerOutputDir, fmt.Sprintf("constant_fetcher-%s-%s-%s.o", kernelHash, cCodeHash, flagHash)), nil
 }
 
 func sortAndDedup(in []string) []string {
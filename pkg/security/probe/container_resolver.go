@@ -9,14 +9,136 @@
 package probe
 
 import (
+	"time"
+
+	"github.com/DataDog/datadog-go/v5/statsd"
+	lib "github.com/cilium/ebpf"
+	lru "github.com/hashicorp/golang-lru"
+	"go.uber.org/atomic"
+
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+	"github.com/DataDog/datadog-agent/pkg/security/seclog"
 	"github.com/DataDog/datadog-agent/pkg/security/utils"
 )
 
-// ContainerResolver is used to resolve the container context of the events
-type ContainerResolver struct{}
+const (
+	containerCookieCacheSize = 1024
+
+	// unresolvedCookieTTL is the time during which the kernel map isn't queried again for a cookie it
+	// couldn't resolve
+	unresolvedCookieTTL = 30 * time.Second
+)
+
+// ContainerResolver is used to resolve the container context of the events.
+//
+// The events only carry the cookie of their container. The cookies are learned from:
+//   - the container_ids kernel map, which is filled when a process is moved into a container cgroup
+//     (trace__cgroup_write)
+//   - the processes found in /proc during the snapshot
+//   - the proc_cache entries read from the kernel maps, and the cgroup tracing events, which both
+//     carry the full container ID
+type ContainerResolver struct {
+	statsdClient    statsd.ClientInterface
+	containerIDsMap *lib.Map
+	cookies         *lru.Cache
+	// unresolved holds the expiration time of the cookies that the kernel map couldn't resolve
+	unresolved        *lru.Cache
+	unresolvedCookies *atomic.Int64
+}
+
+// NewContainerResolver returns a new container resolver
+func NewContainerResolver(statsdClient statsd.ClientInterface) (*ContainerResolver, error) {
+	cookies, err := lru.New(containerCookieCacheSize)
+	if err != nil {
+		return nil, err
+	}
+
+	unresolved, err := lru.New(containerCookieCacheSize)
+	if err != nil {
+		return nil, err
+	}
+
+	return &ContainerResolver{
+		statsdClient:      statsdClient,
+		cookies:           cookies,
+		unresolved:        unresolved,
+		unresolvedCookies: atomic.NewInt64(0),
+	}, nil
+}
+
+// Start fetches the kernel map holding the container IDs of the cookies
+func (cr *ContainerResolver) Start(probe *Probe) error {
+	containerIDsMap, err := probe.Map("container_ids")
+	if err != nil {
+		return err
+	}
+	cr.containerIDsMap = containerIDsMap
+	return nil
+}
 
 // GetContainerID returns the container id of the given pid
 func (cr *ContainerResolver) GetContainerID(pid uint32) (utils.ContainerID, error) {
 	// Parse /proc/[pid]/task/[pid]/cgroup
 	return utils.GetProcContainerID(pid, pid)
 }
+
+// AddContainerID registers the cookie of a container ID found in user space, so that the events sent by
+// the processes of the container can be resolved without querying the kernel map
+func (cr *ContainerResolver) AddContainerID(id string) {
+	if cookie := model.ContainerCookie(id); cookie != 0 {
+		cr.cookies.Add(cookie, id)
+		cr.unresolved.Remove(cookie)
+	}
+}
+
+// ResolveCookie returns the container ID of a container cookie. The kernel map is only queried the first time
+// a cookie is seen, the returned string is then shared by all the events of the container. A cookie missing
+// from the kernel map isn't looked up again before unresolvedCookieTTL.
+func (cr *ContainerResolver) ResolveCookie(cookie uint64) string {
+	if cookie == 0 {
+		return ""
+	}
+
+	if id, found := cr.cookies.Get(cookie); found {
+		return id.(string)
+	}
+
+	if cr.containerIDsMap == nil {
+		return ""
+	}
+
+	if expiration, found := cr.unresolved.Get(cookie); found && time.Now().Before(expiration.(time.Time)) {
+		cr.unresolvedCookies.Inc()
+		return ""
+	}
+
+	var idRaw [model.ContainerIDLen]byte
+	if err := cr.containerIDsMap.Lookup(cookie, &idRaw); err != nil {
+		cr.markUnresolved(cookie, err)
+		return ""
+	}
+
+	id, err := model.UnmarshalString(idRaw[:], model.ContainerIDLen)
+	if err != nil || id == "" {
+		cr.markUnresolved(cookie, err)
+		return ""
+	}
+	cr.cookies.Add(cookie, id)
+
+	return id
+}
+
+func (cr *ContainerResolver) markUnresolved(cookie uint64, err error) {
+	seclog.Debugf("couldn't resolve container cookie %x: %v", cookie, err)
+	cr.unresolved.Add(cookie, time.Now().Add(unresolvedCookieTTL))
+	cr.unresolvedCookies.Inc()
+}
+
+// SendStats sends the container resolver metrics
+func (cr *ContainerResolver) SendStats() error {
+	if val := cr.unresolvedCookies.Swap(0); val > 0 {
+		return cr.statsdClient.Count(metrics.MetricContainerResolverUnresolvedCookies, val, []string{}, 1.0)
+	}
+	return nil
+}
@@ -33,6 +33,8 @@ const (
 	AbnormalPathRuleID = "abnormal_path"
 	// SelfTestRuleID is the rule ID for the self_test events
 	SelfTestRuleID = "self_test"
+	// EventsSuppressedRuleID is the rule ID for the events_suppressed events
+	EventsSuppressedRuleID = "events_suppressed"
 )
 
 // AllCustomRuleIDs returns the list of custom rule IDs
@@ -43,6 +45,7 @@ func AllCustomRuleIDs() []string {
 		NoisyProcessRuleID,
 		AbnormalPathRuleID,
 		SelfTestRuleID,
+		EventsSuppressedRuleID,
 	}
 }
 
@@ -304,6 +307,35 @@ func NewNoisyProcessEvent(count uint64,
 		})
 }
 
+// SuppressedProcess holds the amount of events of a process suppressed by the in-kernel rate limiter
+// easyjson:json
+type SuppressedProcess struct {
+	Pid        uint32            `json:"pid"`
+	Comm       string            `json:"comm"`
+	Suppressed map[string]uint64 `json:"per_event"`
+}
+
+// EventsSuppressedEvent is used to report the events suppressed by the in-kernel rate limiter since the last report
+// easyjson:json
+type EventsSuppressedEvent struct {
+	Timestamp time.Time            `json:"date"`
+	Rate      int                  `json:"rate"`
+	Burst     int                  `json:"burst"`
+	Processes []*SuppressedProcess `json:"processes"`
+}
+
+// NewEventsSuppressedEvent returns the rule and a populated custom event for a events_suppressed event
+func NewEventsSuppressedEvent(rate int, burst int, processes []*SuppressedProcess) (*rules.Rule, *CustomEvent) {
+	return newRule(&rules.RuleDefinition{
+			ID: EventsSuppressedRuleID,
+		}), newCustomEvent(model.CustomEventsSuppressedEventType, EventsSuppressedEvent{
+			Timestamp: time.Now(),
+			Rate:      rate,
+			Burst:     burst,
+			Processes: processes,
+		})
+}
+
 func resolutionErrorToEventType(err error) model.EventType {
 	switch err.(type) {
 	case ErrTruncatedParents, ErrTruncatedParentsERPC:
@@ -27,6 +27,14 @@ type DiscarderStats struct {
 	EventDiscarded  uint64
 }
 
+// InodeDiscarderBloomStats is used to collect kernel space metrics about the inode discarders bloom filter
+type InodeDiscarderBloomStats struct {
+	Checked        uint64
+	Skipped        uint64
+	FalsePositives uint64
+	Inserts        uint64
+}
+
 // DiscarderMonitor defines a discarder monitor
 type DiscarderMonitor struct {
 	statsdClient      statsd.ClientInterface
@@ -35,6 +43,54 @@ type DiscarderMonitor struct {
 	statsZero         []DiscarderStats
 	activeStatsBuffer uint32
 	numCPU            int
+
+	bloomStats      *lib.Map
+	lastBloomStats  InodeDiscarderBloomStats
+	inodeDiscarders *inodeDiscarders
+}
+
+func (d *DiscarderMonitor) sendBloomStats() error {
+	stats := make([]InodeDiscarderBloomStats, d.numCPU)
+	if err := d.bloomStats.Lookup(ebpf.ZeroUint32MapItem, &stats); err != nil {
+		return err
+	}
+
+	// the kernel counters are never reset, aggregate all cpu stats and compute the delta with the previous collection
+	var total InodeDiscarderBloomStats
+	for _, stat := range stats {
+		total.Checked += stat.Checked
+		total.Skipped += stat.Skipped
+		total.FalsePositives += stat.FalsePositives
+		total.Inserts += stat.Inserts
+	}
+
+	checked := total.Checked - d.lastBloomStats.Checked
+	skipped := total.Skipped - d.lastBloomStats.Skipped
+	falsePositives := total.FalsePositives - d.lastBloomStats.FalsePositives
+	inserts := total.Inserts - d.lastBloomStats.Inserts
+	d.lastBloomStats = total
+
+	rebuilt, err := d.inodeDiscarders.rotateBloomFilter(inserts)
+	if err != nil {
+		return fmt.Errorf("failed to rebuild the inode discarders bloom filter: %w", err)
+	}
+	if rebuilt {
+		_ = d.statsdClient.Count(metrics.MetricInodeDiscarderBloomRebuilt, 1, []string{}, 1.0)
+	}
+
+	if checked == 0 {
+		return nil
+	}
+
+	_ = d.statsdClient.Count(metrics.MetricInodeDiscarderBloomChecked, int64(checked), []string{}, 1.0)
+	_ = d.statsdClient.Count(metrics.MetricInodeDiscarderBloomSkipped, int64(skipped), []string{}, 1.0)
+	_ = d.statsdClient.Count(metrics.MetricInodeDiscarderBloomFalsePositive, int64(falsePositives), []string{}, 1.0)
+
+	if negatives := skipped + falsePositives; negatives > 0 {
+		_ = d.statsdClient.Gauge(metrics.MetricInodeDiscarderBloomFalsePositiveRate, float64(falsePositives)/float64(negatives), []string{}, 1.0)
+	}
+
+	return nil
 }
 
 // SendStats send stats
@@ -81,6 +137,10 @@ func (d *DiscarderMonitor) SendStats() error {
 		_ = buffer.Put(i, d.statsZero)
 	}
 
+	if err := d.sendBloomStats(); err != nil {
+		return fmt.Errorf("failed to send inode discarders bloom filter stats: %w", err)
+	}
+
 	d.activeStatsBuffer = 1 - d.activeStatsBuffer
 	return d.bufferSelector.Put(ebpf.BufferSelectorERPCMonitorKey, d.activeStatsBuffer)
 }
@@ -93,9 +153,10 @@ func NewDiscarderMonitor(p *Probe) (*DiscarderMonitor, error) {
 	}
 
 	d := &DiscarderMonitor{
-		statsdClient: p.statsdClient,
-		statsZero:    make([]DiscarderStats, numCPU),
-		numCPU:       numCPU,
+		statsdClient:    p.statsdClient,
+		statsZero:       make([]DiscarderStats, numCPU),
+		numCPU:          numCPU,
+		inodeDiscarders: p.inodeDiscarders,
 	}
 
 	statsFB, err := p.Map("discarder_stats_fb")
@@ -116,5 +177,11 @@ func NewDiscarderMonitor(p *Probe) (*DiscarderMonitor, error) {
 	}
 	d.bufferSelector = bufferSelector
 
+	bloomStats, err := p.Map("inode_discarders_bloom_stats")
+	if err != nil {
+		return nil, err
+	}
+	d.bloomStats = bloomStats
+
 	return d, nil
 }
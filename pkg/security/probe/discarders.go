@@ -14,7 +14,9 @@ import (
 	"math"
 	"path"
 	"strings"
+	"sync/atomic"
 	"time"
+	"unsafe"
 
 	manager "github.com/DataDog/ebpf-manager"
 	lib "github.com/cilium/ebpf"
@@ -40,6 +42,11 @@ const (
 	// inode/mountid that won't be resubmitted
 	maxRecentlyAddedCacheSize = uint64(64)
 
+	// inodeDiscardersBloomMaxInserts is the number of discarders added to the inode discarders bloom filter after
+	// which it is rebuilt from the live discarders. With 2 bits set per discarder in 1024 words of 64 bits (INODE_DISCARDERS_BLOOM_WORDS), 8
+	// discarders per word keep the false positive rate around 5%.
+	inodeDiscardersBloomMaxInserts = 8 * 1024
+
 	// Map names for discarder stats. Discarder stats includes counts of discarders added and events discarded. Look up "multiple buffering" for more details about why there's two buffers.
 	frontBufferDiscarderStatsMapName = "discarder_stats_fb"
 	backBufferDiscarderStatsMapName  = "discarder_stats_bb"
@@ -187,6 +194,7 @@ func recentlyAddedIndex(mountID uint32, inode uint64) uint64 {
 // inodeDiscarders is used to issue eRPC discarder requests
 type inodeDiscarders struct {
 	*lib.Map
+	bloomFilter    *lib.Map
 	erpc           *ERPC
 	dentryResolver *DentryResolver
 	rs             *rules.RuleSet
@@ -195,11 +203,15 @@ type inodeDiscarders struct {
 	parentDiscarderFncs [maxParentDiscarderDepth]map[eval.Field]func(dirname string) (bool, error)
 
 	recentlyAddedEntries [maxRecentlyAddedCacheSize]inodeDiscarderEntry
+
+	// bloomFilterInserts is the number of discarders added to the bloom filter since it was last cleared
+	bloomFilterInserts uint64
 }
 
-func newInodeDiscarders(inodesMap *lib.Map, erpc *ERPC, dentryResolver *DentryResolver) *inodeDiscarders {
+func newInodeDiscarders(inodesMap *lib.Map, bloomFilterMap *lib.Map, erpc *ERPC, dentryResolver *DentryResolver) *inodeDiscarders {
 	id := &inodeDiscarders{
 		Map:            inodesMap,
+		bloomFilter:    bloomFilterMap,
 		erpc:           erpc,
 		dentryResolver: dentryResolver,
 	}
@@ -254,6 +266,89 @@ func (id *inodeDiscarders) expireInodeDiscarder(req *ERPCRequest, mountID uint32
 	return id.erpc.Request(req)
 }
 
+// inodeDiscarderBloomHash mirrors inode_discarder_hash in kernel space
+func inodeDiscarderBloomHash(mountID uint32, inode uint64) uint64 {
+	h := inode * 0x9E3779B97F4A7C15
+	h ^= uint64(mountID) * 0xC2B2AE3D27D4EB4F
+	h ^= h >> 31
+	h *= 0x94D049BB133111EB
+	h ^= h >> 29
+	return h
+}
+
+// inodeDiscarderBloomBits mirrors inode_discarder_bloom_bits in kernel space
+func inodeDiscarderBloomBits(hash uint64) uint64 {
+	return 1<<((hash>>32)&63) | 1<<((hash>>40)&63)
+}
+
+// buildInodeDiscardersBloomFilter returns the bloom filter words matching the given discarders
+func buildInodeDiscardersBloomFilter(size uint32, discarders []inodeDiscarderMapEntry) []uint64 {
+	words := make([]uint64, size)
+	for _, discarder := range discarders {
+		hash := inodeDiscarderBloomHash(discarder.PathKey.MountID, discarder.PathKey.Inode)
+		words[hash&uint64(size-1)] |= inodeDiscarderBloomBits(hash)
+	}
+	return words
+}
+
+// isMaybeDiscardedByInode mirrors is_maybe_discarded_by_inode in kernel space
+func isMaybeDiscardedByInode(words []uint64, mountID uint32, inode uint64) bool {
+	hash := inodeDiscarderBloomHash(mountID, inode)
+	bits := inodeDiscarderBloomBits(hash)
+	return words[hash&uint64(len(words)-1)]&bits == bits
+}
+
+// writeBloomFilter replaces the kernel space bloom filter words with one batch update, or one update per word on
+// kernels without batch operations
+func (id *inodeDiscarders) writeBloomFilter(words []uint64) error {
+	keys := make([]uint32, len(words))
+	for i := range keys {
+		keys[i] = uint32(i)
+	}
+
+	if _, err := id.bloomFilter.BatchUpdate(keys, words, nil); err == nil {
+		return nil
+	}
+
+	for i, word := range words {
+		if err := id.bloomFilter.Put(keys[i], word); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// clearBloomFilter resets the kernel space bloom filter in front of the inode discarders
+func (id *inodeDiscarders) clearBloomFilter() error {
+	if id.bloomFilter == nil {
+		return nil
+	}
+
+	atomic.StoreUint64(&id.bloomFilterInserts, 0)
+
+	return id.writeBloomFilter(make([]uint64, id.bloomFilter.MaxEntries()))
+}
+
+// rotateBloomFilter accounts for the discarders added to the bloom filter in kernel space and, once too many bits are
+// set, rebuilds it from the live inode discarders so that the bits of evicted discarders are dropped. A discarder added
+// in kernel space during the rebuild is ignored until user space pushes it again.
+func (id *inodeDiscarders) rotateBloomFilter(inserts uint64) (bool, error) {
+	if id.bloomFilter == nil || atomic.AddUint64(&id.bloomFilterInserts, inserts) < inodeDiscardersBloomMaxInserts {
+		return false, nil
+	}
+
+	var discarders []inodeDiscarderMapEntry
+	var discarder inodeDiscarderMapEntry
+	var mapValue [256]byte
+	for entries := id.Iterate(); entries.Next(&discarder, unsafe.Pointer(&mapValue[0])); {
+		discarders = append(discarders, discarder)
+	}
+
+	atomic.StoreUint64(&id.bloomFilterInserts, uint64(len(discarders)))
+
+	return true, id.writeBloomFilter(buildInodeDiscardersBloomFilter(id.bloomFilter.MaxEntries(), discarders))
+}
+
 var (
 	discarderEvent = NewEvent(nil, nil, nil)
 )
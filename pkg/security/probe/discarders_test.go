@@ -37,7 +37,7 @@ func addRuleExpr(t testing.TB, rs *rules.RuleSet, exprs ...string) {
 }
 
 func TestIsParentDiscarder(t *testing.T) {
-	id := newInodeDiscarders(nil, nil, nil)
+	id := newInodeDiscarders(nil, nil, nil, nil)
 
 	enabled := map[eval.EventType]bool{"*": true}
 
@@ -212,7 +212,7 @@ func TestIsParentDiscarder(t *testing.T) {
 }
 
 func TestIsGrandParentDiscarder(t *testing.T) {
-	id := newInodeDiscarders(nil, nil, nil)
+	id := newInodeDiscarders(nil, nil, nil, nil)
 
 	enabled := map[eval.EventType]bool{"*": true}
 
@@ -387,7 +387,7 @@ func TestIsDiscarderOverride(t *testing.T) {
 }
 
 func BenchmarkParentDiscarder(b *testing.B) {
-	id := newInodeDiscarders(nil, nil, nil)
+	id := newInodeDiscarders(nil, nil, nil, nil)
 
 	enabled := map[eval.EventType]bool{"*": true}
 
@@ -462,3 +462,41 @@ func TestIsRecentlyAddedOverflow(t *testing.T) {
 		t.Error("should be marked as added")
 	}
 }
+
+func TestInodeDiscardersBloomFilterRebuild(t *testing.T) {
+	const words = 1024
+
+	// fill the filter with as many discarders as the rotation threshold, the first half was evicted since
+	var all []inodeDiscarderMapEntry
+	for i := uint64(0); i != inodeDiscardersBloomMaxInserts; i++ {
+		all = append(all, inodeDiscarderMapEntry{PathKey: PathKey{MountID: uint32(1 + i%7), Inode: 1000 + i}})
+	}
+	live := all[len(all)/2:]
+
+	full := buildInodeDiscardersBloomFilter(words, all)
+	rebuilt := buildInodeDiscardersBloomFilter(words, live)
+
+	for _, discarder := range live {
+		if !isMaybeDiscardedByInode(rebuilt, discarder.PathKey.MountID, discarder.PathKey.Inode) {
+			t.Fatalf("live discarder %+v should still match after a rotation", discarder.PathKey)
+		}
+	}
+
+	// the rebuilt filter drops the bits of the evicted discarders
+	var fullMatches, rebuiltMatches int
+	for _, discarder := range all[:len(all)/2] {
+		if isMaybeDiscardedByInode(full, discarder.PathKey.MountID, discarder.PathKey.Inode) {
+			fullMatches++
+		}
+		if isMaybeDiscardedByInode(rebuilt, discarder.PathKey.MountID, discarder.PathKey.Inode) {
+			rebuiltMatches++
+		}
+	}
+	if fullMatches != len(all)/2 || rebuiltMatches >= fullMatches {
+		t.Errorf("evicted discarders should match less after a rotation: %d before, %d after", fullMatches, rebuiltMatches)
+	}
+
+	if isMaybeDiscardedByInode(buildInodeDiscardersBloomFilter(words, nil), 1, 1000) {
+		t.Error("an empty filter shouldn't match")
+	}
+}
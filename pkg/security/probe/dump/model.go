@@ -109,13 +109,15 @@ var (
 	DOT StorageFormat = "dot"
 	// Profile is used to request the Secl profile format
 	Profile StorageFormat = "profile"
+	// Stream is used to request the incremental stream format
+	Stream StorageFormat = "stream"
 
 	strToFormats = make(map[string]StorageFormat)
 )
 
 // AllStorageFormats returns the list of supported formats
 func AllStorageFormats() []StorageFormat {
-	return []StorageFormat{JSON, PROTOBUF, DOT, Profile}
+	return []StorageFormat{JSON, PROTOBUF, DOT, Profile, Stream}
 }
 
 // ParseStorageFormat returns a storage format from a string input
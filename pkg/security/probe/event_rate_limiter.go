@@ -0,0 +1,176 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package probe
+
+import (
+	"fmt"
+	"sort"
+
+	"github.com/DataDog/datadog-go/v5/statsd"
+	manager "github.com/DataDog/ebpf-manager"
+	lib "github.com/cilium/ebpf"
+
+	"github.com/DataDog/datadog-agent/pkg/security/config"
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+)
+
+const (
+	// maxSuppressedProcessesPerReport is the maximum number of processes reported in a events_suppressed event
+	maxSuppressedProcessesPerReport = 20
+)
+
+func getEventRateLimiterConstants(config *config.Config) []manager.ConstantEditor {
+	// a rate of 0 disables the limiter in the kernel
+	var rate, burst uint64
+	if config.EventRateLimiterEnabled {
+		rate, burst = uint64(config.EventRateLimiterRate), uint64(config.EventRateLimiterBurst)
+	}
+
+	var eventTypes uint64
+	for _, eventType := range config.EventRateLimiterEventTypes {
+		if eventType > model.UnknownEventType && eventType < model.MaxKernelEventType {
+			eventTypes |= 1 << uint64(eventType)
+		}
+	}
+
+	return []manager.ConstantEditor{
+		{
+			Name:  "event_rate_limiter_rate",
+			Value: rate,
+		},
+		{
+			Name:  "event_rate_limiter_burst",
+			Value: burst,
+		},
+		{
+			Name:  "event_rate_limiter_event_types",
+			Value: eventTypes,
+		},
+	}
+}
+
+// eventRateLimiterKey is the key of the event_rate_limiters kernel map
+type eventRateLimiterKey struct {
+	Pid       uint32
+	EventType uint32
+}
+
+// eventRateLimiterEntry is the value of the event_rate_limiters kernel map
+type eventRateLimiterEntry struct {
+	LastRefill uint64
+	Tokens     uint64
+	Suppressed uint64
+}
+
+// EventRateLimiterMonitor reports the events suppressed by the in-kernel event rate limiter
+type EventRateLimiterMonitor struct {
+	probe        *Probe
+	statsdClient statsd.ClientInterface
+	limiters     *lib.Map
+
+	// lastSuppressed holds the value of the suppressed counter of each bucket at the previous collection, the
+	// kernel never resets them
+	lastSuppressed map[eventRateLimiterKey]uint64
+}
+
+// NewEventRateLimiterMonitor returns a new EventRateLimiterMonitor
+func NewEventRateLimiterMonitor(p *Probe) (*EventRateLimiterMonitor, error) {
+	limiters, err := p.Map("event_rate_limiters")
+	if err != nil {
+		return nil, err
+	}
+
+	return &EventRateLimiterMonitor{
+		probe:          p,
+		statsdClient:   p.statsdClient,
+		limiters:       limiters,
+		lastSuppressed: make(map[eventRateLimiterKey]uint64),
+	}, nil
+}
+
+// SendStats sends the suppressed events metrics and dispatches a summary of the noisiest processes
+func (m *EventRateLimiterMonitor) SendStats() error {
+	var (
+		key            eventRateLimiterKey
+		entry          eventRateLimiterEntry
+		perEventType   = make(map[model.EventType]uint64)
+		perProcess     = make(map[uint32]map[string]uint64)
+		perProcessSum  = make(map[uint32]uint64)
+		lastSuppressed = make(map[eventRateLimiterKey]uint64, len(m.lastSuppressed))
+	)
+
+	iterator := m.limiters.Iterate()
+	for iterator.Next(&key, &entry) {
+		lastSuppressed[key] = entry.Suppressed
+
+		// a bucket evicted from the LRU and created again starts from 0
+		delta := entry.Suppressed
+		if last, ok := m.lastSuppressed[key]; ok && last <= entry.Suppressed {
+			delta = entry.Suppressed - last
+		}
+		if delta == 0 {
+			continue
+		}
+
+		eventType := model.EventType(key.EventType)
+		perEventType[eventType] += delta
+
+		if perProcess[key.Pid] == nil {
+			perProcess[key.Pid] = make(map[string]uint64)
+		}
+		perProcess[key.Pid][eventType.String()] += delta
+		perProcessSum[key.Pid] += delta
+	}
+	if err := iterator.Err(); err != nil {
+		return fmt.Errorf("failed to iterate over the event rate limiters: %w", err)
+	}
+
+	// forget the buckets that were evicted from the kernel map
+	m.lastSuppressed = lastSuppressed
+
+	if len(perProcess) == 0 {
+		return nil
+	}
+
+	for eventType, count := range perEventType {
+		tags := []string{fmt.Sprintf("event_type:%s", eventType)}
+		_ = m.statsdClient.Count(metrics.MetricEventRateLimiterSuppressed, int64(count), tags, 1.0)
+	}
+	_ = m.statsdClient.Gauge(metrics.MetricEventRateLimiterProcesses, float64(len(perProcess)), []string{}, 1.0)
+
+	pids := make([]uint32, 0, len(perProcess))
+	for pid := range perProcess {
+		pids = append(pids, pid)
+	}
+	sort.Slice(pids, func(i, j int) bool {
+		return perProcessSum[pids[i]] > perProcessSum[pids[j]]
+	})
+	if len(pids) > maxSuppressedProcessesPerReport {
+		pids = pids[:maxSuppressedProcessesPerReport]
+	}
+
+	processes := make([]*SuppressedProcess, 0, len(pids))
+	for _, pid := range pids {
+		process := &SuppressedProcess{
+			Pid:        pid,
+			Suppressed: perProcess[pid],
+		}
+		if entry := m.probe.resolvers.ProcessResolver.Resolve(pid, pid); entry != nil {
+			process.Comm = entry.Comm
+		}
+		processes = append(processes, process)
+	}
+
+	m.probe.DispatchCustomEvent(
+		NewEventsSuppressedEvent(m.probe.config.EventRateLimiterRate, m.probe.config.EventRateLimiterBurst, processes),
+	)
+
+	return nil
+}
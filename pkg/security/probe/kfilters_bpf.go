@@ -121,3 +121,63 @@ func (e *mapEventMask) Apply(probe *Probe) error {
 	}
 	return table.Put(e.tableKey, eventMask)
 }
+
+// mapParentNameMask is an entry of the parent name approvers table. The event mask is stored either in the pass-through
+// mask or in the last mask, so that both kinds of entries can be removed independently.
+type mapParentNameMask struct {
+	tableName string
+	tableKey  parentNameMapItem
+	isLast    bool
+	eventMask uint64
+}
+
+type parentNameMaskKey struct {
+	key    parentNameMapItem
+	isLast bool
+}
+
+type parentNameFilter struct {
+	EventMask uint64
+	LastMask  uint64
+}
+
+func (e *mapParentNameMask) mask(filter *parentNameFilter) *uint64 {
+	if e.isLast {
+		return &filter.LastMask
+	}
+	return &filter.EventMask
+}
+
+func (e *mapParentNameMask) Key() interface{} {
+	return mapHash{
+		tableName: e.tableName,
+		key:       parentNameMaskKey{key: e.tableKey, isLast: e.isLast},
+	}
+}
+
+func (e *mapParentNameMask) Remove(probe *Probe) error {
+	table, err := probe.Map(e.tableName)
+	if err != nil {
+		return err
+	}
+	var filter parentNameFilter
+	if err := table.Lookup(e.tableKey, &filter); err != nil {
+		return err
+	}
+	*e.mask(&filter) &^= e.eventMask
+	if filter.EventMask == 0 && filter.LastMask == 0 {
+		return table.Delete(e.tableKey)
+	}
+	return table.Put(e.tableKey, filter)
+}
+
+func (e *mapParentNameMask) Apply(probe *Probe) error {
+	table, err := probe.Map(e.tableName)
+	if err != nil {
+		return err
+	}
+	var filter parentNameFilter
+	_ = table.Lookup(e.tableKey, &filter)
+	*e.mask(&filter) |= e.eventMask
+	return table.Put(e.tableKey, filter)
+}
@@ -193,6 +193,9 @@ func (ev *Event) ResolveMountRoot(e *model.MountEvent) string {
 
 // ResolveContainerID resolves the container ID of the event
 func (ev *Event) ResolveContainerID(e *model.ContainerContext) string {
+	if len(e.ID) == 0 {
+		e.ID = ev.resolvers.ContainerResolver.ResolveCookie(e.Cookie)
+	}
 	if len(e.ID) == 0 {
 		if entry := ev.ResolveProcessCacheEntry(); entry != nil {
 			e.ID = entry.ContainerID
@@ -218,7 +221,7 @@ func (ev *Event) UnmarshalProcessCacheEntry(data []byte) (int, error) {
 	if err != nil {
 		return n, err
 	}
-	entry.Process.ContainerID = ev.ContainerContext.ID
+	entry.Process.ContainerID = ev.resolvers.ContainerResolver.ResolveCookie(ev.ContainerContext.Cookie)
 
 	return n, nil
 }
@@ -18,9 +18,9 @@ import (
 
 var openCapabilities = Capabilities{
 	"open.file.path": {
-		PolicyFlags:     PolicyFlagBasename,
+		PolicyFlags:     PolicyFlagBasename | PolicyFlagParentName,
 		FieldValueTypes: eval.ScalarValueType | eval.PatternValueType | eval.GlobValueType,
-		ValidateFnc:     validateBasenameFilter,
+		ValidateFnc:     validatePathFilter,
 		FilterWeight:    15,
 	},
 	"open.file.name": {
@@ -48,9 +48,15 @@ func openOnNewApprovers(probe *Probe, approvers rules.Approvers) (activeApprover
 		return nil, err
 	}
 
+	parentNameApprovers, err := onNewParentNameApprovers(probe, model.FileOpenEventType, "file", approvers)
+	if err != nil {
+		return nil, err
+	}
+	openApprovers = append(openApprovers, parentNameApprovers...)
+
 	for field, values := range approvers {
 		switch field {
-		case "open.file.name", "open.file.path": // already handled by onNewBasenameApprovers
+		case "open.file.name", "open.file.path": // already handled by onNewBasenameApprovers and onNewParentNameApprovers
 		case "open.flags":
 			activeApprover, err := approveFlags("open_flags_approvers", intValues(values)...)
 			if err != nil {
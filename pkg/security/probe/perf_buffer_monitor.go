@@ -49,6 +49,65 @@ func (s *PerfMapStats) UnmarshalBinary(data []byte) error {
 	return nil
 }
 
+const (
+	// eventStatsHistogramBuckets is the number of buckets of the kernel output latency and size histograms
+	eventStatsHistogramBuckets = 16
+	// eventStatsLatencyShift is the log2 of the upper bound of the first output latency bucket, in nanoseconds
+	eventStatsLatencyShift = 8
+	// eventStatsSizeShift is the log2 of the upper bound of the first event size bucket, in bytes
+	eventStatsSizeShift = 5
+)
+
+// PerfMapHistograms contains the output latency and event size histograms collected for one event in a perf buffer
+// statistics map
+type PerfMapHistograms struct {
+	OutputLatency [eventStatsHistogramBuckets]uint64
+	Size        [eventStatsHistogramBuckets]uint64
+}
+
+// histogramBucketTags returns the "le" tags of the buckets of a histogram whose first bucket upper bound is 1 << shift
+func histogramBucketTags(shift uint) [eventStatsHistogramBuckets]string {
+	var tags [eventStatsHistogramBuckets]string
+	for i := 0; i < eventStatsHistogramBuckets-1; i++ {
+		tags[i] = fmt.Sprintf("le:%d", uint64(1)<<(shift+uint(i)))
+	}
+	tags[eventStatsHistogramBuckets-1] = "le:inf"
+	return tags
+}
+
+var (
+	outputLatencyBucketTags = histogramBucketTags(eventStatsLatencyShift)
+	eventSizeBucketTags   = histogramBucketTags(eventStatsSizeShift)
+)
+
+// kernelPerfMapStats is the per-CPU value of a perf buffer statistics map
+type kernelPerfMapStats struct {
+	PerfMapStats
+	PerfMapHistograms
+}
+
+// UnmarshalBinary parses a map entry and populates the current kernelPerfMapStats instance
+func (s *kernelPerfMapStats) UnmarshalBinary(data []byte) error {
+	if err := s.PerfMapStats.UnmarshalBinary(data); err != nil {
+		return err
+	}
+
+	if len(data) < 24+2*8*eventStatsHistogramBuckets {
+		return model.ErrNotEnoughData
+	}
+
+	offset := 24
+	for i := range s.OutputLatency {
+		s.OutputLatency[i] = model.ByteOrder.Uint64(data[offset : offset+8])
+		offset += 8
+	}
+	for i := range s.Size {
+		s.Size[i] = model.ByteOrder.Uint64(data[offset : offset+8])
+		offset += 8
+	}
+	return nil
+}
+
 // PerfBufferMonitor holds statistics about the number of lost and received events
 //nolint:structcheck,unused
 type PerfBufferMonitor struct {
@@ -70,6 +129,8 @@ type PerfBufferMonitor struct {
 	stats map[string][][model.MaxKernelEventType]PerfMapStats
 	// kernelStats holds the aggregated kernel space metrics
 	kernelStats map[string][][model.MaxKernelEventType]PerfMapStats
+	// kernelHistograms holds the last collected kernel space histograms, summed over all the CPUs
+	kernelHistograms map[string]*[model.MaxKernelEventType]PerfMapHistograms
 	// readLostEvents is the count of lost events, collected by reading the perf buffer.  Note that the
 	// slices of Uint64 are properly aligned for atomic access, and are not moved after creation (they
 	// are indexed by cpuid)
@@ -95,6 +156,7 @@ func NewPerfBufferMonitor(p *Probe) (*PerfBufferMonitor, error) {
 
 		stats:             make(map[string][][model.MaxKernelEventType]PerfMapStats),
 		kernelStats:       make(map[string][][model.MaxKernelEventType]PerfMapStats),
+		kernelHistograms:  make(map[string]*[model.MaxKernelEventType]PerfMapHistograms),
 		readLostEvents:    make(map[string][]*atomic.Uint64),
 		sortingErrorStats: make(map[string][model.MaxKernelEventType]*atomic.Int64),
 
@@ -157,6 +219,7 @@ func NewPerfBufferMonitor(p *Probe) (*PerfBufferMonitor, error) {
 
 		pbm.stats[mapName] = stats
 		pbm.kernelStats[mapName] = kernelStats
+		pbm.kernelHistograms[mapName] = &[model.MaxKernelEventType]PerfMapHistograms{}
 		pbm.readLostEvents[mapName] = usrLostEvents
 		pbm.sortingErrorStats[mapName] = sortingErrorStats
 
@@ -445,9 +508,9 @@ func (pbm *PerfBufferMonitor) collectAndSendKernelStats(client statsd.ClientInte
 		tmpCount uint64
 	)
 
-	cpuStats := make([]PerfMapStats, pbm.numCPU)
+	cpuStats := make([]kernelPerfMapStats, pbm.numCPU)
 	for i := 0; i < pbm.numCPU; i++ {
-		cpuStats[i] = NewPerfMapStats()
+		cpuStats[i].PerfMapStats = NewPerfMapStats()
 	}
 
 	tags := []string{pbm.probe.config.StatsTagsCardinality, "", ""}
@@ -471,8 +534,13 @@ func (pbm *PerfBufferMonitor) collectAndSendKernelStats(client statsd.ClientInte
 			evtType := model.EventType(id % uint32(model.MaxKernelEventType))
 			tags[2] = fmt.Sprintf("event_type:%s", evtType)
 
+			var histograms PerfMapHistograms
+
 			// loop over each cpu entry
-			for cpu, stats := range cpuStats {
+			for cpu, cpuStat := range cpuStats {
+				stats := cpuStat.PerfMapStats
+				histograms.add(&cpuStat.PerfMapHistograms)
+
 				// sanity checks:
 				//   - check if the computed cpu id is below the current cpu count
 				//   - check if we collect some data on the provided perf map
@@ -510,6 +578,10 @@ func (pbm *PerfBufferMonitor) collectAndSendKernelStats(client statsd.ClientInte
 				total += stats.Lost.Load()
 				perEvent[evtType.String()] += stats.Lost.Load()
 			}
+
+			if err := pbm.collectAndSendKernelHistograms(client, perfMapName, evtType, &histograms, tags); err != nil {
+				return err
+			}
 		}
 		if err := iterator.Err(); err != nil {
 			return fmt.Errorf("failed to dump the statistics buffer of map %s: %w", perfMapName, err)
@@ -552,6 +624,53 @@ func (pbm *PerfBufferMonitor) sendKernelStats(client statsd.ClientInterface, sta
 	return nil
 }
 
+// add sums the provided histograms into the current one
+func (h *PerfMapHistograms) add(other *PerfMapHistograms) {
+	for i := range h.OutputLatency {
+		h.OutputLatency[i] += other.OutputLatency[i]
+	}
+	for i := range h.Size {
+		h.Size[i] += other.Size[i]
+	}
+}
+
+// collectAndSendKernelHistograms sends the delta between the provided histograms, summed over all the CPUs, and the
+// previously collected ones
+func (pbm *PerfBufferMonitor) collectAndSendKernelHistograms(client statsd.ClientInterface, perfMapName string, evtType model.EventType, histograms *PerfMapHistograms, tags []string) error {
+	previousHistograms := pbm.kernelHistograms[perfMapName]
+	if previousHistograms == nil {
+		return nil
+	}
+	previous := &previousHistograms[evtType]
+	bucketTags := append(tags, "")
+
+	for i, count := range histograms.OutputLatency {
+		delta := count - previous.OutputLatency[i]
+		previous.OutputLatency[i] = count
+		if client == nil || count < delta || delta == 0 {
+			continue
+		}
+		bucketTags[len(tags)] = outputLatencyBucketTags[i]
+		if err := client.Count(metrics.MetricPerfBufferOutputLatency, int64(delta), bucketTags, 1.0); err != nil {
+			return err
+		}
+	}
+
+	for i, count := range histograms.Size {
+		delta := count - previous.Size[i]
+		previous.Size[i] = count
+		if client == nil || count < delta || delta == 0 {
+			continue
+		}
+		bucketTags[len(tags)] = eventSizeBucketTags[i]
+		if err := client.Count(metrics.MetricPerfBufferEventSize, int64(delta), bucketTags, 1.0); err != nil {
+			return err
+		}
+	}
+
+	return nil
+}
+
 // SendStats send event stats using the provided statsd client
 func (pbm *PerfBufferMonitor) SendStats() error {
 	if err := pbm.collectAndSendKernelStats(pbm.probe.statsdClient); err != nil {
@@ -0,0 +1,115 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package probe
+
+import (
+	"runtime"
+	"testing"
+
+	"github.com/DataDog/datadog-go/v5/statsd"
+	lib "github.com/cilium/ebpf"
+	"github.com/cilium/ebpf/rlimit"
+	"github.com/stretchr/testify/assert"
+
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+)
+
+const kernelPerfMapStatsSize = 24 + 2*8*eventStatsHistogramBuckets
+
+// histogramStatsdClient records the histogram buckets sent to statsd
+type histogramStatsdClient struct {
+	statsd.NoOpClient
+	counts map[string]int64
+}
+
+func (c *histogramStatsdClient) Count(name string, value int64, tags []string, rate float64) error {
+	c.counts[name+":"+tags[len(tags)-1]] += value
+	return nil
+}
+
+func newKernelPerfMapStats(count uint64, latencyBucket int, latencyCount uint64, sizeBucket int, sizeCount uint64) []byte {
+	data := make([]byte, kernelPerfMapStatsSize)
+	model.ByteOrder.PutUint64(data[8:16], count)
+	model.ByteOrder.PutUint64(data[24+8*latencyBucket:], latencyCount)
+	model.ByteOrder.PutUint64(data[24+8*eventStatsHistogramBuckets+8*sizeBucket:], sizeCount)
+	return data
+}
+
+func TestPerfBufferMonitorKernelHistograms(t *testing.T) {
+	if err := rlimit.RemoveMemlock(); err != nil {
+		t.Skipf("couldn't remove the memlock limit: %v", err)
+	}
+
+	statsMap, err := lib.NewMap(&lib.MapSpec{
+		Type:       lib.PerCPUArray,
+		KeySize:    4,
+		ValueSize:  kernelPerfMapStatsSize,
+		MaxEntries: uint32(model.MaxKernelEventType),
+	})
+	if err != nil {
+		t.Skipf("couldn't create the statistics map: %v", err)
+	}
+	defer statsMap.Close()
+
+	numCPU := 2
+	if runtime.NumCPU() < numCPU {
+		numCPU = runtime.NumCPU()
+	}
+
+	pbm := &PerfBufferMonitor{
+		kernelHistograms: map[string]*[model.MaxKernelEventType]PerfMapHistograms{
+			"events": {},
+		},
+	}
+	client := &histogramStatsdClient{counts: make(map[string]int64)}
+
+	collect := func(perCPU [][]byte) {
+		key := uint32(model.FileOpenEventType)
+		if err := statsMap.Put(key, perCPU); err != nil {
+			t.Fatal(err)
+		}
+
+		var cpuStats []kernelPerfMapStats
+		if err := statsMap.Lookup(key, &cpuStats); err != nil {
+			t.Fatal(err)
+		}
+
+		var histograms PerfMapHistograms
+		for _, cpuStat := range cpuStats {
+			histograms.add(&cpuStat.PerfMapHistograms)
+		}
+
+		if err := pbm.collectAndSendKernelHistograms(client, "events", model.FileOpenEventType, &histograms, []string{"map:events"}); err != nil {
+			t.Fatal(err)
+		}
+	}
+
+	latencyKey := metrics.MetricPerfBufferOutputLatency + ":" + outputLatencyBucketTags[2]
+	sizeKey := metrics.MetricPerfBufferEventSize + ":" + eventSizeBucketTags[3]
+
+	perCPU := make([][]byte, numCPU)
+	for cpu := range perCPU {
+		perCPU[cpu] = newKernelPerfMapStats(5, 2, 5, 3, 5)
+	}
+	collect(perCPU)
+
+	// the buckets are summed over all the CPUs
+	assert.EqualValues(t, 5*numCPU, client.counts[latencyKey])
+	assert.EqualValues(t, 5*numCPU, client.counts[sizeKey])
+	assert.Len(t, client.counts, 2)
+
+	// only the delta since the previous collection is sent
+	perCPU[0] = newKernelPerfMapStats(8, 2, 8, 3, 5)
+	collect(perCPU)
+
+	assert.EqualValues(t, 5*numCPU+3, client.counts[latencyKey])
+	assert.EqualValues(t, 5*numCPU, client.counts[sizeKey])
+	assert.Len(t, client.counts, 2)
+}
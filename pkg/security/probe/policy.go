@@ -28,12 +28,18 @@ const (
 
 // Policy flags
 const (
-	PolicyFlagBasename PolicyFlag = 1
-	PolicyFlagFlags    PolicyFlag = 2
-	PolicyFlagMode     PolicyFlag = 4
+	PolicyFlagBasename   PolicyFlag = 1
+	PolicyFlagFlags      PolicyFlag = 2
+	PolicyFlagMode       PolicyFlag = 4
+	PolicyFlagParentName PolicyFlag = 8
 
 	// need to be aligned with the kernel size
 	BasenameFilterSize = 256
+
+	// ParentNameFilterSize needs to be aligned with the kernel PARENT_NAME_FILTER_SIZE
+	ParentNameFilterSize = 64
+	// ParentNameApproverMaxDepth needs to be aligned with the kernel PARENT_NAME_APPROVER_MAX_DEPTH
+	ParentNameApproverMaxDepth = 4
 )
 
 func (m PolicyMode) String() string {
@@ -70,5 +76,8 @@ func (f PolicyFlag) MarshalJSON() ([]byte, error) {
 	if f&PolicyFlagMode != 0 {
 		flags = append(flags, `"mode"`)
 	}
+	if f&PolicyFlagParentName != 0 {
+		flags = append(flags, `"parent_name"`)
+	}
 	return []byte("[" + strings.Join(flags, ",") + "]"), nil
 }
@@ -295,7 +295,12 @@ func (p *Probe) Init() error {
 		return err
 	}
 
-	p.inodeDiscarders = newInodeDiscarders(inodeDiscardersMap, p.erpc, p.resolvers.DentryResolver)
+	inodeDiscardersBloomMap, err := p.Map("inode_discarders_bloom")
+	if err != nil {
+		return err
+	}
+
+	p.inodeDiscarders = newInodeDiscarders(inodeDiscardersMap, inodeDiscardersBloomMap, p.erpc, p.resolvers.DentryResolver)
 
 	if err := p.resolvers.Start(p.ctx); err != nil {
 		return err
@@ -490,6 +495,7 @@ func (p *Probe) handleEvent(CPU int, data []byte) {
 			return
 		}
 
+		p.resolvers.ContainerResolver.AddContainerID(event.CgroupTracing.ContainerContext.ID)
 		p.monitor.activityDumpManager.HandleCgroupTracingEvent(&event.CgroupTracing)
 		return
 	}
@@ -1154,6 +1160,12 @@ func (p *Probe) FlushDiscarders() error {
 	// Sleeping a bit to avoid races with executing kprobes and setting discarders
 	time.Sleep(time.Second)
 
+	// all the current discarders are about to expire, reset the bloom filter so that the next discarders don't
+	// inherit their bits. Missing bits only disable the discarders until they are pushed again.
+	if err := p.inodeDiscarders.clearBloomFilter(); err != nil {
+		seclog.Errorf("Failed to clear the inode discarders bloom filter: %s", err)
+	}
+
 	var discardedInodes []inodeDiscarderMapEntry
 	var mapValue [256]byte
 
@@ -1520,6 +1532,7 @@ func NewProbe(config *config.Config, statsdClient statsd.ClientInterface) (*Prob
 
 	p.managerOptions.ConstantEditors = append(p.managerOptions.ConstantEditors, DiscarderConstants...)
 	p.managerOptions.ConstantEditors = append(p.managerOptions.ConstantEditors, getCGroupWriteConstants())
+	p.managerOptions.ConstantEditors = append(p.managerOptions.ConstantEditors, getEventRateLimiterConstants(config)...)
 
 	// if we are using tracepoints to probe syscall exits, i.e. if we are using an old kernel version (< 4.12)
 	// we need to use raw_syscall tracepoints for exits, as syscall are not trace when running an ia32 userspace
@@ -32,6 +32,9 @@ type Monitor struct {
 	activityDumpManager *ActivityDumpManager
 	runtimeMonitor      *RuntimeMonitor
 	discarderMonitor    *DiscarderMonitor
+	syscallCacheMonitor *SyscallCacheMonitor
+
+	eventRateLimiterMonitor *EventRateLimiterMonitor
 }
 
 // NewMonitor returns a new instance of a ProbeMonitor
@@ -69,6 +72,18 @@ func NewMonitor(p *Probe) (*Monitor, error) {
 		return nil, fmt.Errorf("couldn't create the discarder monitor: %w", err)
 	}
 
+	m.syscallCacheMonitor, err = NewSyscallCacheMonitor(p)
+	if err != nil {
+		return nil, fmt.Errorf("couldn't create the syscall cache monitor: %w", err)
+	}
+
+	if p.config.EventRateLimiterEnabled {
+		m.eventRateLimiterMonitor, err = NewEventRateLimiterMonitor(p)
+		if err != nil {
+			return nil, fmt.Errorf("couldn't create the event rate limiter monitor: %w", err)
+		}
+	}
+
 	return m, nil
 }
 
@@ -116,6 +131,9 @@ func (m *Monitor) SendStats() error {
 		if err := resolvers.NamespaceResolver.SendStats(); err != nil {
 			return fmt.Errorf("failed to send namespace_resolver stats: %w", err)
 		}
+		if err := resolvers.ContainerResolver.SendStats(); err != nil {
+			return fmt.Errorf("failed to send container_resolver stats: %w", err)
+		}
 	}
 
 	if err := m.perfBufferMonitor.SendStats(); err != nil {
@@ -143,6 +161,16 @@ func (m *Monitor) SendStats() error {
 		return fmt.Errorf("failed to send discarder stats: %w", err)
 	}
 
+	if err := m.syscallCacheMonitor.SendStats(); err != nil {
+		return fmt.Errorf("failed to send syscall cache stats: %w", err)
+	}
+
+	if m.eventRateLimiterMonitor != nil {
+		if err := m.eventRateLimiterMonitor.SendStats(); err != nil {
+			return fmt.Errorf("failed to send event rate limiter stats: %w", err)
+		}
+	}
+
 	return nil
 }
 
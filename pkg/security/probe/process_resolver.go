@@ -51,6 +51,9 @@ const (
 	procResolveMaxDepth = 16
 	maxArgsEnvResidents = 1024
 	maxParallelArgsEnvs = 512 // == number of parallel starting processes
+
+	// pidCacheExitTimestampOffset is the offset of exit_timestamp in struct pid_cache_t
+	pidCacheExitTimestampOffset = 16
 )
 
 func getAttr2(probe *Probe) uint64 {
@@ -120,6 +123,23 @@ type ProcessResolver struct {
 	processCacheEntryPool *ProcessCacheEntryPool
 
 	exitedQueue []uint32
+
+	// exitedKernelEntries holds the entries deleted from the user space cache since the last cache flush,
+	// kernelEntriesToRelease the ones deleted before it. Their pid_cache entries are released one cache flush later.
+	exitedKernelEntries    []exitedKernelEntry
+	kernelEntriesToRelease []exitedKernelEntry
+	// exitedCookieRefs counts the exited entries not released yet per cookie, the proc_cache entry of a cookie is
+	// released with its last pid_cache entry
+	exitedCookieRefs         map[uint32]int
+	lookupAndDeleteDisabled  bool
+	releasedKernelEntries    *atomic.Int64
+	releasedProcCacheEntries *atomic.Int64
+}
+
+// exitedKernelEntry is a kernel pid_cache entry waiting to be released
+type exitedKernelEntry struct {
+	pid    uint32
+	cookie uint32
 }
 
 // ArgsEnvsPool defines a pool for args/envs allocations
@@ -311,6 +331,18 @@ func (p *ProcessResolver) SendStats() error {
 		}
 	}
 
+	if count := p.releasedKernelEntries.Swap(0); count > 0 {
+		if err := p.probe.statsdClient.Count(metrics.MetricProcessResolverKernelReleased, count, []string{"map:pid_cache"}, 1.0); err != nil {
+			return fmt.Errorf("failed to send process_resolver released kernel entries metric: %w", err)
+		}
+	}
+
+	if count := p.releasedProcCacheEntries.Swap(0); count > 0 {
+		if err := p.probe.statsdClient.Count(metrics.MetricProcessResolverKernelReleased, count, []string{"map:proc_cache"}, 1.0); err != nil {
+			return fmt.Errorf("failed to send process_resolver released kernel entries metric: %w", err)
+		}
+	}
+
 	if count := p.pathErrStats.Swap(0); count > 0 {
 		if err := p.probe.statsdClient.Count(metrics.MetricProcessResolverPathError, count, []string{}, 1.0); err != nil {
 			return fmt.Errorf("failed to send process_resolver path error metric: %w", err)
@@ -577,6 +609,95 @@ func (p *ProcessResolver) deleteEntry(pid uint32, exitTime time.Time) {
 
 	delete(p.entryCache, entry.Pid)
 	entry.Release()
+
+	p.exitedKernelEntries = append(p.exitedKernelEntries, exitedKernelEntry{pid: pid, cookie: entry.Cookie})
+	if entry.Cookie != 0 {
+		p.exitedCookieRefs[entry.Cookie]++
+	}
+}
+
+// releaseKernelEntries deletes the pid_cache entries of the provided exited processes. The kernel never deletes them
+// so that late events can still be resolved from the kernel maps, which lets them evict the entries of live processes
+// on hosts with a high process churn, and forces /proc fallbacks. An entry is kept if the pid is alive again, or if it
+// was reused by a process that didn't exit yet. The proc_cache entry of a cookie is deleted along with the last exited
+// entry referencing it, unless a live process still uses it.
+func (p *ProcessResolver) releaseKernelEntries(entries []exitedKernelEntry, alivePids map[uint32]bool) {
+	pidb := make([]byte, 4)
+	for _, entry := range entries {
+		if alivePids[entry.pid] {
+			continue
+		}
+
+		model.ByteOrder.PutUint32(pidb, entry.pid)
+		if p.releasePidCacheEntry(pidb) {
+			p.releasedKernelEntries.Inc()
+		}
+	}
+
+	p.Lock()
+	var releasedCookies []uint32
+	for _, entry := range entries {
+		if entry.cookie == 0 {
+			continue
+		}
+		if p.exitedCookieRefs[entry.cookie]--; p.exitedCookieRefs[entry.cookie] <= 0 {
+			delete(p.exitedCookieRefs, entry.cookie)
+			releasedCookies = append(releasedCookies, entry.cookie)
+		}
+	}
+	if len(releasedCookies) > 0 {
+		liveCookies := make(map[uint32]bool, len(p.entryCache))
+		for _, entry := range p.entryCache {
+			liveCookies[entry.Cookie] = true
+		}
+		for _, cookie := range releasedCookies {
+			if !liveCookies[cookie] {
+				if err := p.procCacheMap.Delete(cookie); err == nil {
+					p.releasedProcCacheEntries.Inc()
+				}
+			}
+		}
+	}
+	p.Unlock()
+}
+
+// isExitedPidCacheEntry returns true if the provided pid_cache entry belongs to an exited process
+func isExitedPidCacheEntry(pidCache []byte) bool {
+	return len(pidCache) >= pidCacheExitTimestampOffset+8 && model.ByteOrder.Uint64(pidCache[pidCacheExitTimestampOffset:]) != 0
+}
+
+// releasePidCacheEntry deletes the pid_cache entry of a pid if it still belongs to an exited process. The kernel may
+// reuse the pid at any time: the entry is atomically looked up and deleted, and restored if it turns out to belong to a
+// new process. Kernels that can't lookup and delete hash map entries (< 5.14) re-check the entry right before the
+// delete instead, which narrows the race without closing it.
+func (p *ProcessResolver) releasePidCacheEntry(pidb []byte) bool {
+	pidCache, err := p.pidCacheMap.LookupBytes(pidb)
+	if err != nil || !isExitedPidCacheEntry(pidCache) {
+		return false
+	}
+
+	if !p.lookupAndDeleteDisabled {
+		deleted := make([]byte, len(pidCache))
+		err = p.pidCacheMap.LookupAndDelete(pidb, deleted)
+		if err == nil {
+			if isExitedPidCacheEntry(deleted) {
+				return true
+			}
+			// the pid was reused in the meantime, put back the entry of the new process unless the kernel already did
+			_ = p.pidCacheMap.Update(pidb, deleted, lib.UpdateNoExist)
+			return false
+		}
+		if errors.Is(err, lib.ErrKeyNotExist) {
+			return false
+		}
+		seclog.Debugf("lookup and delete unsupported on pid_cache, falling back to lookup then delete: %v", err)
+		p.lookupAndDeleteDisabled = true
+	}
+
+	if pidCache, err = p.pidCacheMap.LookupBytes(pidb); err != nil || !isExitedPidCacheEntry(pidCache) {
+		return false
+	}
+	return p.pidCacheMap.Delete(pidb) == nil
 }
 
 // DeleteEntry tries to delete an entry in the process cache
@@ -754,11 +875,12 @@ func (p *ProcessResolver) resolveFromKernelMaps(pid, tid uint32) *model.ProcessC
 	entry := p.NewProcessCacheEntry(model.PIDContext{Pid: pid, Tid: tid})
 
 	var cc model.ContainerContext
-	read, err := cc.UnmarshalBinary(procCache)
+	read, err := cc.UnmarshalContainerEntryBinary(procCache)
 	if err != nil {
 		return nil
 	}
 	entry.ContainerID = cc.ID
+	p.resolvers.ContainerResolver.AddContainerID(cc.ID)
 
 	if _, err := entry.UnmarshalProcEntryBinary(procCache[read:]); err != nil {
 		return nil
@@ -1095,12 +1217,25 @@ func (p *ProcessResolver) cacheFlush(ctx context.Context) {
 				}
 			}
 			p.Unlock()
+
+			p.flushKernelEntries(procPidsMap)
 		case <-ctx.Done():
 			return
 		}
 	}
 }
 
+// flushKernelEntries releases the kernel entries of the processes deleted before the previous cache flush, and queues
+// the ones deleted since then for the next flush
+func (p *ProcessResolver) flushKernelEntries(alivePids map[uint32]bool) {
+	p.Lock()
+	toRelease := p.kernelEntriesToRelease
+	p.kernelEntriesToRelease, p.exitedKernelEntries = p.exitedKernelEntries, nil
+	p.Unlock()
+
+	p.releaseKernelEntries(toRelease, alivePids)
+}
+
 // SyncCache snapshots /proc for the provided pid. This method returns true if it updated the process cache.
 func (p *ProcessResolver) SyncCache(proc *process.Process) bool {
 	// Only a R lock is necessary to check if the entry exists, but if it exists, we'll update it, so a RW lock is
@@ -1151,11 +1286,12 @@ func (p *ProcessResolver) syncCache(proc *process.Process, filledProc *process.F
 	p.insertEntry(entry, p.entryCache[pid])
 
 	// insert new entry in kernel maps
-	procCacheEntryB := make([]byte, 224)
+	procCacheEntryB := make([]byte, 232)
 	_, err := entry.Process.MarshalProcCache(procCacheEntryB)
 	if err != nil {
 		seclog.Errorf("couldn't marshal proc_cache entry: %s", err)
 	} else {
+		p.resolvers.ContainerResolver.AddContainerID(entry.ContainerID)
 		if err = p.procCacheMap.Put(entry.Cookie, procCacheEntryB); err != nil {
 			seclog.Errorf("couldn't push proc_cache entry to kernel space: %s", err)
 		}
@@ -1302,6 +1438,10 @@ func NewProcessResolver(probe *Probe, resolvers *Resolvers, opts ProcessResolver
 		argsSize:       atomic.NewInt64(0),
 		envsTruncated:  atomic.NewInt64(0),
 		envsSize:       atomic.NewInt64(0),
+
+		exitedCookieRefs:         make(map[uint32]int),
+		releasedKernelEntries:    atomic.NewInt64(0),
+		releasedProcCacheEntries: atomic.NewInt64(0),
 	}
 	for _, t := range metrics.AllTypesTags {
 		p.hitsStats[t] = atomic.NewInt64(0)
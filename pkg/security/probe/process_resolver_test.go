@@ -14,6 +14,8 @@ import (
 	"time"
 
 	"github.com/avast/retry-go"
+	lib "github.com/cilium/ebpf"
+	"github.com/cilium/ebpf/rlimit"
 	"github.com/stretchr/testify/assert"
 
 	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
@@ -459,3 +461,84 @@ func TestForkForkExec(t *testing.T) {
 
 	testCacheSize(t, resolver)
 }
+
+func TestReleaseKernelEntries(t *testing.T) {
+	if err := rlimit.RemoveMemlock(); err != nil {
+		t.Skipf("couldn't remove the memlock limit: %v", err)
+	}
+
+	newMap := func(valueSize uint32) *lib.Map {
+		m, err := lib.NewMap(&lib.MapSpec{
+			Type:       lib.Hash,
+			KeySize:    4,
+			ValueSize:  valueSize,
+			MaxEntries: 16,
+		})
+		if err != nil {
+			t.Skipf("couldn't create the kernel maps: %v", err)
+		}
+		t.Cleanup(func() { m.Close() })
+		return m
+	}
+
+	resolver, err := NewProcessResolver(nil, nil, NewProcessResolverOpts(nil))
+	if err != nil {
+		t.Fatal(err)
+	}
+	resolver.pidCacheMap = newMap(pidCacheExitTimestampOffset + 8)
+	resolver.procCacheMap = newMap(8)
+
+	putPidCache := func(pid uint32, cookie uint32, exitTimestamp uint64) {
+		value := make([]byte, pidCacheExitTimestampOffset+8)
+		model.ByteOrder.PutUint32(value, cookie)
+		model.ByteOrder.PutUint64(value[pidCacheExitTimestampOffset:], exitTimestamp)
+		if err := resolver.pidCacheMap.Put(pid, value); err != nil {
+			t.Fatal(err)
+		}
+	}
+	hasPidCache := func(pid uint32) bool {
+		value, err := resolver.pidCacheMap.LookupBytes(pid)
+		return err == nil && value != nil
+	}
+	hasProcCache := func(cookie uint32) bool {
+		value, err := resolver.procCacheMap.LookupBytes(cookie)
+		return err == nil && value != nil
+	}
+
+	// 10 exited, 11 will be reused by a live process, 12 will show up in /proc again
+	for _, pid := range []uint32{10, 11, 12} {
+		entry := resolver.NewProcessCacheEntry(model.PIDContext{Pid: pid, Tid: pid})
+		entry.Cookie = pid * 10
+		entry.ForkTime = time.Now()
+		resolver.AddForkEntry(entry)
+
+		putPidCache(pid, entry.Cookie, uint64(time.Now().UnixNano()))
+		if err := resolver.procCacheMap.Put(entry.Cookie, make([]byte, 8)); err != nil {
+			t.Fatal(err)
+		}
+
+		resolver.DeleteEntry(pid, time.Now())
+	}
+
+	// the entries deleted since the previous flush are only queued
+	resolver.flushKernelEntries(map[uint32]bool{})
+	for _, pid := range []uint32{10, 11, 12} {
+		assert.True(t, hasPidCache(pid), "pid_cache entry of %d released too early", pid)
+		assert.True(t, hasProcCache(pid*10), "proc_cache entry of %d released too early", pid)
+	}
+
+	putPidCache(11, 111, 0)
+
+	resolver.flushKernelEntries(map[uint32]bool{12: true})
+	assert.False(t, hasPidCache(10), "pid_cache entry of an exited process not released")
+	assert.False(t, hasProcCache(100), "proc_cache entry of an exited process not released")
+	assert.True(t, hasPidCache(11), "pid_cache entry of a reused pid released")
+	assert.True(t, hasPidCache(12), "pid_cache entry of a live pid released")
+	assert.EqualValues(t, 1, resolver.releasedKernelEntries.Load())
+
+	// nothing left to release
+	resolver.flushKernelEntries(map[uint32]bool{})
+	assert.True(t, hasPidCache(11))
+	assert.True(t, hasPidCache(12))
+	assert.EqualValues(t, 1, resolver.releasedKernelEntries.Load())
+}
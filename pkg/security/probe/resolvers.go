@@ -62,12 +62,17 @@ func NewResolvers(config *config.Config, probe *Probe) (*Resolvers, error) {
 		return nil, err
 	}
 
+	containerResolver, err := NewContainerResolver(probe.statsdClient)
+	if err != nil {
+		return nil, err
+	}
+
 	resolvers := &Resolvers{
 		probe:             probe,
 		DentryResolver:    dentryResolver,
 		MountResolver:     mountResolver,
 		TimeResolver:      timeResolver,
-		ContainerResolver: &ContainerResolver{},
+		ContainerResolver: containerResolver,
 		UserGroupResolver: userGroupResolver,
 		TagsResolver:      NewTagsResolver(config),
 		NamespaceResolver: namespaceResolver,
@@ -190,6 +195,10 @@ func (r *Resolvers) Start(ctx context.Context) error {
 	}
 	r.MountResolver.Start(ctx)
 
+	if err := r.ContainerResolver.Start(r.probe); err != nil {
+		return err
+	}
+
 	if err := r.TagsResolver.Start(ctx); err != nil {
 		return err
 	}
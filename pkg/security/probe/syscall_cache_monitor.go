@@ -0,0 +1,102 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build linux
+// +build linux
+
+package probe
+
+import (
+	"fmt"
+
+	"github.com/DataDog/datadog-go/v5/statsd"
+	lib "github.com/cilium/ebpf"
+
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+	"github.com/DataDog/datadog-agent/pkg/security/utils"
+)
+
+// SyscallCacheStats is used to collect kernel space metrics about the syscall caches
+type SyscallCacheStats struct {
+	Cached      uint64
+	Overwritten uint64
+	Hits        uint64
+	Misses      uint64
+}
+
+// SyscallCacheMonitor reports the usage of the kernel syscall caches
+type SyscallCacheMonitor struct {
+	statsdClient statsd.ClientInterface
+	stats        *lib.Map
+	numCPU       int
+
+	// lastStats holds the totals of the previous collection, the kernel counters are never reset
+	lastStats []SyscallCacheStats
+}
+
+// NewSyscallCacheMonitor returns a new SyscallCacheMonitor
+func NewSyscallCacheMonitor(p *Probe) (*SyscallCacheMonitor, error) {
+	numCPU, err := utils.NumCPU()
+	if err != nil {
+		return nil, fmt.Errorf("couldn't fetch the host CPU count: %w", err)
+	}
+
+	stats, err := p.Map("syscall_cache_stats")
+	if err != nil {
+		return nil, err
+	}
+
+	return &SyscallCacheMonitor{
+		statsdClient: p.statsdClient,
+		stats:        stats,
+		numCPU:       numCPU,
+		lastStats:    make([]SyscallCacheStats, model.MaxKernelEventType),
+	}, nil
+}
+
+// SendStats sends the syscall cache metrics
+func (m *SyscallCacheMonitor) SendStats() error {
+	var eventType uint32
+	stats := make([]SyscallCacheStats, m.numCPU)
+
+	iterator := m.stats.Iterate()
+	for iterator.Next(&eventType, &stats) {
+		if int(eventType) >= len(m.lastStats) {
+			continue
+		}
+
+		var total SyscallCacheStats
+		for _, stat := range stats {
+			total.Cached += stat.Cached
+			total.Overwritten += stat.Overwritten
+			total.Hits += stat.Hits
+			total.Misses += stat.Misses
+		}
+
+		last := m.lastStats[eventType]
+		m.lastStats[eventType] = total
+
+		// misses of lookups made without a specific type are reported with the "unknown" event type
+		tags := []string{fmt.Sprintf("event_type:%s", model.EventType(eventType))}
+		if delta := total.Cached - last.Cached; delta > 0 {
+			_ = m.statsdClient.Count(metrics.MetricSyscallCacheCached, int64(delta), tags, 1.0)
+		}
+		if delta := total.Overwritten - last.Overwritten; delta > 0 {
+			_ = m.statsdClient.Count(metrics.MetricSyscallCacheOverwritten, int64(delta), tags, 1.0)
+		}
+		if delta := total.Hits - last.Hits; delta > 0 {
+			_ = m.statsdClient.Count(metrics.MetricSyscallCacheHits, int64(delta), tags, 1.0)
+		}
+		if delta := total.Misses - last.Misses; delta > 0 {
+			_ = m.statsdClient.Count(metrics.MetricSyscallCacheMiss, int64(delta), tags, 1.0)
+		}
+	}
+	if err := iterator.Err(); err != nil {
+		return fmt.Errorf("failed to iterate over the syscall cache stats: %w", err)
+	}
+
+	return nil
+}
@@ -110,6 +110,8 @@ const (
 	CustomTruncatedParentsEventType
 	// CustomSelfTestEventType is the custom event used to report the results of a self test run
 	CustomSelfTestEventType
+	// CustomEventsSuppressedEventType is the custom event used to report the events suppressed by the in-kernel rate limiter
+	CustomEventsSuppressedEventType
 	// MaxAllEventType is used internally to get the maximum number of events.
 	MaxAllEventType
 )
@@ -205,6 +207,8 @@ func (t EventType) String() string {
 		return "truncated_parents"
 	case CustomSelfTestEventType:
 		return "self_test"
+	case CustomEventsSuppressedEventType:
+		return "events_suppressed"
 	default:
 		return "unknown"
 	}
@@ -70,11 +70,12 @@ func (e *FileFields) MarshalBinary(data []byte) (int, error) {
 // MarshalProcCache marshals a binary representation of itself
 func (e *Process) MarshalProcCache(data []byte) (int, error) {
 	// Marshal proc_cache_t
-	if len(data) < ContainerIDLen {
+	if len(data) < 8+ContainerIDLen {
 		return 0, ErrNotEnoughSpace
 	}
-	copy(data[0:ContainerIDLen], e.ContainerID)
-	written := ContainerIDLen
+	ByteOrder.PutUint64(data[0:8], ContainerCookie(e.ContainerID))
+	copy(data[8:8+ContainerIDLen], e.ContainerID)
+	written := 8 + ContainerIDLen
 
 	toAdd, err := MarshalBinary(data[written:], &e.FileEvent)
 	if err != nil {
@@ -29,13 +29,28 @@ type BinaryUnmarshaler interface {
 
 // UnmarshalBinary unmarshalls a binary representation of itself
 func (e *ContainerContext) UnmarshalBinary(data []byte) (int, error) {
-	id, err := UnmarshalString(data, ContainerIDLen)
+	if len(data) < 8 {
+		return 0, ErrNotEnoughData
+	}
+	e.Cookie = ByteOrder.Uint64(data[0:8])
+
+	return 8, nil
+}
+
+// UnmarshalContainerEntryBinary unmarshalls the container_entry_t of a proc_cache entry
+func (e *ContainerContext) UnmarshalContainerEntryBinary(data []byte) (int, error) {
+	if len(data) < 8+ContainerIDLen {
+		return 0, ErrNotEnoughData
+	}
+	e.Cookie = ByteOrder.Uint64(data[0:8])
+
+	id, err := UnmarshalString(data[8:], ContainerIDLen)
 	if err != nil {
 		return 0, err
 	}
 	e.ID = id
 
-	return ContainerIDLen, nil
+	return 8 + ContainerIDLen, nil
 }
 
 // UnmarshalBinary unmarshalls a binary representation of itself
@@ -829,10 +844,12 @@ func (e *SpliceEvent) UnmarshalBinary(data []byte) (int, error) {
 
 // UnmarshalBinary unmarshals a binary representation of itself
 func (e *CgroupTracingEvent) UnmarshalBinary(data []byte) (int, error) {
-	read, err := UnmarshalBinary(data, &e.ContainerContext)
+	id, err := UnmarshalString(data, ContainerIDLen)
 	if err != nil {
 		return 0, err
 	}
+	e.ContainerContext.ID = id
+	read := ContainerIDLen
 
 	if len(data)-read < 8 {
 		return 0, ErrNotEnoughData
@@ -9,6 +9,7 @@ import (
 	"bytes"
 	"crypto/sha256"
 	"fmt"
+	"hash/fnv"
 	"regexp"
 	"unsafe"
 )
@@ -21,6 +22,21 @@ func FindContainerID(s string) string {
 	return containerIDPattern.FindString(s)
 }
 
+// ContainerCookie returns the cookie identifying a container in the kernel events: the FNV-1a hash of its
+// NULL padded ID, see hash_container_id in pkg/security/ebpf/c/container.h
+func ContainerCookie(id string) uint64 {
+	if len(id) == 0 {
+		return 0
+	}
+
+	var raw [ContainerIDLen]byte
+	copy(raw[:], id)
+
+	h := fnv.New64a()
+	_, _ = h.Write(raw[:])
+	return h.Sum64()
+}
+
 // SliceToArray copy src bytes to dst. Destination should have enough space
 func SliceToArray(src []byte, dst unsafe.Pointer) {
 	for i := range src {
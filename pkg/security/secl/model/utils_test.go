@@ -22,6 +22,25 @@ func TestUnmarshalString(t *testing.T) {
 	assert.Equal(t, "ABC", str)
 }
 
+func TestContainerCookie(t *testing.T) {
+	id := "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+
+	assert.Equal(t, uint64(0), ContainerCookie(""))
+	assert.NotEqual(t, uint64(0), ContainerCookie(id))
+	assert.NotEqual(t, ContainerCookie(id), ContainerCookie(id[:63]+"0"))
+
+	data := make([]byte, 8+ContainerIDLen)
+	ByteOrder.PutUint64(data[0:8], ContainerCookie(id))
+	copy(data[8:], id)
+
+	var cc ContainerContext
+	read, err := cc.UnmarshalContainerEntryBinary(data)
+	assert.NoError(t, err)
+	assert.Equal(t, len(data), read)
+	assert.Equal(t, id, cc.ID)
+	assert.Equal(t, ContainerCookie(id), cc.Cookie)
+}
+
 func BenchmarkNullTerminatedString(b *testing.B) {
 	array := []byte{65, 66, 67, 0, 0, 0, 65, 66}
 	var s string
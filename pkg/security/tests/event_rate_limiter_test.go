@@ -0,0 +1,144 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build functionaltests
+// +build functionaltests
+
+package tests
+
+import (
+	"encoding/json"
+	"fmt"
+	"os"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	sprobe "github.com/DataDog/datadog-agent/pkg/security/probe"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/rules"
+)
+
+func TestEventRateLimiter(t *testing.T) {
+	const (
+		rate  = 1
+		burst = 5
+		opens = 20
+	)
+
+	ruleDefs := []*rules.RuleDefinition{
+		{
+			ID:         "test_event_rate_limiter",
+			Expression: `open.file.path == "{{.Root}}/test-event-rate-limiter"`,
+		},
+	}
+
+	test, err := newTestModule(t, nil, ruleDefs, testOpts{eventRateLimiterRate: rate, eventRateLimiterBurst: burst})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer test.Close()
+
+	testFile, _, err := test.Path("test-event-rate-limiter")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.Remove(testFile)
+
+	var received int64
+	test.RegisterRuleEventHandler(func(event *sprobe.Event, rule *rules.Rule) {
+		if rule.ID == "test_event_rate_limiter" {
+			atomic.AddInt64(&received, 1)
+		}
+	})
+	defer test.RegisterRuleEventHandler(nil)
+
+	openTestFile := func(count int) {
+		for i := 0; i < count; i++ {
+			f, err := os.OpenFile(testFile, os.O_CREATE|os.O_RDWR, 0755)
+			if err != nil {
+				t.Fatal(err)
+			}
+			f.Close()
+		}
+	}
+
+	// flush the stats collected while the module was starting
+	test.probe.SendStats()
+	test.statsdClient.Flush()
+
+	t.Run("suppression", func(t *testing.T) {
+		openTestFile(opens)
+
+		// the opens run well within a second, only the burst can go through
+		assert.Eventually(t, func() bool {
+			return atomic.LoadInt64(&received) >= burst
+		}, 5*time.Second, 100*time.Millisecond)
+		time.Sleep(time.Second)
+		assert.Equal(t, int64(burst), atomic.LoadInt64(&received))
+	})
+
+	t.Run("summary", func(t *testing.T) {
+		err = test.GetProbeCustomEvent(t, func() error {
+			return test.probe.SendStats()
+		}, func(rule *rules.Rule, customEvent *sprobe.CustomEvent) bool {
+			assert.Equal(t, sprobe.EventsSuppressedRuleID, rule.ID, "wrong rule")
+
+			data, err := customEvent.MarshalJSON()
+			if err != nil {
+				t.Error(err)
+				return true
+			}
+
+			var summary sprobe.EventsSuppressedEvent
+			if err := json.Unmarshal(data, &summary); err != nil {
+				t.Error(err)
+				return true
+			}
+
+			assert.Equal(t, rate, summary.Rate)
+			assert.Equal(t, burst, summary.Burst)
+			for _, process := range summary.Processes {
+				if process.Pid == uint32(os.Getpid()) {
+					assert.Equal(t, uint64(opens-burst), process.Suppressed[model.FileOpenEventType.String()])
+					return true
+				}
+			}
+			t.Errorf("test process not found in %s", string(data))
+			return true
+		}, model.CustomEventsSuppressedEventType)
+		if err != nil {
+			t.Fatal(err)
+		}
+
+		key := fmt.Sprintf("%s:event_type:%s", metrics.MetricEventRateLimiterSuppressed, model.FileOpenEventType)
+		assert.Equal(t, int64(opens-burst), test.statsdClient.counts[key])
+		test.statsdClient.Flush()
+
+		// nothing was suppressed since the previous report
+		test.probe.SendStats()
+		assert.Zero(t, test.statsdClient.counts[key])
+	})
+
+	t.Run("refill", func(t *testing.T) {
+		atomic.StoreInt64(&received, 0)
+
+		// wait for a few tokens to be refilled, but not for the whole burst
+		time.Sleep(3 * time.Second / rate)
+		openTestFile(opens)
+
+		assert.Eventually(t, func() bool {
+			return atomic.LoadInt64(&received) >= 3
+		}, 5*time.Second, 100*time.Millisecond)
+		time.Sleep(time.Second)
+
+		count := atomic.LoadInt64(&received)
+		assert.GreaterOrEqual(t, count, int64(3))
+		assert.LessOrEqual(t, count, int64(burst), "the bucket shouldn't have been refilled past its burst")
+	})
+}
@@ -93,6 +93,12 @@ runtime_security_config:
 {{end}}
   load_controller:
     events_count_threshold: {{ .EventsCountThreshold }}
+{{if .EventRateLimiterRate}}
+  event_rate_limiter:
+    enabled: true
+    rate: {{ .EventRateLimiterRate }}
+    burst: {{ .EventRateLimiterBurst }}
+{{end}}
 {{if .DisableFilters}}
   enable_kernel_filters: false
 {{end}}
@@ -173,6 +179,8 @@ type testOpts struct {
 	enableActivityDump          bool
 	disableDiscarders           bool
 	eventsCountThreshold        int
+	eventRateLimiterRate        int
+	eventRateLimiterBurst       int
 	reuseProbeHandler           bool
 	disableERPCDentryResolution bool
 	disableMapDentryResolution  bool
@@ -195,6 +203,8 @@ func (to testOpts) Equal(opts testOpts) bool {
 		to.disableDiscarders == opts.disableDiscarders &&
 		to.disableFilters == opts.disableFilters &&
 		to.eventsCountThreshold == opts.eventsCountThreshold &&
+		to.eventRateLimiterRate == opts.eventRateLimiterRate &&
+		to.eventRateLimiterBurst == opts.eventRateLimiterBurst &&
 		to.reuseProbeHandler == opts.reuseProbeHandler &&
 		to.disableERPCDentryResolution == opts.disableERPCDentryResolution &&
 		to.disableMapDentryResolution == opts.disableMapDentryResolution &&
@@ -617,6 +627,8 @@ func genTestConfig(dir string, opts testOpts) (*config.Config, error) {
 		"DisableApprovers":            opts.disableApprovers,
 		"EnableActivityDump":          opts.enableActivityDump,
 		"EventsCountThreshold":        opts.eventsCountThreshold,
+		"EventRateLimiterRate":        opts.eventRateLimiterRate,
+		"EventRateLimiterBurst":       opts.eventRateLimiterBurst,
 		"ErpcDentryResolutionEnabled": erpcDentryResolutionEnabled,
 		"MapDentryResolutionEnabled":  mapDentryResolutionEnabled,
 		"LogPatterns":                 logPatterns,
@@ -0,0 +1,65 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2016-present Datadog, Inc.
+
+//go:build functionaltests
+// +build functionaltests
+
+package tests
+
+import (
+	"os/exec"
+	"runtime"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"golang.org/x/sys/unix"
+
+	"github.com/DataDog/datadog-agent/pkg/security/metrics"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/model"
+	"github.com/DataDog/datadog-agent/pkg/security/secl/rules"
+)
+
+func TestSyscallCacheStats(t *testing.T) {
+	ruleDefs := []*rules.RuleDefinition{
+		{
+			ID:         "test_syscall_cache_signal",
+			Expression: `signal.type == SIGUSR1 && process.file.name == "syscall_cache_test"`,
+		},
+	}
+
+	test, err := newTestModule(t, nil, ruleDefs, testOpts{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer test.Close()
+
+	test.probe.SendStats()
+	test.statsdClient.Flush()
+
+	// fork then kill from the same thread, the fork entry must have been popped when the kill is cached
+	func() {
+		runtime.LockOSThread()
+		defer runtime.UnlockOSThread()
+
+		cmd := exec.Command("sleep", "10")
+		if err := cmd.Start(); err != nil {
+			t.Fatal(err)
+		}
+		if err := unix.Kill(cmd.Process.Pid, unix.SIGKILL); err != nil {
+			t.Fatal(err)
+		}
+		_ = cmd.Wait()
+	}()
+
+	test.probe.SendStats()
+
+	forkTag := ":event_type:" + model.ForkEventType.String()
+	signalTag := ":event_type:" + model.SignalEventType.String()
+
+	assert.NotZero(t, test.statsdClient.counts[metrics.MetricSyscallCacheCached+forkTag])
+	assert.NotZero(t, test.statsdClient.counts[metrics.MetricSyscallCacheHits+forkTag])
+	assert.NotZero(t, test.statsdClient.counts[metrics.MetricSyscallCacheCached+signalTag])
+	assert.Zero(t, test.statsdClient.counts[metrics.MetricSyscallCacheOverwritten+signalTag])
+}
@@ -0,0 +1,270 @@
+// Unless explicitly stated otherwise all files in this repository are licensed
+// under the Apache License Version 2.0.
+// This product includes software developed at Datadog (https://www.datadoghq.com/).
+// Copyright 2019-present Datadog, Inc.
+
+// Micro-benchmarks of the rtloader builtins and check runs, driving a real embedded
+// interpreter with stub callbacks. For each benchmark it reports:
+//  - ns/op: the wall time of an operation, GIL acquisition included
+//  - allocs/op: the allocations made through the rtloader allocator (_malloc, strdupe...)
+//  - gil-ns/op: the time the GIL is held per operation
+#include "datadog_agent_rtloader.h"
+#include "rtloader_mem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Operations run per GIL acquisition by the benchmarks calling a builtin from python
+#define OPS_PER_ROUND 100
+#define DEFAULT_OPS 100000
+
+static rtloader_t *rtloader;
+static unsigned long long allocations = 0;
+
+//
+// stub callbacks
+//
+
+static void memoryTracker(void *ptr, size_t sz, rtloader_mem_ops_t op)
+{
+    if (op == DATADOG_AGENT_RTLOADER_ALLOCATION) {
+        allocations++;
+    }
+}
+
+static sender_handle_t getSenderHandle(char *check_id)
+{
+    return 1;
+}
+
+static void releaseSenderHandle(sender_handle_t handle)
+{
+}
+
+static void submitMetric(sender_handle_t handle, char *id, metric_type_t mt, char *name, double val, char *tags,
+                         int tags_size, char *hostname, bool flush_first_val)
+{
+}
+
+static void submitEvent(char *id, event_t *ev)
+{
+}
+
+static char **tags(char *id, int cardinality)
+{
+    char **data = _malloc(sizeof(*data) * 3);
+    data[0] = strdupe("image_name:agent");
+    data[1] = strdupe("kube_namespace:default");
+    data[2] = NULL;
+    return data;
+}
+
+static void getConfig(char *key, char **data)
+{
+    *data = strdupe("value");
+}
+
+static void getSubprocessOutput(char **argv, char **env, char **stdout_, char **stderr_, int *ret_code,
+                                char **exception)
+{
+    *stdout_ = strdupe("output\n");
+    *stderr_ = strdupe("");
+    *ret_code = 0;
+    *exception = NULL;
+}
+
+//
+// benchmarks
+//
+
+typedef struct benchmark_s {
+    const char *name;
+    // python statements run once before the benchmark
+    const char *setup;
+    // python statement benchmarked, run OPS_PER_ROUND times per round. When NULL the
+    // benchmark runs the check created by the setup instead.
+    const char *op;
+} benchmark_t;
+
+static const benchmark_t benchmarks[] = {
+    { "SubmitMetric", "import aggregator",
+      "aggregator.submit_metric(None, 'id', aggregator.GAUGE, 'bench.metric', 1.0, ['env:bench', 'service:rtloader', "
+      "'version:1'], 'host', False)" },
+    { "SubmitEvent", "import aggregator",
+      "aggregator.submit_event(None, 'id', {'msg_title': 'title', 'msg_text': 'text', 'timestamp': 1, 'host': "
+      "'host', 'tags': ['env:bench', 'service:rtloader']})" },
+    { "TaggerTag", "import tagger", "tagger.tag('container_id://bench', tagger.LOW)" },
+    { "GetConfig", "import datadog_agent", "datadog_agent.get_config('bench_key')" },
+    { "SubprocessOutput", "import _util", "_util.subprocess_output(['true'], False)" },
+    { "RunCheck", NULL, NULL },
+};
+
+static unsigned long long now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int run_code(const char *code)
+{
+    rtloader_gilstate_t state = ensure_gil(rtloader);
+    int ok = run_simple_string(rtloader, code);
+    release_gil(rtloader, state);
+    return ok;
+}
+
+static rtloader_pyobject_t *make_check()
+{
+    rtloader_pyobject_t *py_module = NULL;
+    rtloader_pyobject_t *py_class = NULL;
+    rtloader_pyobject_t *check = NULL;
+
+    rtloader_gilstate_t state = ensure_gil(rtloader);
+    if (get_class(rtloader, "bench_check", &py_module, &py_class)) {
+        if (!get_check(rtloader, py_class, "", "{}", "bench_check:1", "bench_check", &check)) {
+            check = NULL;
+        }
+        rtloader_decref(rtloader, py_class);
+        rtloader_decref(rtloader, py_module);
+    }
+    release_gil(rtloader, state);
+
+    return check;
+}
+
+// run_round runs OPS_PER_ROUND operations holding the GIL once, and returns
+// the time the GIL was held
+static int run_round(const char *round_code, rtloader_pyobject_t *check, unsigned long long *gil_ns)
+{
+    int ok = 1;
+    rtloader_gilstate_t state = ensure_gil(rtloader);
+    unsigned long long start = now();
+
+    if (round_code != NULL) {
+        ok = run_simple_string(rtloader, round_code);
+    } else {
+        int i;
+        for (i = 0; ok && i < OPS_PER_ROUND; i++) {
+            char *result = run_check(rtloader, check);
+            ok = result != NULL && result[0] == '\0';
+            rtloader_free(rtloader, result);
+        }
+    }
+
+    *gil_ns += now() - start;
+    release_gil(rtloader, state);
+    return ok;
+}
+
+static int run_benchmark(const benchmark_t *b, int ops)
+{
+    char *round_code = NULL;
+    rtloader_pyobject_t *check = NULL;
+
+    if (b->op != NULL) {
+        if (!run_code(b->setup)) {
+            printf("Benchmark%s: setup failed\n", b->name);
+            return 0;
+        }
+
+        const char *loop = "for _ in range(%d):\n    %s\n";
+        size_t sz = strlen(loop) + strlen(b->op) + 16;
+        round_code = _malloc(sz);
+        snprintf(round_code, sz, loop, OPS_PER_ROUND, b->op);
+    } else if ((check = make_check()) == NULL) {
+        printf("Benchmark%s: could not create the check: %s\n", b->name,
+               has_error(rtloader) ? get_error(rtloader) : "unknown error");
+        return 0;
+    }
+
+    // warm up
+    int ok = run_round(round_code, check, &(unsigned long long){ 0 });
+
+    int rounds = (ops + OPS_PER_ROUND - 1) / OPS_PER_ROUND;
+    unsigned long long gil_ns = 0;
+    unsigned long long allocations_start = allocations;
+    unsigned long long start = now();
+    int i;
+    for (i = 0; ok && i < rounds; i++) {
+        ok = run_round(round_code, check, &gil_ns);
+    }
+    unsigned long long elapsed = now() - start;
+
+    if (ok) {
+        double n = (double)rounds * OPS_PER_ROUND;
+        printf("Benchmark%-20s %10.0f %12.1f ns/op %8.2f allocs/op %12.1f gil-ns/op\n", b->name, n, elapsed / n,
+               (allocations - allocations_start) / n, gil_ns / n);
+    } else {
+        printf("Benchmark%s: failed: %s\n", b->name, has_error(rtloader) ? get_error(rtloader) : "unknown error");
+    }
+
+    _free(round_code);
+    if (check != NULL) {
+        rtloader_gilstate_t state = ensure_gil(rtloader);
+        rtloader_decref(rtloader, check);
+        release_gil(rtloader, state);
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        printf("Please run: rtloader-bench <2|3> [operations_per_benchmark]\n");
+        return 1;
+    }
+
+    int ops = DEFAULT_OPS;
+    if (argc == 3) {
+        ops = atoi(argv[2]);
+        if (ops <= 0) {
+            printf("Invalid number of operations: %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    set_memory_tracker_cb(memoryTracker);
+
+    char *init_error = NULL;
+    if (strcmp(argv[1], "2") == 0) {
+        rtloader = make2(NULL, "", &init_error);
+    } else if (strcmp(argv[1], "3") == 0) {
+        rtloader = make3(NULL, "", &init_error);
+    } else {
+        printf("Unrecognized version: %s\n", argv[1]);
+        return 2;
+    }
+    if (!rtloader) {
+        printf("Unable to init Python%s: %s\n", argv[1], init_error);
+        return 1;
+    }
+
+    set_cgo_free_cb(rtloader, _free);
+    set_sender_handle_cbs(rtloader, getSenderHandle, releaseSenderHandle);
+    set_submit_metric_cb(rtloader, submitMetric);
+    set_submit_event_cb(rtloader, submitEvent);
+    set_tags_cb(rtloader, tags);
+    set_get_config_cb(rtloader, getConfig);
+    set_get_subprocess_output_cb(rtloader, getSubprocessOutput);
+
+    add_python_path(rtloader, BENCH_CHECKS_PATH);
+    add_python_path(rtloader, TEST_CHECKS_PATH);
+
+    if (!init(rtloader)) {
+        printf("Error initializing rtloader: %s\n", get_error(rtloader));
+        return 1;
+    }
+
+    int failed = 0;
+    size_t i;
+    for (i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (!run_benchmark(&benchmarks[i], ops)) {
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,15 @@
+import aggregator
+from datadog_checks.base.checks import AgentCheck
+
+TAGS = ['env:bench', 'service:rtloader', 'version:1']
+
+
+# Check submitting a few metrics per run, like a small integration would
+class BenchCheck(AgentCheck):
+    def run(self):
+        for i in range(10):
+            aggregator.submit_metric(self, 'bench_check:1', aggregator.GAUGE, 'bench.check.metric', i, TAGS, 'host', False)
+        return ""
+
+
+__version__ = '0.1.0'
@@ -6,8 +6,13 @@
 #include "rtloader_mem.h"
 #include "stringutils.h"
 
+#include <limits.h>
+#include <string.h>
+
 // these must be set by the Agent
 static cb_submit_metric_t cb_submit_metric = NULL;
+static cb_get_sender_handle_t cb_get_sender_handle = NULL;
+static cb_release_sender_handle_t cb_release_sender_handle = NULL;
 static cb_submit_service_check_t cb_submit_service_check = NULL;
 static cb_submit_event_t cb_submit_event = NULL;
 static cb_submit_histogram_bucket_t cb_submit_histogram_bucket = NULL;
@@ -20,6 +25,12 @@ static PyObject *submit_event(PyObject *self, PyObject *args);
 static PyObject *submit_histogram_bucket(PyObject *self, PyObject *args);
 static PyObject *submit_event_platform_event(PyObject *self, PyObject *args);
 
+#define SENDER_HANDLE_ATTR "_sender_handle"
+#define SENDER_HANDLE_CAPSULE_NAME AGGREGATOR_MODULE_NAME ".sender_handle"
+
+// interned name of the sender handle attribute, so that looking it up doesn't allocate
+static PyObject *sender_handle_attr = NULL;
+
 static PyMethodDef methods[] = {
     { "submit_metric", (PyCFunction)submit_metric, METH_VARARGS, "Submit metrics." },
     { "submit_service_check", (PyCFunction)submit_service_check, METH_VARARGS, "Submit service checks." },
@@ -55,6 +66,7 @@ PyMODINIT_FUNC PyInit_aggregator(void)
 {
     PyObject *m = PyModule_Create(&module_def);
     add_constants(m);
+    sender_handle_attr = PyUnicode_InternFromString(SENDER_HANDLE_ATTR);
     return m;
 }
 #elif defined(DATADOG_AGENT_TWO)
@@ -65,6 +77,7 @@ void Py2_init_aggregator()
 {
     module = Py_InitModule(AGGREGATOR_MODULE_NAME, methods);
     add_constants(module);
+    sender_handle_attr = PyString_InternFromString(SENDER_HANDLE_ATTR);
 }
 #endif
 
@@ -73,6 +86,73 @@ void _set_submit_metric_cb(cb_submit_metric_t cb)
     cb_submit_metric = cb;
 }
 
+void _set_sender_handle_cbs(cb_get_sender_handle_t get_cb, cb_release_sender_handle_t release_cb)
+{
+    cb_get_sender_handle = get_cb;
+    cb_release_sender_handle = release_cb;
+}
+
+/*! \fn release_sender_handle(PyObject *capsule)
+    \brief Destructor of the sender handle capsules, called when the check instance
+    holding the capsule is garbage collected.
+*/
+static void release_sender_handle(PyObject *capsule)
+{
+    sender_handle_t handle = (sender_handle_t)PyCapsule_GetPointer(capsule, SENDER_HANDLE_CAPSULE_NAME);
+    if (handle != 0 && cb_release_sender_handle != NULL) {
+        cb_release_sender_handle(handle);
+    }
+}
+
+int _bind_sender_handle(PyObject *check, const char *check_id)
+{
+    if (cb_get_sender_handle == NULL) {
+        return 1;
+    }
+
+    sender_handle_t handle = cb_get_sender_handle((char *)check_id);
+    if (handle == 0) {
+        return 1;
+    }
+
+    PyObject *capsule = PyCapsule_New((void *)handle, SENDER_HANDLE_CAPSULE_NAME, release_sender_handle); // new reference
+    if (capsule == NULL) {
+        if (cb_release_sender_handle != NULL) {
+            cb_release_sender_handle(handle);
+        }
+        return 0;
+    }
+
+    // on failure the capsule is destroyed below, which releases the handle
+    int ret = PyObject_SetAttr(check, sender_handle_attr, capsule);
+    Py_DECREF(capsule);
+    return ret == 0;
+}
+
+/*! \fn get_sender_handle(PyObject *check)
+    \brief Returns the sender handle bound to a check instance by _bind_sender_handle(),
+    or 0 if it has none.
+*/
+static sender_handle_t get_sender_handle(PyObject *check)
+{
+    if (check == NULL || check == Py_None || sender_handle_attr == NULL) {
+        return 0;
+    }
+
+    PyObject *capsule = PyObject_GetAttr(check, sender_handle_attr); // new reference
+    if (capsule == NULL) {
+        PyErr_Clear();
+        return 0;
+    }
+
+    sender_handle_t handle = 0;
+    if (PyCapsule_IsValid(capsule, SENDER_HANDLE_CAPSULE_NAME)) {
+        handle = (sender_handle_t)PyCapsule_GetPointer(capsule, SENDER_HANDLE_CAPSULE_NAME);
+    }
+    Py_DECREF(capsule);
+    return handle;
+}
+
 void _set_submit_service_check_cb(cb_submit_service_check_t cb)
 {
     cb_submit_service_check = cb;
@@ -156,6 +236,103 @@ done:
     return tags;
 }
 
+/*! \fn tag_view(PyObject *item)
+    \brief A helper returning the UTF-8 representation of a python string tag without copying it.
+    \return a const char * pointer owned by the python object, or NULL if the item isn't a valid
+    string (it's then skipped, just like py_tag_to_c() does).
+*/
+static const char *tag_view(PyObject *item)
+{
+#ifdef DATADOG_AGENT_TWO
+    if (!PyString_Check(item) && !PyUnicode_Check(item)) {
+        return NULL;
+    }
+    // for unicode objects, the encoded string is cached in the object
+    const char *tag = PyString_AsString(item);
+#else
+    const char *tag = NULL;
+    if (PyBytes_Check(item)) {
+        tag = PyBytes_AS_STRING(item);
+    } else if (PyUnicode_Check(item)) {
+        // the UTF-8 representation is cached in the unicode object
+        tag = PyUnicode_AsUTF8(item);
+    }
+#endif
+    if (tag == NULL) {
+        PyErr_Clear();
+    }
+    return tag;
+}
+
+/*! \fn py_tags_to_packed(PyObject *py_tags, int *size)
+    \brief A function to convert a list of python strings (tags) into a single packed buffer.
+    \param py_tags A PyObject * pointer to the python tag sequence.
+    \param size An int * pointer where the size of the buffer is written.
+    \return a char * pointer to the packed buffer, NULL in the event of failure.
+
+    Each tag is written as its length (32 bits, little endian) followed by its bytes, without
+    NUL terminator, so that go-land can convert all the tags of a submission at once. Invalid
+    tags are skipped. The buffer is heap allocated here and should be freed by the caller. This
+    function may set and raise python interpreter errors.
+*/
+static char *py_tags_to_packed(PyObject *py_tags, int *size)
+{
+    PyObject *py_tags_list = NULL; // new reference
+    char *packed = NULL;
+
+    if (!PySequence_Check(py_tags)) {
+        PyErr_SetString(PyExc_TypeError, "tags must be a sequence");
+        return NULL;
+    }
+
+    py_tags_list = PySequence_Fast(py_tags, "py_tags is not a sequence"); // new reference
+    if (py_tags_list == NULL) {
+        return NULL;
+    }
+
+    Py_ssize_t len = PySequence_Fast_GET_SIZE(py_tags_list);
+    size_t total = 0;
+    Py_ssize_t i;
+    for (i = 0; i < len; i++) {
+        // `item` is borrowed, no need to decref
+        const char *tag = tag_view(PySequence_Fast_GET_ITEM(py_tags_list, i));
+        if (tag != NULL) {
+            total += sizeof(uint32_t) + strlen(tag);
+        }
+    }
+
+    if (total > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "tags are too large");
+        goto done;
+    }
+
+    // always return a valid pointer, even without tags
+    if (!(packed = _malloc(total > 0 ? total : 1))) {
+        PyErr_SetString(PyExc_RuntimeError, "could not allocate memory for tags");
+        goto done;
+    }
+
+    unsigned char *cursor = (unsigned char *)packed;
+    for (i = 0; i < len; i++) {
+        const char *tag = tag_view(PySequence_Fast_GET_ITEM(py_tags_list, i));
+        if (tag == NULL) {
+            continue;
+        }
+        uint32_t tag_len = (uint32_t)strlen(tag);
+        cursor[0] = tag_len & 0xff;
+        cursor[1] = (tag_len >> 8) & 0xff;
+        cursor[2] = (tag_len >> 16) & 0xff;
+        cursor[3] = (tag_len >> 24) & 0xff;
+        memcpy(cursor + sizeof(uint32_t), tag, tag_len);
+        cursor += sizeof(uint32_t) + tag_len;
+    }
+    *size = (int)total;
+
+done:
+    Py_XDECREF(py_tags_list);
+    return packed;
+}
+
 /*! \fn free_tags(char **tags)
     \brief A helper function to free the memory allocated by the py_tag_to_c() function.
 
@@ -195,7 +372,8 @@ static PyObject *submit_metric(PyObject *self, PyObject *args)
     char *name = NULL;
     char *hostname = NULL;
     char *check_id = NULL;
-    char **tags = NULL;
+    char *tags = NULL;
+    int tags_size = 0;
     int mt;
     double value;
     bool flush_first_value = false;
@@ -205,12 +383,12 @@ static PyObject *submit_metric(PyObject *self, PyObject *args)
         goto error;
     }
 
-    if ((tags = py_tag_to_c(py_tags)) == NULL)
+    if ((tags = py_tags_to_packed(py_tags, &tags_size)) == NULL)
         goto error;
 
-    cb_submit_metric(check_id, mt, name, value, tags, hostname, flush_first_value);
+    cb_submit_metric(get_sender_handle(check), check_id, mt, name, value, tags, tags_size, hostname, flush_first_value);
 
-    free_tags(tags);
+    _free(tags);
 
     PyGILState_Release(gstate);
     Py_RETURN_NONE;
@@ -392,7 +570,8 @@ static PyObject *submit_histogram_bucket(PyObject *self, PyObject *args)
     float upper_bound;
     int monotonic;
     char *hostname = NULL;
-    char **tags = NULL;
+    char *tags = NULL;
+    int tags_size = 0;
     bool flush_first_value = false;
 
     // Python call: aggregator.submit_histogram_bucket(self, metric string, value, lowerBound, upperBound, monotonic, hostname, tags, flush_first_value)
@@ -400,12 +579,12 @@ static PyObject *submit_histogram_bucket(PyObject *self, PyObject *args)
         goto error;
     }
 
-    if ((tags = py_tag_to_c(py_tags)) == NULL)
+    if ((tags = py_tags_to_packed(py_tags, &tags_size)) == NULL)
         goto error;
 
-    cb_submit_histogram_bucket(check_id, name, value, lower_bound, upper_bound, monotonic, hostname, tags, flush_first_value);
+    cb_submit_histogram_bucket(check_id, name, value, lower_bound, upper_bound, monotonic, hostname, tags, tags_size, flush_first_value);
 
-    free_tags(tags);
+    _free(tags);
 
     PyGILState_Release(gstate);
     Py_RETURN_NONE;
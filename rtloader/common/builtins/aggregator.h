@@ -34,6 +34,25 @@
 
     The callback is expected to be provided by the rtloader caller - in go-context: CGO.
 */
+/*! \fn void _set_sender_handle_cbs(cb_get_sender_handle_t, cb_release_sender_handle_t)
+    \brief Sets the callbacks used to bind a sender handle to the check instances.
+    \param get_cb A function pointer with cb_get_sender_handle_t prototype returning the
+    sender handle of a check ID.
+    \param release_cb A function pointer with cb_release_sender_handle_t prototype called
+    once the check instance owning a handle is garbage collected.
+
+    The callbacks are expected to be provided by the rtloader caller - in go-context: CGO.
+*/
+/*! \fn int _bind_sender_handle(PyObject *check, const char *check_id)
+    \brief Binds the sender handle of a check ID to a check instance.
+    \param check A PyObject * pointer to the check instance.
+    \param check_id A C-string with the ID of the check instance.
+    \return 1 on success (including when no handle callback is set), 0 otherwise, with
+    the python error set.
+
+    The handle is stored in a capsule attribute of the instance and passed back to the
+    submit metric callback with every sample, it's released along with the instance.
+*/
 /*! \fn void _set_submit_service_check_cb(cb_submit_service_check_t)
     \brief Sets the submit service_check callback to be used by rtloader for service_check
     submission.
@@ -81,6 +100,8 @@ void Py2_init_aggregator();
 #endif
 
 void _set_submit_metric_cb(cb_submit_metric_t cb);
+void _set_sender_handle_cbs(cb_get_sender_handle_t get_cb, cb_release_sender_handle_t release_cb);
+int _bind_sender_handle(PyObject *check, const char *check_id);
 void _set_submit_service_check_cb(cb_submit_service_check_t cb);
 void _set_submit_event_cb(cb_submit_event_t cb);
 void _set_submit_histogram_bucket_cb(cb_submit_histogram_bucket_t cb);
@@ -28,15 +28,18 @@ char **get_tags(char *id, int highCard)
     return data;
 }
 
-void submitMetric(char *id, metric_type_t mt, char *name, double val, char **tags,  char *hostname, bool flush_first_val)
+void submitMetric(sender_handle_t handle, char *id, metric_type_t mt, char *name, double val, char *tags, int tags_size, char *hostname, bool flush_first_val)
 {
     printf("I'm extending Python providing aggregator.submit_metric:\n");
     printf("Check id: %s\n", id);
     printf("Metric '%s': %f\n", name, val);
     printf("Tags:\n");
-    int i;
-    for (i = 0; tags[i]; i++) {
-        printf(" %s", tags[i]);
+    int i = 0;
+    while (i < tags_size) {
+        unsigned char *len = (unsigned char *)tags + i;
+        int tag_len = len[0] | len[1] << 8 | len[2] << 16 | len[3] << 24;
+        printf(" %.*s", tag_len, tags + i + 4);
+        i += 4 + tag_len;
     }
     printf("\n");
     printf("Hostname: %s\n\n", hostname);
@@ -112,6 +112,28 @@ DATADOG_AGENT_RTLOADER_API rtloader_gilstate_t ensure_gil(rtloader_t *);
 */
 DATADOG_AGENT_RTLOADER_API void release_gil(rtloader_t *, rtloader_gilstate_t);
 
+/*! \fn rtloader_threadstate_t *acquire_thread_state(rtloader_t *)
+    \brief Creates a python thread state for the calling thread and keeps it alive until
+    `release_thread_state` is called, so that `ensure_gil` and `release_gil` don't have to
+    create and destroy one on each call from this thread.
+    \param rtloader_t A rtloader_t * pointer to the RtLoader instance.
+    \return A rtloader_threadstate_t * pointer to the thread state.
+    \sa rtloader_threadstate_t, rtloader_t, release_thread_state
+
+    The calling thread must not hold the GIL.
+*/
+DATADOG_AGENT_RTLOADER_API rtloader_threadstate_t *acquire_thread_state(rtloader_t *);
+
+/*! \fn void release_thread_state(rtloader_t *, rtloader_threadstate_t *)
+    \brief Destroys a python thread state created by `acquire_thread_state`.
+    \param rtloader_t A rtloader_t * pointer to the RtLoader instance.
+    \param rtloader_threadstate_t A rtloader_threadstate_t * pointer to the thread state.
+    \sa rtloader_threadstate_t, rtloader_t, acquire_thread_state
+
+    Must be called from the thread that acquired the thread state, while it doesn't hold the GIL.
+*/
+DATADOG_AGENT_RTLOADER_API void release_thread_state(rtloader_t *, rtloader_threadstate_t *);
+
 /*! \fn int get_class(rtloader_t *rtloader, const char *name, rtloader_pyobject_t **py_module,
                                     rtloader_pyobject_t **py_class)
     \brief Attempts to get a python class by name from a specified python module.
@@ -126,6 +148,20 @@ DATADOG_AGENT_RTLOADER_API void release_gil(rtloader_t *, rtloader_gilstate_t);
 DATADOG_AGENT_RTLOADER_API int get_class(rtloader_t *rtloader, const char *name, rtloader_pyobject_t **py_module,
                                          rtloader_pyobject_t **py_class);
 
+/*! \fn int preload_checks(rtloader_t *rtloader, char **modules, long long *import_times)
+    \brief Imports check modules and resolves their check class ahead of the loading of the
+    checks, `get_class` then returns the cached classes.
+    \param rtloader_t A rtloader_t * pointer to the RtLoader instance.
+    \param modules A NULL-terminated C-string array with the names of the modules to preload.
+    \param import_times A long long array, as long as modules, set to the time spent importing
+    each module in nanoseconds, or -1 if its check class couldn't be resolved.
+    \return The number of modules whose check class was resolved.
+    \sa rtloader_t, get_class
+
+    The error of the last failure, if any, is set on the RtLoader instance.
+*/
+DATADOG_AGENT_RTLOADER_API int preload_checks(rtloader_t *rtloader, char **modules, long long *import_times);
+
 /*! \fn int get_attr_string(rtloader_t *rtloader, rtloader_pyobject_t *py_class, const char *attr_name, char **value)
     \brief Attempts to get a string attribute from the supplied python class, by name.
     \param rtloader_t A rtloader_t * pointer to the RtLoader instance.
@@ -367,6 +403,18 @@ DATADOG_AGENT_RTLOADER_API char *get_interpreter_memory_usage(rtloader_t *);
 */
 DATADOG_AGENT_RTLOADER_API void set_submit_metric_cb(rtloader_t *, cb_submit_metric_t);
 
+/*! \fn void set_sender_handle_cbs(rtloader_t *, cb_get_sender_handle_t, cb_release_sender_handle_t)
+    \brief Sets the callbacks used to bind a sender handle to each check instance.
+    \param rtloader_t A rtloader_t * pointer to the RtLoader instance.
+    \param get_cb A function pointer with cb_get_sender_handle_t prototype returning the
+    handle of a check ID.
+    \param release_cb A function pointer with cb_release_sender_handle_t prototype called
+    when the check instance owning the handle is garbage collected.
+
+    The callbacks are expected to be provided by the rtloader caller - in go-context: CGO.
+*/
+DATADOG_AGENT_RTLOADER_API void set_sender_handle_cbs(rtloader_t *, cb_get_sender_handle_t, cb_release_sender_handle_t);
+
 /*! \fn void set_submit_service_check_cb(rtloader_t *, cb_submit_service_check_t)
     \brief Sets the submit service_check callback to be used by rtloader for service_check
     submission.
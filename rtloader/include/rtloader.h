@@ -71,6 +71,26 @@ public:
     */
     virtual void GILRelease(rtloader_gilstate_t) = 0;
 
+    //! Pure virtual acquireThreadState member.
+    /*!
+      \return A rtloader_threadstate_t * pointer to the thread state of the calling thread.
+      \sa releaseThreadState()
+      This method registers the calling thread with the underlying runtime and keeps its
+      thread state alive, so that the subsequent GILEnsure/GILRelease calls from this thread
+      reuse it instead of creating and destroying a thread state each time. Must be called
+      from a thread that doesn't hold the GIL. The GIL is released on return.
+    */
+    virtual rtloader_threadstate_t *acquireThreadState() = 0;
+
+    //! Pure virtual releaseThreadState member.
+    /*!
+      \param state A rtloader_threadstate_t * pointer returned by acquireThreadState.
+      \sa acquireThreadState()
+      This method destroys the thread state of the calling thread. Must be called from the
+      thread that acquired it, once it doesn't hold the GIL.
+    */
+    virtual void releaseThreadState(rtloader_threadstate_t *state) = 0;
+
     //! Pure virtual getClass member.
     /*!
      *
@@ -80,9 +100,26 @@ public:
       \param pyModule The python module we wish to load the class from.
       \param pyClass The output python object pointer to the loaded class, if we succeed.
       \return A boolean indicating the success or not of the operation.
+
+      The module and class resolved are cached, so that getting the class of a module again
+      doesn't import and scan the module.
     */
     virtual bool getClass(const char *module, RtLoaderPyObject *&pyModule, RtLoaderPyObject *&pyClass) = 0;
 
+    //! preloadChecks member.
+    /*!
+      \param modules A NULL-terminated array of C-strings with the names of the check modules to preload.
+      \param importTimes An output array, as long as modules, set to the time spent importing each module
+      and resolving its check class in nanoseconds, or -1 if it failed.
+      \return The number of modules whose check class was resolved.
+      \sa getClass()
+
+      This member resolves the check classes of the modules ahead of the loading of the checks, which
+      then get them from the cache of getClass. The error of the last failure, if any, is left set on
+      the RtLoader instance.
+    */
+    int preloadChecks(char **modules, long long *importTimes);
+
     //! Pure virtual getAttrString member.
     /*!
       \param obj The python object we wish to get the string attribute by name from.
@@ -240,6 +277,16 @@ public:
     */
     virtual void setSubmitMetricCb(cb_submit_metric_t) = 0;
 
+    //! setSenderHandleCbs member.
+    /*!
+      \param A cb_get_sender_handle_t function pointer to the CGO callback binding a sender handle to a check instance.
+      \param A cb_release_sender_handle_t function pointer to the CGO callback releasing that handle.
+
+      The handle is bound once in getCheck and passed back with every metric submitted by the check, so that
+      go-land doesn't have to look the sender up by check ID for each sample.
+    */
+    virtual void setSenderHandleCbs(cb_get_sender_handle_t, cb_release_sender_handle_t) = 0;
+
     //! setSubmitServiceCheckCb member.
     /*!
       \param A cb_submit_service_check_t function pointer to the CGO callback.
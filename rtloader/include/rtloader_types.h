@@ -6,6 +6,7 @@
 #ifndef DATADOG_AGENT_RTLOADER_TYPES_H
 #define DATADOG_AGENT_RTLOADER_TYPES_H
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -35,6 +36,9 @@ typedef enum rtloader_gilstate_e {
     DATADOG_AGENT_RTLOADER_GIL_UNLOCKED
 } rtloader_gilstate_t;
 
+struct rtloader_threadstate_s;
+typedef struct rtloader_threadstate_s rtloader_threadstate_t;
+
 typedef enum {
     DATADOG_AGENT_RTLOADER_ALLOCATION = 0,
     DATADOG_AGENT_RTLOADER_FREE,
@@ -92,14 +96,24 @@ typedef enum {
 
 // aggregator
 //
-// (id, metric_type, metric_name, value, tags, hostname, flush_first_value)
-typedef void (*cb_submit_metric_t)(char *, metric_type_t, char *, double, char **, char *, bool);
+// opaque handle to the sender of a check instance, 0 when the check has none
+typedef uintptr_t sender_handle_t;
+
+// (id)
+typedef sender_handle_t (*cb_get_sender_handle_t)(char *);
+// (sender_handle)
+typedef void (*cb_release_sender_handle_t)(sender_handle_t);
+// Tags of metrics and histogram buckets are packed in a single buffer: each tag is its length
+// (32 bits, little endian) followed by its bytes, without NUL terminator.
+//
+// (sender_handle, id, metric_type, metric_name, value, packed_tags, packed_tags_size, hostname, flush_first_value)
+typedef void (*cb_submit_metric_t)(sender_handle_t, char *, metric_type_t, char *, double, char *, int, char *, bool);
 // (id, sc_name, status, tags, hostname, message)
 typedef void (*cb_submit_service_check_t)(char *, char *, int, char **, char *, char *);
 // (id, event)
 typedef void (*cb_submit_event_t)(char *, event_t *);
-// (id, metric_name, value, lower_bound, upper_bound, monotonic, hostname, tags, flush_first_value)
-typedef void (*cb_submit_histogram_bucket_t)(char *, char *, long long, float, float, int, char *, char **, bool);
+// (id, metric_name, value, lower_bound, upper_bound, monotonic, hostname, packed_tags, packed_tags_size, flush_first_value)
+typedef void (*cb_submit_histogram_bucket_t)(char *, char *, long long, float, float, int, char *, char *, int, bool);
 // (id, event, event_type)
 typedef void (*cb_submit_event_platform_event_t)(char *, char *, char *);
 
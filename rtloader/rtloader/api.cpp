@@ -276,6 +276,16 @@ void release_gil(rtloader_t *rtloader, rtloader_gilstate_t state)
     AS_TYPE(RtLoader, rtloader)->GILRelease(state);
 }
 
+rtloader_threadstate_t *acquire_thread_state(rtloader_t *rtloader)
+{
+    return AS_TYPE(RtLoader, rtloader)->acquireThreadState();
+}
+
+void release_thread_state(rtloader_t *rtloader, rtloader_threadstate_t *state)
+{
+    AS_TYPE(RtLoader, rtloader)->releaseThreadState(state);
+}
+
 int get_class(rtloader_t *rtloader, const char *name, rtloader_pyobject_t **py_module, rtloader_pyobject_t **py_class)
 {
     return AS_TYPE(RtLoader, rtloader)
@@ -284,6 +294,11 @@ int get_class(rtloader_t *rtloader, const char *name, rtloader_pyobject_t **py_m
         : 0;
 }
 
+int preload_checks(rtloader_t *rtloader, char **modules, long long *import_times)
+{
+    return AS_TYPE(RtLoader, rtloader)->preloadChecks(modules, import_times);
+}
+
 int get_attr_string(rtloader_t *rtloader, rtloader_pyobject_t *py_class, const char *attr_name, char **value)
 {
     return AS_TYPE(RtLoader, rtloader)->getAttrString(AS_TYPE(RtLoaderPyObject, py_class), attr_name, *value);
@@ -457,6 +472,11 @@ void set_submit_metric_cb(rtloader_t *rtloader, cb_submit_metric_t cb)
     AS_TYPE(RtLoader, rtloader)->setSubmitMetricCb(cb);
 }
 
+void set_sender_handle_cbs(rtloader_t *rtloader, cb_get_sender_handle_t get_cb, cb_release_sender_handle_t release_cb)
+{
+    AS_TYPE(RtLoader, rtloader)->setSenderHandleCbs(get_cb, release_cb);
+}
+
 void set_submit_service_check_cb(rtloader_t *rtloader, cb_submit_service_check_t cb)
 {
     AS_TYPE(RtLoader, rtloader)->setSubmitServiceCheckCb(cb);
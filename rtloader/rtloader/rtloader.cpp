@@ -7,6 +7,8 @@
 #include "rtloader.h"
 #include "rtloader_mem.h"
 
+#include <chrono>
+
 void RtLoader::setError(const std::string &msg) const
 {
     _errorFlag = true;
@@ -42,6 +44,29 @@ void RtLoader::clearError()
     _error = "";
 }
 
+int RtLoader::preloadChecks(char **modules, long long *importTimes)
+{
+    int loaded = 0;
+    for (int i = 0; modules[i] != NULL; i++) {
+        RtLoaderPyObject *pyModule = NULL;
+        RtLoaderPyObject *pyClass = NULL;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!getClass(modules[i], pyModule, pyClass)) {
+            importTimes[i] = -1;
+            continue;
+        }
+        importTimes[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                             .count();
+
+        // the classes are kept by the cache of getClass
+        decref(pyClass);
+        decref(pyModule);
+        loaded++;
+    }
+    return loaded;
+}
+
 void RtLoader::free(void *ptr)
 {
     if (ptr != NULL) {
@@ -6,6 +6,7 @@
 package testaggregator
 
 import (
+	"encoding/binary"
 	"fmt"
 	"io/ioutil"
 	"log"
@@ -22,10 +23,10 @@ import (
 #include "rtloader_mem.h"
 #include "datadog_agent_rtloader.h"
 
-extern void submitMetric(char *, metric_type_t, char *, double, char **, char *, bool);
+extern void submitMetric(sender_handle_t, char *, metric_type_t, char *, double, char *, int, char *, bool);
 extern void submitServiceCheck(char *, char *, int, char **, char *, char *);
 extern void submitEvent(char*, event_t*);
-extern void submitHistogramBucket(char *, char *, long long, float, float, int, char *, char **, bool);
+extern void submitHistogramBucket(char *, char *, long long, float, float, int, char *, char *, int, bool);
 extern void submitEventPlatformEvent(char *, char *, char *);
 
 static void initAggregatorTests(rtloader_t *rtloader) {
@@ -40,6 +41,7 @@ import "C"
 
 var (
 	rtloader        *C.rtloader_t
+	senderHandle    uintptr
 	checkID         string
 	metricType      int
 	name            string
@@ -73,6 +75,7 @@ type event struct {
 }
 
 func resetOuputValues() {
+	senderHandle = 0
 	checkID = ""
 	metricType = -1
 	name = ""
@@ -160,15 +163,26 @@ func charArrayToSlice(array **C.char) (res []string) {
 	}
 }
 
+func packedTagsToSlice(packed *C.char, size C.int) (res []string) {
+	buf := C.GoBytes(unsafe.Pointer(packed), size)
+	for len(buf) >= 4 {
+		tagLen := binary.LittleEndian.Uint32(buf)
+		res = append(res, string(buf[4:4+tagLen]))
+		buf = buf[4+tagLen:]
+	}
+	return
+}
+
 //export submitMetric
-func submitMetric(id *C.char, mt C.metric_type_t, mname *C.char, val C.double, t **C.char, hname *C.char, fFirstValue C.bool) {
+func submitMetric(handle C.sender_handle_t, id *C.char, mt C.metric_type_t, mname *C.char, val C.double, t *C.char, tSize C.int, hname *C.char, fFirstValue C.bool) {
+	senderHandle = uintptr(handle)
 	checkID = C.GoString(id)
 	metricType = int(mt)
 	name = C.GoString(mname)
 	value = float64(val)
 	hostname = C.GoString(hname)
 	if t != nil {
-		tags = append(tags, charArrayToSlice(t)...)
+		tags = append(tags, packedTagsToSlice(t, tSize)...)
 	}
 	flushFirstValue = bool(fFirstValue)
 }
@@ -222,7 +236,7 @@ func submitEvent(id *C.char, ev *C.event_t) {
 }
 
 //export submitHistogramBucket
-func submitHistogramBucket(id *C.char, cMetricName *C.char, cVal C.longlong, cLowerBound C.float, cUpperBound C.float, cMonotonic C.int, cHostname *C.char, t **C.char, fFirstValue C.bool) {
+func submitHistogramBucket(id *C.char, cMetricName *C.char, cVal C.longlong, cLowerBound C.float, cUpperBound C.float, cMonotonic C.int, cHostname *C.char, t *C.char, tSize C.int, fFirstValue C.bool) {
 	checkID = C.GoString(id)
 	name = C.GoString(cMetricName)
 	intValue = int(cVal)
@@ -231,7 +245,7 @@ func submitHistogramBucket(id *C.char, cMetricName *C.char, cVal C.longlong, cLo
 	monotonic = (cMonotonic != 0)
 	hostname = C.GoString(cHostname)
 	if t != nil {
-		tags = append(tags, charArrayToSlice(t)...)
+		tags = append(tags, packedTagsToSlice(t, tSize)...)
 	}
 	flushFirstValue = bool(fFirstValue)
 }
@@ -36,6 +36,9 @@ func TestSubmitMetric(t *testing.T) {
 	if out != "" {
 		t.Errorf("Unexpected printed value: '%s'", out)
 	}
+	if senderHandle != 0 {
+		t.Fatalf("Unexpected sender handle: %d", senderHandle)
+	}
 	if checkID != "id" {
 		t.Fatalf("Unexpected id value: %s", checkID)
 	}
@@ -94,6 +94,36 @@ func runString(code string) (string, error) {
 	return string(output), err
 }
 
+// runStringsWithThreadState runs each code snippet under its own GIL lock,
+// from a single thread holding a thread state
+func runStringsWithThreadState(codes ...string) (string, error) {
+	tmpfile.Truncate(0)
+
+	runtime.LockOSThread()
+	threadState := C.acquire_thread_state(rtloader)
+
+	ret := true
+	for _, code := range codes {
+		codeStr := (*C.char)(helpers.TrackedCString(code))
+
+		state := C.ensure_gil(rtloader)
+		ret = ret && C.run_simple_string(rtloader, codeStr) == 1
+		C.release_gil(rtloader, state)
+
+		C._free(unsafe.Pointer(codeStr))
+	}
+
+	C.release_thread_state(rtloader, threadState)
+	runtime.UnlockOSThread()
+
+	if !ret {
+		return "", fmt.Errorf("`run_simple_string` errored")
+	}
+
+	output, err := ioutil.ReadFile(tmpfile.Name())
+	return string(output), err
+}
+
 func fetchError() error {
 	if C.has_error(rtloader) == 1 {
 		return fmt.Errorf(C.GoString(C.get_error(rtloader)))
@@ -135,6 +165,60 @@ func hasError() bool {
 	return ret
 }
 
+// preloadChecks returns the number of modules preloaded, their import times and
+// the error of the last failure
+func preloadChecks(modules ...string) (int, []int64, error) {
+	cModules := make([]*C.char, len(modules)+1)
+	for i, module := range modules {
+		cModules[i] = (*C.char)(helpers.TrackedCString(module))
+		defer C._free(unsafe.Pointer(cModules[i]))
+	}
+	cImportTimes := make([]C.longlong, len(modules))
+
+	runtime.LockOSThread()
+	state := C.ensure_gil(rtloader)
+
+	loaded := C.preload_checks(rtloader, &cModules[0], &cImportTimes[0])
+
+	C.release_gil(rtloader, state)
+	runtime.UnlockOSThread()
+
+	importTimes := make([]int64, len(modules))
+	for i := range cImportTimes {
+		importTimes[i] = int64(cImportTimes[i])
+	}
+	return int(loaded), importTimes, fetchError()
+}
+
+// getCheckVersion returns the version of the check module resolved by get_class
+func getCheckVersion(name string) (string, error) {
+	var module *C.rtloader_pyobject_t
+	var class *C.rtloader_pyobject_t
+	var version *C.char
+
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+	state := C.ensure_gil(rtloader)
+	defer C.release_gil(rtloader, state)
+
+	classStr := (*C.char)(helpers.TrackedCString(name))
+	defer C._free(unsafe.Pointer(classStr))
+
+	if C.get_class(rtloader, classStr, &module, &class) != 1 || module == nil || class == nil {
+		return "", fmt.Errorf(C.GoString(C.get_error(rtloader)))
+	}
+
+	verStr := (*C.char)(helpers.TrackedCString("__version__"))
+	defer C._free(unsafe.Pointer(verStr))
+
+	if C.get_attr_string(rtloader, module, verStr, &version) != 1 || version == nil {
+		return "", fmt.Errorf(C.GoString(C.get_error(rtloader)))
+	}
+	defer C._free(unsafe.Pointer(version))
+
+	return C.GoString(version), nil
+}
+
 func getFakeCheck() (string, error) {
 	var module *C.rtloader_pyobject_t
 	var class *C.rtloader_pyobject_t
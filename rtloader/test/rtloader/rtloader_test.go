@@ -7,10 +7,13 @@ package testrtloader
 
 import (
 	"fmt"
+	"io/ioutil"
 	"os"
+	"path/filepath"
 	"reflect"
 	"strings"
 	"testing"
+	"time"
 
 	common "github.com/DataDog/datadog-agent/rtloader/test/common"
 	"github.com/DataDog/datadog-agent/rtloader/test/helpers"
@@ -74,6 +77,35 @@ with open(r'%s', 'w') as f:
 	helpers.AssertMemoryUsage(t)
 }
 
+func TestThreadState(t *testing.T) {
+	// Reset memory counters
+	helpers.ResetMemoryStats()
+
+	// thread-local data lives in the thread state, so it is only kept across
+	// the GIL locks if the thread state is
+	code := fmt.Sprintf(`
+import sys
+with open(r'%s', 'w') as f:
+	f.write(getattr(sys.rtloader_test_local, 'value', 'lost'))`, tmpfile.Name())
+
+	output, err := runStringsWithThreadState(`
+import sys
+import threading
+sys.rtloader_test_local = threading.local()
+sys.rtloader_test_local.value = 'kept'`, code)
+
+	if err != nil {
+		t.Fatalf("`run_simple_string` error: %v", err)
+	}
+
+	if output != "kept" {
+		t.Errorf("Unexpected printed value: '%s'", output)
+	}
+
+	// Check for leaks
+	helpers.AssertMemoryUsage(t)
+}
+
 func TestSysExecutableValue(t *testing.T) {
 	// Reset memory counters
 	helpers.ResetMemoryStats()
@@ -143,6 +175,82 @@ func TestGetCheck(t *testing.T) {
 	helpers.AssertMemoryUsage(t)
 }
 
+func TestPreloadChecks(t *testing.T) {
+	// Reset memory counters
+	helpers.ResetMemoryStats()
+
+	loaded, importTimes, err := preloadChecks("fake_check", "not_a_check_module")
+
+	if loaded != 1 {
+		t.Fatalf("expected 1 module to be preloaded, got %d", loaded)
+	}
+	if importTimes[0] < 0 {
+		t.Errorf("expected an import time for 'fake_check', got %d", importTimes[0])
+	}
+	if importTimes[1] != -1 {
+		t.Errorf("expected no import time for 'not_a_check_module', got %d", importTimes[1])
+	}
+	if err == nil || !strings.Contains(err.Error(), "not_a_check_module") {
+		t.Errorf("expected an error for 'not_a_check_module', got: %v", err)
+	}
+
+	// the check is now loaded from the cache of the preloaded classes
+	version, err := getFakeCheck()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if version != "0.4.2" {
+		t.Fatalf("expected version '0.4.2', found '%s'", version)
+	}
+
+	// Check for leaks
+	helpers.AssertMemoryUsage(t)
+}
+
+func TestGetClassUpdatedModule(t *testing.T) {
+	dir := filepath.Join("..", "python", "updated_check")
+	if err := os.MkdirAll(dir, 0755); err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	file := filepath.Join(dir, "__init__.py")
+	writeCheck := func(version string, mtime time.Time) {
+		source := "from datadog_checks.base.checks import AgentCheck\n\n" +
+			"class UpdatedCheck(AgentCheck):\n    pass\n\n" +
+			"__version__ = '" + version + "'\n"
+		if err := ioutil.WriteFile(file, []byte(source), 0644); err != nil {
+			t.Fatal(err)
+		}
+		if err := os.Chtimes(file, mtime, mtime); err != nil {
+			t.Fatal(err)
+		}
+	}
+
+	// Reset memory counters
+	helpers.ResetMemoryStats()
+
+	now := time.Now()
+	writeCheck("1.0.0", now.Add(-time.Minute))
+	if version, err := getCheckVersion("updated_check"); err != nil || version != "1.0.0" {
+		t.Fatalf("expected version '1.0.0', found '%s': %v", version, err)
+	}
+
+	// the class is cached as long as the module file doesn't change
+	if version, err := getCheckVersion("updated_check"); err != nil || version != "1.0.0" {
+		t.Fatalf("expected version '1.0.0', found '%s': %v", version, err)
+	}
+
+	// a new version of the module is imported again
+	writeCheck("2.0.0", now)
+	if version, err := getCheckVersion("updated_check"); err != nil || version != "2.0.0" {
+		t.Fatalf("expected version '2.0.0', found '%s': %v", version, err)
+	}
+
+	// Check for leaks
+	helpers.AssertMemoryUsage(t)
+}
+
 func TestRunCheck(t *testing.T) {
 	// Reset memory counters
 	helpers.ResetMemoryStats()
@@ -13,6 +13,7 @@
 #    error "DATADOG_AGENT_TWO and DATADOG_AGENT_THREE are mutually exclusive - define only one of the two."
 #endif
 
+#include <ctime>
 #include <map>
 #include <mutex>
 #include <string>
@@ -60,6 +61,8 @@ public:
     bool addPythonPath(const char *path);
     rtloader_gilstate_t GILEnsure();
     void GILRelease(rtloader_gilstate_t);
+    rtloader_threadstate_t *acquireThreadState();
+    void releaseThreadState(rtloader_threadstate_t *state);
 
     bool getClass(const char *module, RtLoaderPyObject *&pyModule, RtLoaderPyObject *&pyClass);
     bool getAttrString(RtLoaderPyObject *obj, const char *attributeName, char *&value) const;
@@ -89,6 +92,7 @@ public:
 
     // aggregator API
     void setSubmitMetricCb(cb_submit_metric_t);
+    void setSenderHandleCbs(cb_get_sender_handle_t, cb_release_sender_handle_t);
     void setSubmitServiceCheckCb(cb_submit_service_check_t);
     void setSubmitEventCb(cb_submit_event_t);
     void setSubmitHistogramBucketCb(cb_submit_histogram_bucket_t);
@@ -184,6 +188,42 @@ private:
     wchar_t *_pythonExe; /*!< unicode string with the path to the executable of the underlying interpreter */
     PyObject *_baseClass; /*!< PyObject * pointer to the base Agent check class */
     PyPaths _pythonPaths; /*!< string vector containing paths in the PYTHONPATH */
+
+    /*! CheckClass struct
+      \brief The module and check class resolved by getClass, with the file of the module and its
+      modification time when it was imported.
+    */
+    typedef struct {
+        PyObject *module; /*!< PyObject * pointer to the check module */
+        PyObject *klass; /*!< PyObject * pointer to the check class */
+        std::string file; /*!< path of the module file, empty if the module has none */
+        time_t mtime; /*!< modification time of the module file */
+    } CheckClass;
+
+    /*! CheckClasses type prototype
+      \typedef CheckClasses maps the name of a check module to its CheckClass.
+    */
+    typedef std::map<std::string, CheckClass> CheckClasses;
+
+    //! _isCheckClassStale member.
+    /*!
+      \brief This member function checks whether the file of a cached check module was updated,
+      or removed, since the module was imported. This happens when a new version of the wheel of
+      a check is installed.
+      \param checkClass The cached CheckClass.
+      \return A boolean indicating whether the module has to be imported again.
+    */
+    bool _isCheckClassStale(const CheckClass &checkClass) const;
+
+    //! _uncacheCheckClass member.
+    /*!
+      \brief This member function removes a check class from the cache, and its module and
+      submodules from `sys.modules`, so that the next getClass imports them again.
+      \param module The name of the check module.
+    */
+    void _uncacheCheckClass(const std::string &module);
+
+    CheckClasses _checkClasses; /*!< check classes resolved by getClass, holding a reference to the modules and classes */
     PyThreadState *_threadState; /*!< PyThreadState * pointer to the saved Python interpreter thread state */
 };
 
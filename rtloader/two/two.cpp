@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <sstream>
+#include <sys/stat.h>
 
 extern "C" DATADOG_AGENT_RTLOADER_API RtLoader *create(const char *python_home, const char *python_exe,
                                                        cb_memory_tracker_t memtrack_cb)
@@ -54,6 +55,10 @@ Two::~Two()
     // For more information on why Py_Finalize() isn't called here please
     // refer to the header file or the doxygen documentation.
     PyEval_RestoreThread(_threadState);
+    for (CheckClasses::iterator it = _checkClasses.begin(); it != _checkClasses.end(); ++it) {
+        Py_XDECREF(it->second.klass);
+        Py_XDECREF(it->second.module);
+    }
     Py_XDECREF(_baseClass);
 }
 
@@ -238,11 +243,39 @@ void Two::GILRelease(rtloader_gilstate_t state)
     }
 }
 
+rtloader_threadstate_t *Two::acquireThreadState()
+{
+    // PyGILState_Release only destroys the thread state when its counter drops to zero, so the
+    // reference taken here keeps it alive across the GILEnsure/GILRelease calls of this thread.
+    PyGILState_Ensure();
+    return reinterpret_cast<rtloader_threadstate_t *>(PyEval_SaveThread());
+}
+
+void Two::releaseThreadState(rtloader_threadstate_t *state)
+{
+    PyEval_RestoreThread(reinterpret_cast<PyThreadState *>(state));
+    PyGILState_Release(PyGILState_UNLOCKED);
+}
+
 bool Two::getClass(const char *module, RtLoaderPyObject *&pyModule, RtLoaderPyObject *&pyClass)
 {
     PyObject *obj_module = NULL;
     PyObject *obj_class = NULL;
 
+    CheckClasses::const_iterator cached = _checkClasses.find(module);
+    if (cached != _checkClasses.end()) {
+        if (!_isCheckClassStale(cached->second)) {
+            obj_module = cached->second.module;
+            obj_class = cached->second.klass;
+            Py_INCREF(obj_module);
+            Py_INCREF(obj_class);
+            pyModule = reinterpret_cast<RtLoaderPyObject *>(obj_module);
+            pyClass = reinterpret_cast<RtLoaderPyObject *>(obj_class);
+            return true;
+        }
+        _uncacheCheckClass(module);
+    }
+
     obj_module = PyImport_ImportModule(module);
     if (obj_module == NULL) {
         std::ostringstream err;
@@ -261,11 +294,76 @@ bool Two::getClass(const char *module, RtLoaderPyObject *&pyModule, RtLoaderPyOb
         return false;
     }
 
+    CheckClass checkClass = { obj_module, obj_class, std::string(), 0 };
+    PyObject *py_file = PyObject_GetAttrString(obj_module, "__file__");
+    char *file = as_string(py_file);
+    Py_XDECREF(py_file);
+    if (file != NULL) {
+        struct stat st;
+        if (stat(file, &st) == 0) {
+            checkClass.file = file;
+            checkClass.mtime = st.st_mtime;
+        }
+        _free(file);
+    }
+    // a module without file (e.g. a namespace package) is never considered stale
+    PyErr_Clear();
+
+    // the import may have released the GIL, another thread could have cached the module meanwhile
+    if (_checkClasses.insert(std::make_pair(std::string(module), checkClass)).second) {
+        Py_INCREF(obj_module);
+        Py_INCREF(obj_class);
+    }
+
     pyModule = reinterpret_cast<RtLoaderPyObject *>(obj_module);
     pyClass = reinterpret_cast<RtLoaderPyObject *>(obj_class);
     return true;
 }
 
+bool Two::_isCheckClassStale(const CheckClass &checkClass) const
+{
+    if (checkClass.file.empty()) {
+        return false;
+    }
+
+    struct stat st;
+    return stat(checkClass.file.c_str(), &st) != 0 || st.st_mtime != checkClass.mtime;
+}
+
+void Two::_uncacheCheckClass(const std::string &module)
+{
+    CheckClasses::iterator cached = _checkClasses.find(module);
+    if (cached != _checkClasses.end()) {
+        Py_XDECREF(cached->second.klass);
+        Py_XDECREF(cached->second.module);
+        _checkClasses.erase(cached);
+    }
+
+    // collect the names first, sys.modules can't be changed while iterating over it
+    PyObject *modules = PyImport_GetModuleDict(); // borrowed
+    std::vector<std::string> names;
+    PyObject *key = NULL;
+    PyObject *value = NULL;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(modules, &pos, &key, &value)) {
+        char *name = as_string(key);
+        if (name == NULL) {
+            continue;
+        }
+        std::string moduleName(name);
+        _free(name);
+        if (moduleName == module || moduleName.compare(0, module.size() + 1, module + ".") == 0) {
+            names.push_back(moduleName);
+        }
+    }
+
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+        if (PyDict_DelItemString(modules, it->c_str()) != 0) {
+            PyErr_Clear();
+        }
+    }
+}
+
 bool Two::getCheck(RtLoaderPyObject *py_class, const char *init_config_str, const char *instance_str,
                    const char *check_id_str, const char *check_name, const char *agent_config_str,
                    RtLoaderPyObject *&check)
@@ -398,6 +496,13 @@ bool Two::getCheck(RtLoaderPyObject *py_class, const char *init_config_str, cons
             py_check = NULL;
             goto done;
         }
+
+        if (!_bind_sender_handle(py_check, check_id_str)) {
+            setError("error could not bind the sender handle: " + _fetchPythonError());
+            Py_XDECREF(py_check);
+            py_check = NULL;
+            goto done;
+        }
     }
 
 done:
@@ -831,6 +936,11 @@ void Two::setSubmitMetricCb(cb_submit_metric_t cb)
     _set_submit_metric_cb(cb);
 }
 
+void Two::setSenderHandleCbs(cb_get_sender_handle_t get_cb, cb_release_sender_handle_t release_cb)
+{
+    _set_sender_handle_cbs(get_cb, release_cb);
+}
+
 void Two::setSubmitServiceCheckCb(cb_submit_service_check_t cb)
 {
     _set_submit_service_check_cb(cb);